@@ -0,0 +1,248 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <ranges>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#include "adif.hpp"
+#include "callsign.hpp"
+
+namespace
+{
+    // Index of the next '<' at or after pos, 16 bytes per step
+    std::size_t
+    find_tag_open(std::string_view s, std::size_t pos) noexcept
+    {
+#if defined(__SSE2__)
+        const auto lt = _mm_set1_epi8('<');
+        for (; pos + 16 <= s.size(); pos += 16) {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.data() + pos));
+            if (auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, lt)))) {
+                return pos + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const auto lt = vdupq_n_u8('<');
+        for (; pos + 16 <= s.size(); pos += 16) {
+            auto v = vld1q_u8(reinterpret_cast<const std::uint8_t*>(s.data() + pos));
+            if (vmaxvq_u8(vceqq_u8(v, lt))) break;
+        }
+#endif
+        return s.find('<', pos);
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    bool
+    adif_name_equals(std::string_view a, std::string_view b) noexcept
+    {
+        return std::ranges::equal(a, b, [](char x, char y) {
+            return std::toupper(static_cast<unsigned char>(x)) == std::toupper(static_cast<unsigned char>(y));
+        });
+    }
+
+    AdifReader::AdifReader(RecordCallback callback) :
+        on_record(std::move(callback))
+    {
+    }
+
+    void
+    AdifReader::feed(std::string_view chunk)
+    {
+        /* Finish a straddling record by appending just enough of the chunk
+         * to the carry; once the carry's leftover lies wholly within what
+         * was appended, go back to parsing the chunk in place. */
+        while (!carry.empty() && !chunk.empty()) {
+            auto take = std::min(chunk.size(), std::max(carry.size(), 4096UZ));
+            carry.append(chunk.substr(0, take));
+            chunk.remove_prefix(take);
+            auto left = carry.size() - parse(carry);
+            if (left <= take) {
+                chunk = std::string_view(chunk.data() - left, chunk.size() + left);
+                carry.clear();
+            } else if (left > max_record_size) {
+                dropped += left;
+                carry.clear();
+            } else {
+                carry.erase(0, carry.size() - left);
+            }
+        }
+        if (carry.empty() && !chunk.empty()) {
+            carry.assign(chunk.substr(parse(chunk)));
+        }
+    }
+
+    void
+    AdifReader::finish()
+    {
+        // Text after the last <EOR>, like its newline, is not a record
+        if (std::string_view::npos != find_tag_open(carry, 0)) {
+            dropped += carry.size();
+        }
+        carry.clear();
+    }
+
+    std::size_t
+    AdifReader::parse(std::string_view buf)
+    {
+        std::size_t pos = 0;
+        std::size_t record_start = 0;
+        fields.clear();
+        while (true) {
+            auto open = find_tag_open(buf, pos);
+            if (std::string_view::npos == open) break;
+            auto close = buf.find('>', open + 1);
+            if (std::string_view::npos == close) break;
+
+            // <NAME:LENGTH[:TYPE]> or a bare <EOR>/<EOH>
+            auto tag = buf.substr(open + 1, close - open - 1);
+            auto colon = tag.find(':');
+            auto name = tag.substr(0, colon);
+            if (std::string_view::npos == colon) {
+                pos = close + 1;
+                if (adif_name_equals(name, "EOR")) {
+                    on_record(fields);
+                    ++record_count;
+                    record_start = pos;
+                    fields.clear();
+                } else if (adif_name_equals(name, "EOH")) {
+                    record_start = pos;
+                    fields.clear();
+                }
+                continue;
+            }
+            auto spec = tag.substr(colon + 1);
+            std::size_t length = 0;
+            auto [end, ec] = std::from_chars(spec.data(), spec.data() + spec.size(), length);
+            if (std::errc{} != ec) {
+                // Not a field specifier; treat the '<' as text
+                pos = open + 1;
+                continue;
+            }
+            auto value_begin = close + 1;
+            if (length > buf.size() - value_begin) break;
+            fields.push_back({ name, buf.substr(value_begin, length) });
+            pos = value_begin + length;
+        }
+        fields.clear();
+        return record_start;
+    }
+
+    std::optional<std::pair<double, double>>
+    maidenhead_center(std::string_view grid) noexcept
+    {
+        if (grid.size() != 4 && grid.size() < 6) return std::nullopt;
+        auto up = [](char c) { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); };
+        auto field_lon = up(grid[0]), field_lat = up(grid[1]);
+        if (field_lon < 'A' || field_lon > 'R' || field_lat < 'A' || field_lat > 'R' ||
+            !std::isdigit(static_cast<unsigned char>(grid[2])) || !std::isdigit(static_cast<unsigned char>(grid[3]))) {
+            return std::nullopt;
+        }
+        double lon = (field_lon - 'A') * 20.0 - 180.0 + (grid[2] - '0') * 2.0;
+        double lat = (field_lat - 'A') * 10.0 - 90.0 + (grid[3] - '0') * 1.0;
+        if (grid.size() >= 6) {
+            auto sub_lon = up(grid[4]), sub_lat = up(grid[5]);
+            if (sub_lon < 'A' || sub_lon > 'X' || sub_lat < 'A' || sub_lat > 'X') return std::nullopt;
+            lon += (sub_lon - 'A') * (5.0 / 60.0) + 2.5 / 60.0;
+            lat += (sub_lat - 'A') * (2.5 / 60.0) + 1.25 / 60.0;
+        } else {
+            lon += 1.0;
+            lat += 0.5;
+        }
+        return std::pair(lat, lon);
+    }
+
+    void
+    AdifAggregator::add(std::span<const AdifField> record)
+    {
+        ++records;
+        std::string_view call, name, date, grid;
+        for (const auto& f : record) {
+            if (adif_name_equals(f.name, "CALL")) call = f.value;
+            else if (adif_name_equals(f.name, "NAME")) name = f.value;
+            else if (adif_name_equals(f.name, "QSO_DATE")) date = f.value;
+            else if (adif_name_equals(f.name, "GRIDSQUARE")) grid = f.value;
+        }
+        std::string callsign(call);
+        std::ranges::transform(callsign, callsign.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+        if (!is_valid_callsign(callsign)) {
+            ++skipped;
+            return;
+        }
+
+        auto [it, inserted] = index.try_emplace(callsign, static_cast<std::uint32_t>(stations.size()));
+        if (inserted) {
+            stations.push_back({ .callsign = std::move(callsign) });
+        }
+        auto& station = stations[it->second];
+        ++station.qsos;
+        bool newest = date >= station.last_date;
+        if (newest) {
+            station.last_date = date;
+        }
+        if (!name.empty() && (newest || station.name.empty())) {
+            station.name = name;
+        }
+        if (auto location = maidenhead_center(grid); location && (newest || !station.location)) {
+            station.location = location;
+        }
+    }
+
+    AdifSummary
+    AdifAggregator::finish() &&
+    {
+        AdifSummary summary{ .records = records, .skipped = skipped };
+        summary.stations = std::move(stations);
+        std::ranges::sort(summary.stations, {}, &AdifStation::callsign);
+        return summary;
+    }
+
+    void
+    merge_adif(nlohmann::json& net, const AdifSummary& summary)
+    {
+        auto& roster = net["stations"];
+        if (!roster.is_array()) roster = nlohmann::json::array();
+        std::unordered_map<std::string, std::size_t> existing;
+        for (auto i = 0UZ; i < roster.size(); ++i) {
+            if (auto it = roster[i].find("callsign"); roster[i].end() != it && it->is_string()) {
+                existing.emplace(it->get<std::string>(), i);
+            }
+        }
+        for (const auto& s : summary.stations) {
+            if (existing.contains(s.callsign)) continue;
+            nlohmann::json j = { { "callsign", s.callsign }, { "name", s.name } };
+            if (s.location) {
+                j["lat"] = s.location->first;
+                j["long"] = s.location->second;
+            }
+            roster.push_back(std::move(j));
+        }
+    }
+
+} // namespace mnn
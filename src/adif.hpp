@@ -0,0 +1,117 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace mnn
+{
+    // Views into the buffer being parsed, valid only during the callback
+    struct AdifField
+    {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    /* Streaming ADIF (.adi) reader. Feed it the file in chunks of any size;
+     * each <EOR> terminated record is handed to the callback as fields that
+     * point into the chunk. Only a record that straddles two chunks is
+     * copied, so memory stays bounded by the chunk size. */
+    class AdifReader
+    {
+    public:
+        using RecordCallback = std::function<void(std::span<const AdifField>)>;
+
+        // A record longer than this without an <EOR> is dropped
+        static constexpr std::size_t max_record_size = 1 << 20;
+
+        explicit AdifReader(RecordCallback);
+
+        void feed(std::string_view chunk);
+        // Discards a trailing partial record, counting it as dropped if it has any tag
+        void finish();
+
+        [[nodiscard]] std::size_t records() const { return record_count; }
+        [[nodiscard]] std::size_t dropped_bytes() const { return dropped; }
+
+    private:
+        // Returns the number of bytes consumed: everything up to the last complete record
+        std::size_t parse(std::string_view buf);
+
+        RecordCallback on_record;
+        std::string carry;
+        std::vector<AdifField> fields;
+        std::size_t record_count = 0;
+        std::size_t dropped = 0;
+    };
+
+    // ADIF field names are case insensitive
+    [[nodiscard]] bool adif_name_equals(std::string_view a, std::string_view b) noexcept;
+
+    // Center of a 4 or 6 character Maidenhead locator as { latitude, longitude }
+    [[nodiscard]] std::optional<std::pair<double, double>> maidenhead_center(std::string_view grid) noexcept;
+
+    struct AdifStation
+    {
+        std::string callsign;
+        std::string name;
+        std::optional<std::pair<double, double>> location;
+        // YYYYMMDD of the newest QSO; name and location come from it
+        std::string last_date;
+        std::size_t qsos = 0;
+    };
+
+    struct AdifSummary
+    {
+        // Sorted by callsign
+        std::vector<AdifStation> stations;
+        std::size_t records = 0;
+        // Records without a valid CALL
+        std::size_t skipped = 0;
+    };
+
+    /* Folds QSO records into unique stations. Memory grows with the number
+     * of distinct callsigns, not QSOs. */
+    class AdifAggregator
+    {
+    public:
+        void add(std::span<const AdifField> record);
+        [[nodiscard]] AdifSummary finish() &&;
+
+    private:
+        std::vector<AdifStation> stations;
+        std::unordered_map<std::string, std::uint32_t> index;
+        std::size_t records = 0;
+        std::size_t skipped = 0;
+    };
+
+    // Adds the log's stations to a net definition, leaving existing members alone
+    void merge_adif(nlohmann::json& net, const AdifSummary&);
+
+} // namespace mnn
@@ -0,0 +1,269 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <charconv>
+#include <tuple>
+#include <utility>
+#include "aprs.hpp"
+
+namespace
+{
+    using mnn::AprsPosition;
+
+    bool
+    digits(std::string_view s, int& out) noexcept
+    {
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+        return std::errc{} == ec && ptr == s.data() + s.size();
+    }
+
+    // "DDMM.mm" or "DDDMM.mm"; ambiguity spaces count as zero
+    std::optional<double>
+    degrees_minutes(std::string_view s, std::size_t degree_digits) noexcept
+    {
+        if (s.size() != degree_digits + 5 || '.' != s[degree_digits + 2]) {
+            return std::nullopt;
+        }
+        char buf[8];
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            buf[i] = ' ' == s[i] ? '0' : s[i];
+        }
+        std::string_view b(buf, s.size());
+        int deg, min, hundredths;
+        if (!digits(b.substr(0, degree_digits), deg) || !digits(b.substr(degree_digits, 2), min) ||
+            !digits(b.substr(degree_digits + 3, 2), hundredths) || min >= 60) {
+            return std::nullopt;
+        }
+        return deg + (min + hundredths / 100.0) / 60.0;
+    }
+
+    std::optional<AprsPosition>
+    uncompressed(std::string_view s) noexcept
+    {
+        // DDMM.mmN/DDDMM.mmW$
+        if (s.size() < 19) return std::nullopt;
+        auto lat = degrees_minutes(s.substr(0, 7), 2);
+        auto lon = degrees_minutes(s.substr(9, 8), 3);
+        if (!lat || !lon || *lat > 90.0 || *lon > 180.0) return std::nullopt;
+        switch (s[7]) {
+            case 'N': break;
+            case 'S': *lat = -*lat; break;
+            default: return std::nullopt;
+        }
+        switch (s[17]) {
+            case 'E': break;
+            case 'W': *lon = -*lon; break;
+            default: return std::nullopt;
+        }
+        return AprsPosition{ *lat, *lon };
+    }
+
+    std::optional<std::uint32_t>
+    base91(std::string_view s) noexcept
+    {
+        std::uint32_t v = 0;
+        for (auto c : s) {
+            if (c < '!' || c > '{') return std::nullopt;
+            v = v * 91 + static_cast<std::uint32_t>(c - '!');
+        }
+        return v;
+    }
+
+    std::optional<AprsPosition>
+    compressed(std::string_view s) noexcept
+    {
+        // /YYYYXXXX$csT
+        if (s.size() < 13) return std::nullopt;
+        auto y = base91(s.substr(1, 4));
+        auto x = base91(s.substr(5, 4));
+        if (!y || !x) return std::nullopt;
+        AprsPosition p{ 90.0 - *y / 380926.0, -180.0 + *x / 190463.0 };
+        if (p.latitude < -90.0 || p.latitude > 90.0 || p.longitude < -180.0 || p.longitude > 180.0) {
+            return std::nullopt;
+        }
+        return p;
+    }
+
+    // Mic-E destination characters: digit value, and whether it is a "custom" (P-Z) character
+    std::optional<std::pair<int, bool>>
+    mic_e_digit(char c) noexcept
+    {
+        if (c >= '0' && c <= '9') return std::pair{ c - '0', false };
+        if (c >= 'A' && c <= 'J') return std::pair{ c - 'A', false };
+        if ('K' == c || 'L' == c) return std::pair{ 0, false };
+        if (c >= 'P' && c <= 'Y') return std::pair{ c - 'P', true };
+        if ('Z' == c) return std::pair{ 0, true };
+        return std::nullopt;
+    }
+
+    std::optional<AprsPosition>
+    mic_e(std::string_view destination, std::string_view info) noexcept
+    {
+        destination = mnn::strip_ssid(destination);
+        if (destination.size() != 6 || info.size() < 9) return std::nullopt;
+        int d[6];
+        bool custom[6];
+        for (auto i = 0; i < 6; ++i) {
+            auto v = mic_e_digit(destination[i]);
+            if (!v) return std::nullopt;
+            std::tie(d[i], custom[i]) = *v;
+        }
+        auto lat = d[0] * 10 + d[1] + (d[2] * 10 + d[3] + (d[4] * 10 + d[5]) / 100.0) / 60.0;
+        if (!custom[3]) lat = -lat;
+
+        auto deg = static_cast<unsigned char>(info[1]) - 28;
+        if (custom[4]) deg += 100;
+        if (deg >= 180 && deg <= 189) {
+            deg -= 80;
+        } else if (deg >= 190 && deg <= 199) {
+            deg -= 190;
+        }
+        auto min = static_cast<unsigned char>(info[2]) - 28;
+        if (min >= 60) min -= 60;
+        auto hundredths = static_cast<unsigned char>(info[3]) - 28;
+        if (deg < 0 || deg > 179 || min < 0 || min > 59 || hundredths < 0 || hundredths > 99) {
+            return std::nullopt;
+        }
+        double lon = deg + (min + hundredths / 100.0) / 60.0;
+        if (custom[5]) lon = -lon;
+        if (lat < -90.0 || lat > 90.0) return std::nullopt;
+        return AprsPosition{ lat, lon };
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    std::optional<AprsPacket>
+    parse_tnc2(std::string_view line) noexcept
+    {
+        while (!line.empty() && ('\r' == line.back() || '\n' == line.back())) {
+            line.remove_suffix(1);
+        }
+        // APRS-IS comments and server banners
+        if (line.empty() || '#' == line.front()) return std::nullopt;
+        auto gt = line.find('>');
+        auto colon = line.find(':');
+        if (std::string_view::npos == gt || std::string_view::npos == colon || gt == 0 || gt > colon) {
+            return std::nullopt;
+        }
+        AprsPacket p;
+        p.source = line.substr(0, gt);
+        auto header = line.substr(gt + 1, colon - gt - 1);
+        auto comma = header.find(',');
+        p.destination = header.substr(0, comma);
+        p.path = std::string_view::npos == comma ? std::string_view{} : header.substr(comma + 1);
+        p.info = line.substr(colon + 1);
+        if (p.destination.empty() || p.source.size() > 9) return std::nullopt;
+        return p;
+    }
+
+    std::optional<AprsPosition>
+    parse_position(const AprsPacket& p) noexcept
+    {
+        if (p.info.empty()) return std::nullopt;
+        auto body = p.info.substr(1);
+        switch (p.info.front()) {
+            case '/':
+            case '@':
+                // Seven character timestamp first
+                if (body.size() < 7) return std::nullopt;
+                body.remove_prefix(7);
+                [[fallthrough]];
+            case '!':
+            case '=':
+                if (body.empty()) return std::nullopt;
+                if (body.front() >= '0' && body.front() <= '9') {
+                    return uncompressed(body);
+                }
+                return compressed(body);
+            case '`':
+            case '\'':
+                return mic_e(p.destination, p.info);
+        }
+        return std::nullopt;
+    }
+
+    std::span<std::uint8_t>
+    KissDecoder::unescape(std::span<std::uint8_t> frame) noexcept
+    {
+        std::size_t out = 0;
+        for (std::size_t i = 0; i < frame.size(); ++i) {
+            auto b = frame[i];
+            if (FESC == b && i + 1 < frame.size()) {
+                b = TFEND == frame[++i] ? FEND : FESC;
+            }
+            frame[out++] = b;
+        }
+        return frame.first(out);
+    }
+
+    std::optional<std::string_view>
+    kiss_to_tnc2(std::span<const std::uint8_t> frame, std::span<char> out) noexcept
+    {
+        std::size_t len = 0;
+        auto put = [&](char c) {
+            if (len >= out.size()) return false;
+            out[len++] = c;
+            return true;
+        };
+        auto put_address = [&](std::span<const std::uint8_t> a) {
+            for (auto i = 0; i < 6; ++i) {
+                char c = static_cast<char>(a[i] >> 1);
+                if (' ' != c && !put(c)) return false;
+            }
+            auto ssid = (a[6] >> 1) & 0x0f;
+            if (ssid > 0) {
+                if (!put('-')) return false;
+                if (ssid >= 10 && !put('1')) return false;
+                if (!put(static_cast<char>('0' + ssid % 10))) return false;
+            }
+            return true;
+        };
+
+        // Destination, source, then up to 8 digipeaters; the last address has bit 0 set
+        std::size_t addresses = 0;
+        while (true) {
+            auto at = addresses * 7;
+            if (frame.size() < at + 7 || addresses >= 10) return std::nullopt;
+            ++addresses;
+            if (frame[at + 6] & 0x01) break;
+        }
+        if (addresses < 2) return std::nullopt;
+        auto rest = frame.subspan(addresses * 7);
+        // UI frame, no layer 3
+        if (rest.size() < 2 || 0x03 != rest[0] || 0xf0 != rest[1]) return std::nullopt;
+
+        if (!put_address(frame.subspan(7, 7)) || !put('>') || !put_address(frame.subspan(0, 7))) {
+            return std::nullopt;
+        }
+        for (std::size_t i = 2; i < addresses; ++i) {
+            auto digi = frame.subspan(i * 7, 7);
+            if (!put(',') || !put_address(digi)) return std::nullopt;
+            // H bit: already repeated
+            if ((digi[6] & 0x80) && !put('*')) return std::nullopt;
+        }
+        if (!put(':')) return std::nullopt;
+        for (auto b : rest.subspan(2)) {
+            if (!put(static_cast<char>(b))) return std::nullopt;
+        }
+        return std::string_view(out.data(), len);
+    }
+
+} // namespace mnn
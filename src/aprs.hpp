@@ -0,0 +1,99 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace mnn
+{
+    struct AprsPosition
+    {
+        double latitude;
+        double longitude;
+    };
+
+    /* A TNC2 monitor line, "SRC-9>DEST,PATH*:info". Every view points into
+     * the line that was parsed; nothing is allocated. */
+    struct AprsPacket
+    {
+        std::string_view source;
+        std::string_view destination;
+        std::string_view path;
+        std::string_view info;
+    };
+
+    [[nodiscard]] std::optional<AprsPacket> parse_tnc2(std::string_view line) noexcept;
+
+    /* The sender's own position from uncompressed ('!' '=' '/' '@'),
+     * compressed or Mic-E ('`' '\'') reports. Objects, items, third party
+     * traffic and anything else yield nullopt. */
+    [[nodiscard]] std::optional<AprsPosition> parse_position(const AprsPacket&) noexcept;
+
+    // "KI6KVZ-9" -> "KI6KVZ"
+    [[nodiscard]] constexpr std::string_view
+    strip_ssid(std::string_view callsign) noexcept
+    {
+        return callsign.substr(0, callsign.find('-'));
+    }
+
+    /* Turns one unescaped KISS data frame (AX.25 UI frame) into a TNC2 line
+     * in out. Returns the line, or nullopt when the frame isn't a UI frame
+     * or out is too small. */
+    [[nodiscard]] std::optional<std::string_view> kiss_to_tnc2(std::span<const std::uint8_t> frame, std::span<char> out) noexcept;
+
+    /* Splits a KISS byte stream into frames. Frames are unescaped in place
+     * in the caller's buffer, so the splitter holds no memory of its own. */
+    class KissDecoder
+    {
+    public:
+        static constexpr std::uint8_t FEND = 0xc0;
+        static constexpr std::uint8_t FESC = 0xdb;
+        static constexpr std::uint8_t TFEND = 0xdc;
+        static constexpr std::uint8_t TFESC = 0xdd;
+
+        /* Calls on_frame(span of AX.25 bytes) for each complete data frame
+         * in buf and returns how many bytes were consumed; the remainder is
+         * a partial frame to keep for the next read. */
+        template<typename F>
+        std::size_t
+        decode(std::span<std::uint8_t> buf, F&& on_frame) noexcept
+        {
+            std::size_t consumed = 0;
+            for (std::size_t i = 0; i < buf.size(); ++i) {
+                if (FEND != buf[i]) continue;
+                auto frame = unescape(buf.subspan(consumed, i - consumed));
+                // First byte is the port and command; only data frames (command 0) carry packets
+                if (frame.size() > 1 && 0 == (frame[0] & 0x0f)) {
+                    on_frame(std::span<const std::uint8_t>(frame.subspan(1)));
+                }
+                consumed = i + 1;
+            }
+            return consumed;
+        }
+
+    private:
+        static std::span<std::uint8_t> unescape(std::span<std::uint8_t>) noexcept;
+    };
+
+} // namespace mnn
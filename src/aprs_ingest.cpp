@@ -0,0 +1,214 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "aprs_ingest.hpp"
+#include "config.hpp"
+#include "net_library.hpp"
+
+namespace
+{
+    int
+    connect_tcp(std::string_view host_port)
+    {
+        auto colon = host_port.rfind(':');
+        if (std::string_view::npos == colon) return -1;
+        std::string host(host_port.substr(0, colon));
+        std::string port(host_port.substr(colon + 1));
+        addrinfo hints{};
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* res = nullptr;
+        if (0 != ::getaddrinfo(host.c_str(), port.c_str(), &hints, &res)) return -1;
+        int fd = -1;
+        for (auto ai = res; ai; ai = ai->ai_next) {
+            fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+            if (fd >= 0 && 0 == ::connect(fd, ai->ai_addr, ai->ai_addrlen)) break;
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
+        ::freeaddrinfo(res);
+        return fd;
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    using namespace peel;
+
+    AprsIngest::AprsIngest(Net& net, std::string source) :
+        net(net),
+        source(std::move(source))
+    {
+    }
+
+    AprsIngest::~AprsIngest()
+    {
+        stop();
+    }
+
+    void
+    AprsIngest::update_roster()
+    {
+        auto keys = std::make_shared<Roster>();
+        keys->reserve(net.by_callsign.size());
+        for (const auto& [callsign, station] : net.by_callsign) {
+            keys->insert(callsign);
+        }
+        roster.store(std::move(keys));
+    }
+
+    void
+    AprsIngest::on_items_changed(GListModel*, guint, guint, guint, gpointer self)
+    {
+        // Reloads are rare; a fresh set keeps the worker lock free
+        static_cast<AprsIngest*>(self)->update_roster();
+    }
+
+    void
+    AprsIngest::start()
+    {
+        stop();
+        update_roster();
+        items_changed_id = g_signal_connect(static_cast<Gio::ListStore*>(net.stations), "items-changed",
+                                            G_CALLBACK(&AprsIngest::on_items_changed), this);
+        stopping = false;
+        if (::pipe2(wake_fds, O_NONBLOCK | O_CLOEXEC) < 0) {
+            g_warning("Unable to start APRS ingest: %s", std::strerror(errno));
+            return;
+        }
+        worker = std::thread(&AprsIngest::run, this);
+    }
+
+    void
+    AprsIngest::stop()
+    {
+        stopping = true;
+        if (worker.joinable()) {
+            [[maybe_unused]] auto n = ::write(wake_fds[1], "x", 1);
+            worker.join();
+        }
+        for (auto& fd : wake_fds) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
+        if (0 != items_changed_id) {
+            g_signal_handler_disconnect(static_cast<Gio::ListStore*>(net.stations), items_changed_id);
+            items_changed_id = 0;
+        }
+    }
+
+    int
+    AprsIngest::open_source(bool& kiss)
+    {
+        std::string_view s = source;
+        kiss = s.starts_with("kiss:");
+        if (kiss) {
+            return connect_tcp(s.substr(5));
+        }
+        if (auto fd = ::open(source.c_str(), O_RDONLY | O_CLOEXEC); fd >= 0) {
+            return fd;
+        }
+        auto fd = connect_tcp(s);
+        if (fd >= 0) {
+            // Read only login; a server side filter is the user's business
+            auto login = std::format("user N0CALL pass -1 vers monday-night-net {}\r\n", PACKAGE_VERSION);
+            ::send(fd, login.data(), login.size(), MSG_NOSIGNAL);
+        }
+        return fd;
+    }
+
+    void
+    AprsIngest::run()
+    {
+        bool kiss = false;
+        auto fd = open_source(kiss);
+        if (fd < 0) {
+            g_warning("Unable to open APRS source %s: %s", source.c_str(), std::strerror(errno));
+            return;
+        }
+
+        KissDecoder decoder;
+        std::array<char, 1024> tnc2;
+        std::array<char, 64 * 1024> buf;
+        std::size_t filled = 0;
+        while (!stopping) {
+            std::array<pollfd, 2> p{ { { fd, POLLIN, 0 }, { wake_fds[0], POLLIN, 0 } } };
+            if (::poll(p.data(), p.size(), -1) <= 0 || 0 == p[0].revents) continue;
+            auto n = ::read(fd, buf.data() + filled, buf.size() - filled);
+            if (n <= 0) break;
+            filled += static_cast<std::size_t>(n);
+
+            std::size_t consumed = 0;
+            if (kiss) {
+                auto bytes = std::span(reinterpret_cast<std::uint8_t*>(buf.data()), filled);
+                consumed = decoder.decode(bytes, [this, &tnc2](std::span<const std::uint8_t> frame) {
+                    if (auto line = kiss_to_tnc2(frame, tnc2)) handle_line(*line);
+                });
+            } else {
+                std::string_view text(buf.data(), filled);
+                for (auto nl = text.find('\n'); std::string_view::npos != nl; nl = text.find('\n', consumed)) {
+                    handle_line(text.substr(consumed, nl - consumed));
+                    consumed = nl + 1;
+                }
+            }
+            if (0 == consumed && filled == buf.size()) {
+                // A line longer than any packet; drop it
+                consumed = filled;
+            }
+            std::memmove(buf.data(), buf.data() + consumed, filled - consumed);
+            filled -= consumed;
+        }
+        ::close(fd);
+    }
+
+    void
+    AprsIngest::handle_line(std::string_view line)
+    {
+        auto packet = parse_tnc2(line);
+        if (!packet) return;
+        ++counters.packets;
+        auto callsign = strip_ssid(packet->source);
+        StationUpdate update;
+        if (!update.set_callsign(callsign) || !roster.load()->contains(callsign)) {
+            return;
+        }
+        ++counters.matches;
+
+        update.fields = StationUpdate::STATUS;
+        update.status = StationStatus::HEARD_DIRECT;
+        if (auto pos = parse_position(*packet)) {
+            update.fields |= StationUpdate::LOCATION;
+            update.latitude = pos->latitude;
+            update.longitude = pos->longitude;
+        }
+        // A full queue means the UI is far behind; a beacon repeats, so drop it
+        net.updates->post(update);
+    }
+
+} // namespace mnn
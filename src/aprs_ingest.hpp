@@ -0,0 +1,89 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <glib.h>
+#include "aprs.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    /* Reads APRS traffic on a worker thread and marks roster stations
+     * heard. source is one of
+     *   host:port        APRS-IS (or anything speaking TNC2 lines over TCP)
+     *   kiss:host:port   a KISS TNC over TCP, e.g. Dire Wolf on 8001
+     *   a file path      a TNC2 capture, read once
+     *
+     * The worker parses in place with no allocation per packet and only
+     * roster matches are posted to the net's UpdateDispatcher, so a full
+     * APRS-IS feed costs the UI nothing but its members. */
+    class AprsIngest
+    {
+    public:
+        AprsIngest(Net& net, std::string source);
+        ~AprsIngest();
+        AprsIngest(const AprsIngest&) = delete;
+        AprsIngest& operator=(const AprsIngest&) = delete;
+
+        void start();
+        void stop();
+
+        struct Stats
+        {
+            std::atomic<std::uint64_t> packets = 0;
+            std::atomic<std::uint64_t> matches = 0;
+        };
+        [[nodiscard]] const Stats& stats() const { return counters; }
+
+    private:
+        struct StringHash
+        {
+            using is_transparent = void;
+            std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+        };
+        using Roster = std::unordered_set<std::string, StringHash, std::equal_to<>>;
+
+        static void on_items_changed(GListModel*, guint, guint, guint, gpointer self);
+
+        void update_roster();
+        void run();
+        int open_source(bool& kiss);
+        void handle_line(std::string_view line);
+
+        Net& net;
+        std::string source;
+        std::atomic<std::shared_ptr<const Roster>> roster;
+        std::thread worker;
+        std::atomic<bool> stopping = false;
+        // Written by stop(); the worker sleeps in poll() until traffic or this
+        int wake_fds[2] = { -1, -1 };
+        Stats counters;
+        gulong items_changed_id = 0;
+    };
+
+} // namespace mnn
@@ -0,0 +1,275 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include <string_view>
+#include "autosave.hpp"
+#include "gio_async.hpp"
+#include "net_library.hpp"
+#include "replica_state.hpp"
+#include "station.hpp"
+#include "thread_pool.hpp"
+
+namespace
+{
+    using namespace std::literals;
+
+    bool
+    affects_snapshot(std::string_view property)
+    {
+        return "status"sv == property || "is-acknowledged"sv == property || "has-location"sv == property ||
+            "latitude"sv == property || "longitude"sv == property || "callsign"sv == property;
+    }
+
+    std::expected<std::string, std::error_code>
+    gzip(std::span<const std::uint8_t> in)
+    {
+        auto compressor = g_zlib_compressor_new(G_ZLIB_COMPRESSOR_FORMAT_GZIP, -1);
+        std::string out(in.size() / 2 + 64, '\0');
+        std::size_t consumed = 0, produced = 0;
+        GError* error = nullptr;
+        for (;;) {
+            gsize bytes_read = 0, bytes_written = 0;
+            auto result = g_converter_convert(G_CONVERTER(compressor), in.data() + consumed, in.size() - consumed,
+                                              out.data() + produced, out.size() - produced, G_CONVERTER_INPUT_AT_END,
+                                              &bytes_read, &bytes_written, &error);
+            consumed += bytes_read;
+            produced += bytes_written;
+            if (G_CONVERTER_FINISHED == result) break;
+            if (G_CONVERTER_ERROR == result) {
+                if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_NO_SPACE)) {
+                    auto ec = mnn::to_error_code(error);
+                    g_error_free(error);
+                    g_object_unref(compressor);
+                    return std::unexpected(ec);
+                }
+                g_clear_error(&error);
+            }
+            if (produced == out.size() || G_CONVERTER_ERROR == result) {
+                out.resize(out.size() * 2);
+            }
+        }
+        g_object_unref(compressor);
+        out.resize(produced);
+        return out;
+    }
+
+    std::int64_t
+    unix_ms_now()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    using namespace peel;
+
+    Autosave::Autosave(Net& net, std::string path, std::chrono::seconds interval, SessionReader session) :
+        net(net),
+        path(std::move(path)),
+        session(std::move(session)),
+        cancellable(Gio::Cancellable::create()),
+        capture_time(metrics().histogram("mnn_autosave_capture_seconds", "Main thread time to capture an autosave snapshot")),
+        encode_time(metrics().histogram("mnn_autosave_encode_seconds", "Worker time to serialize and compress an autosave snapshot")),
+        written(metrics().counter("mnn_autosave_written", "Autosave snapshots written")),
+        failed(metrics().counter("mnn_autosave_failed", "Autosave snapshots that could not be written"))
+    {
+        auto store = G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations));
+        items_changed_id = g_signal_connect(store, "items-changed", G_CALLBACK(&Autosave::on_items_changed), this);
+        track_stations();
+        set_interval(interval);
+    }
+
+    Autosave::~Autosave()
+    {
+        // A write in flight finds this set and leaves us alone
+        cancellable->cancel();
+        if (timeout_id) {
+            g_source_remove(timeout_id);
+        }
+        g_signal_handler_disconnect(G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations)), items_changed_id);
+        untrack_stations();
+    }
+
+    void
+    Autosave::set_interval(std::chrono::seconds interval)
+    {
+        if (timeout_id) {
+            g_source_remove(timeout_id);
+        }
+        // Seconds granularity lets GLib line our wakeup up with everyone else's
+        timeout_id = g_timeout_add_seconds(static_cast<guint>(std::max<std::chrono::seconds::rep>(interval.count(), 1)), &Autosave::on_timeout, this);
+    }
+
+    std::string
+    Autosave::default_path(std::string_view net_id)
+    {
+        // Net ids are paths; hash them into a flat file name
+        auto digest = g_compute_checksum_for_data(G_CHECKSUM_SHA256, reinterpret_cast<const guchar*>(net_id.data()), net_id.size());
+        auto name = std::string(digest, 16) + ".mnns.gz";
+        g_free(digest);
+        auto path = g_build_filename(g_get_user_state_dir(), "monday-night-net", "snapshots", name.c_str(), nullptr);
+        std::string res(path);
+        g_free(path);
+        return res;
+    }
+
+    void
+    Autosave::track_stations()
+    {
+        auto n = g_list_model_get_n_items(G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations)));
+        table.reset(n);
+        track_range(0, n);
+    }
+
+    void
+    Autosave::track_range(guint begin, guint end)
+    {
+        auto store = G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations));
+        positions.reserve(end);
+        handlers.reserve(end);
+        for (auto i = begin; i < end; ++i) {
+            auto station = static_cast<Station*>(g_list_model_get_item(store, i));
+            positions.emplace(station, i);
+            handlers.emplace_back(station, g_signal_connect(station, "notify", G_CALLBACK(&Autosave::on_station_notify), this));
+        }
+        changed = true;
+    }
+
+    void
+    Autosave::untrack_stations()
+    {
+        for (auto [station, handler] : handlers) {
+            g_signal_handler_disconnect(station, handler);
+            g_object_unref(station);
+        }
+        handlers.clear();
+        positions.clear();
+    }
+
+    void
+    Autosave::on_items_changed(GListModel*, guint position, guint removed, guint added, gpointer data)
+    {
+        auto self = static_cast<Autosave*>(data);
+        if (0 == removed && position == self->handlers.size()) {
+            // Walk-ins: nobody else moves, so only the new stations are read
+            self->table.append(added);
+            self->track_range(position, position + added);
+            return;
+        }
+        // Removals and inserts shift positions; start the table over
+        self->untrack_stations();
+        self->track_stations();
+    }
+
+    void
+    Autosave::on_station_notify(::GObject* station, GParamSpec* pspec, gpointer data)
+    {
+        if (!affects_snapshot(g_param_spec_get_name(pspec))) return;
+        auto self = static_cast<Autosave*>(data);
+        if (auto it = self->positions.find(reinterpret_cast<const Station*>(station)); self->positions.end() != it) {
+            self->table.mark(it->second);
+            self->changed = true;
+        }
+    }
+
+    gboolean
+    Autosave::on_timeout(gpointer data)
+    {
+        static_cast<Autosave*>(data)->save_now();
+        return G_SOURCE_CONTINUE;
+    }
+
+    void
+    Autosave::save_now()
+    {
+        if (writing) return;
+        auto info = session();
+        if (!changed && info == last_session) return;
+
+        NetSnapshot snapshot;
+        {
+            ScopedTimer timer(capture_time);
+            auto store = G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations));
+            snapshot.chunks = table.capture([store](std::size_t i) {
+                auto station = static_cast<Station*>(g_list_model_get_item(store, static_cast<guint>(i)));
+                StationState state{ .callsign = station->get_callsign(),
+                                    .status = station->get_status(),
+                                    .acknowledged = station->is_acknowledged() };
+                if (auto location = station->get_location()) {
+                    state.has_location = true;
+                    state.latitude_udeg = to_microdegrees(location->first);
+                    state.longitude_udeg = to_microdegrees(location->second);
+                }
+                g_object_unref(station);
+                return state;
+            });
+        }
+        snapshot.session = info;
+        snapshot.taken_unix_ms = unix_ms_now();
+        last_session = std::move(info);
+        changed = false;
+        writing = true;
+        spawn(write(std::move(snapshot)));
+    }
+
+    Task<void>
+    Autosave::write(NetSnapshot snapshot)
+    {
+        // The frame's own reference; once it is cancelled we are gone
+        RefPtr<Gio::Cancellable> frame_cancellable = cancellable;
+        auto cancel = static_cast<Gio::Cancellable*>(frame_cancellable);
+        auto target = path;
+        // The registry outlives us; members don't, once we leave the main thread
+        auto& encode = encode_time;
+
+        co_await thread_pool().schedule();
+        std::expected<std::string, std::error_code> contents;
+        {
+            ScopedTimer timer(encode);
+            contents = gzip(serialize_snapshot(snapshot));
+        }
+        if (contents) {
+            auto dir = g_path_get_dirname(target.c_str());
+            g_mkdir_with_parents(dir, 0700);
+            g_free(dir);
+        }
+        if (!co_await resume_on_main(cancel)) co_return;
+
+        std::error_code ec = contents ? std::error_code() : contents.error();
+        if (contents) {
+            ec = co_await replace_contents(target, std::move(*contents), cancel);
+            if (cancel->is_cancelled()) co_return;
+        }
+        writing = false;
+        if (ec) {
+            failed.add();
+            g_warning("Unable to write the autosave snapshot %s: %s", target.c_str(), ec.message().c_str());
+            // Try again next time even if nothing else changes
+            changed = true;
+        } else {
+            written.add();
+        }
+    }
+
+} // namespace mnn
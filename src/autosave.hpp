@@ -0,0 +1,96 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <gio/gio.h>
+#include <peel/Gio/Gio.h>
+#include "metrics.hpp"
+#include "net_snapshot.hpp"
+#include "task.hpp"
+
+namespace mnn
+{
+    struct Net;
+    class Station;
+
+    /* Periodic full snapshots of a net's live state, as gzipped CBOR
+     * (see serialize_snapshot()) replaced atomically at path.
+     *
+     * Stations mark their slot in a SnapshotTable as they change, so the
+     * only main thread work per save is rebuilding the touched chunks and
+     * reading the session fields. Serializing and compressing happen on
+     * the thread pool and the write on GIO's threads. A save is skipped
+     * when nothing changed, or while the previous one is still writing. */
+    class Autosave
+    {
+    public:
+        using SessionReader = std::function<SessionInfo()>;
+
+        Autosave(Net& net, std::string path, std::chrono::seconds interval, SessionReader session);
+        ~Autosave();
+        Autosave(const Autosave&) = delete;
+        Autosave& operator=(const Autosave&) = delete;
+
+        // Captures now, unless a write is still in flight
+        void save_now();
+        // Restarts the period from now
+        void set_interval(std::chrono::seconds);
+
+        // Under the user state directory, one file per net id
+        [[nodiscard]] static std::string default_path(std::string_view net_id);
+
+    private:
+        static gboolean on_timeout(gpointer self);
+        static void on_items_changed(GListModel*, guint position, guint removed, guint added, gpointer self);
+        static void on_station_notify(::GObject* station, GParamSpec*, gpointer self);
+
+        void track_stations();
+        // Stations [begin, end) of the store, which the table already covers
+        void track_range(guint begin, guint end);
+        void untrack_stations();
+        Task<void> write(NetSnapshot);
+
+        Net& net;
+        std::string path;
+        SessionReader session;
+        peel::RefPtr<peel::Gio::Cancellable> cancellable;
+        SnapshotTable table;
+        // Position in the net's store, for marking
+        std::unordered_map<const Station*, std::size_t> positions;
+        std::vector<std::pair<Station*, gulong>> handlers;
+        SessionInfo last_session;
+        bool changed = true;
+        bool writing = false;
+        gulong items_changed_id = 0;
+        guint timeout_id = 0;
+
+        Histogram& capture_time;
+        Histogram& encode_time;
+        Counter& written;
+        Counter& failed;
+    };
+
+} // namespace mnn
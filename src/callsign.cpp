@@ -0,0 +1,156 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "callsign.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    using namespace mnn;
+    using namespace std::literals;
+
+    consteval bool
+    itu_table_is_disjoint()
+    {
+        for (std::size_t i = 1; i < itu_table.size(); ++i) {
+            if (!(itu_table[i - 1].hi < itu_table[i].lo)) return false;
+        }
+        return std::ranges::all_of(itu_table, [](const auto& a) { return a.lo <= a.hi; });
+    }
+    static_assert(itu_table_is_disjoint());
+
+    static_assert(split_callsign("KI6KVZ").suffix_begin == 3);
+    static_assert(split_callsign("W1AW").suffix_begin == 2);
+    static_assert(split_callsign("GB3RS").suffix_begin == 3);
+    static_assert(split_callsign("3DA0RU").suffix_begin == 4);
+    static_assert(split_callsign("9A1A").suffix_begin == 3);
+    static_assert(split_callsign("2E0ABC").suffix_begin == 3);
+    static_assert(split_callsign("GB100RSGB").suffix_begin == 5);
+    static_assert(split_callsign("KH6/W1AW").suffix_begin == 6);
+    static_assert(split_callsign("W1AW/P").suffix_begin == 2);
+    static_assert(split_callsign("KH6/W1AW/QRP").suffix_begin == 6);
+    static_assert(split_callsign("VP2E/W1AW").suffix_begin == 7);
+    static_assert(!is_valid_callsign(""));
+    static_assert(!is_valid_callsign("KVZ"));
+    static_assert(!is_valid_callsign("K6"));
+    static_assert(!is_valid_callsign("123"));
+    static_assert(!is_valid_callsign("KI6KVZXY"));
+    static_assert(!is_valid_callsign("ki6kvz"));
+    static_assert(!is_valid_callsign("W1AW/"));
+    static_assert(!is_valid_callsign("/W1AW"));
+    static_assert(!is_valid_callsign("P/W1AW"));
+    static_assert(!is_valid_callsign("W1AW/P/KH6"));
+
+    static_assert(callsign_entity("KI6KVZ") == "United States"sv);
+    static_assert(callsign_entity("3DA0RU") == "Eswatini"sv);
+    static_assert(callsign_entity("3DN0AA") == "Fiji"sv);
+    static_assert(callsign_entity("9A1A") == "Croatia"sv);
+    static_assert(callsign_entity("2E0ABC") == "United Kingdom"sv);
+    static_assert(callsign_entity("A61AB") == "United Arab Emirates"sv);
+    static_assert(callsign_entity("ST2AA") == "Sudan"sv);
+    static_assert(callsign_entity("KH6/W1AW") == "United States"sv);
+    static_assert(callsign_entity("W1AW/VE3") == "Canada"sv);
+    static_assert(callsign_entity("F/G3ABC") == "France"sv);
+
+    struct Masks16
+    {
+        std::uint32_t present;
+        std::uint32_t letter;
+        std::uint32_t digit;
+        std::uint32_t slash;
+    };
+
+#if defined(__SSE2__)
+    inline Masks16
+    classify16(const PackedCallsign& p) noexcept
+    {
+        auto v = _mm_load_si128(reinterpret_cast<const __m128i*>(p.chars.data()));
+        // Signed compares: bytes >= 0x80 are negative and fail both ranges
+        auto in_range = [v](char lo, char hi) {
+            return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                                 _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1))));
+        };
+        auto mask = [](__m128i m) { return static_cast<std::uint32_t>(_mm_movemask_epi8(m)); };
+        return { ~mask(_mm_cmpeq_epi8(v, _mm_setzero_si128())) & 0xFFFFu,
+                 mask(in_range('A', 'Z')),
+                 mask(in_range('0', '9')),
+                 mask(_mm_cmpeq_epi8(v, _mm_set1_epi8('/'))) };
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    inline std::uint32_t
+    movemask(uint8x16_t m) noexcept
+    {
+        constexpr uint8x16_t weights = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+        auto bits = vandq_u8(m, weights);
+        return vaddv_u8(vget_low_u8(bits)) | (static_cast<std::uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+    }
+
+    inline Masks16
+    classify16(const PackedCallsign& p) noexcept
+    {
+        auto v = vld1q_u8(reinterpret_cast<const std::uint8_t*>(p.chars.data()));
+        auto in_range = [v](char lo, char hi) {
+            return vandq_u8(vcgeq_u8(v, vdupq_n_u8(lo)), vcleq_u8(v, vdupq_n_u8(hi)));
+        };
+        return { ~movemask(vceqq_u8(v, vdupq_n_u8(0))) & 0xFFFFu,
+                 movemask(in_range('A', 'Z')),
+                 movemask(in_range('0', '9')),
+                 movemask(vceqq_u8(v, vdupq_n_u8('/'))) };
+    }
+#else
+    inline Masks16
+    classify16(const PackedCallsign& p) noexcept
+    {
+        Masks16 m{};
+        for (std::size_t i = 0; i < p.chars.size(); ++i) {
+            auto c = p.chars[i];
+            auto bit = std::uint32_t{1} << i;
+            if ('\0' != c) m.present |= bit;
+            if (c >= 'A' && c <= 'Z') m.letter |= bit;
+            if (c >= '0' && c <= '9') m.digit |= bit;
+            if ('/' == c) m.slash |= bit;
+        }
+        return m;
+    }
+#endif
+
+} // anonymous namespace
+
+namespace mnn
+{
+    void
+    split_callsigns(std::span<const PackedCallsign> in, std::span<CallsignSplit> out) noexcept
+    {
+        auto n = std::min(in.size(), out.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            auto m = classify16(in[i]);
+            if (0 != m.slash) [[unlikely]] {
+                out[i] = split_callsign(in[i].view());
+                continue;
+            }
+            auto suffix_begin = detail::split_base_masks({ m.present, m.letter, m.digit, 0 });
+            out[i] = { suffix_begin, 0, suffix_begin, 0 != suffix_begin };
+        }
+    }
+
+} // namespace mnn
@@ -0,0 +1,464 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/* Callsign grammar and the ITU callsign series table.
+ *
+ * A base callsign is a stem of one to three characters containing at least
+ * one letter (K, KI, 9A, 3DA), a numeral of one to four digits, and a suffix
+ * of one to four letters. The prefix shown in the roster is the stem plus
+ * the numeral, so 3DA0RU splits as 3DA0 + RU and 9A1A as 9A1 + A.
+ *
+ * Up to two more parts may be attached with '/': a location designator
+ * (KH6/W1AW, W1AW/VE3), a call area digit (W1AW/6) or an operating modifier
+ * (W1AW/P, W1AW/QRP). The roster suffix begins at the base suffix and runs to
+ * the end, so the prefix and suffix still concatenate to the callsign.
+ *
+ * Everything here is constexpr; the grammar is checked with static_assert in
+ * callsign.cpp. */
+namespace mnn
+{
+    struct ItuAllocation
+    {
+        // Inclusive bounds on the first three characters of a designator
+        std::array<char, 3> lo;
+        std::array<char, 3> hi;
+        std::string_view entity;
+    };
+
+    struct CallsignSplit
+    {
+        // prefix is [0, suffix_begin), suffix is [suffix_begin, size)
+        std::uint8_t suffix_begin = 0;
+        // The characters identifying the ITU allocation
+        std::uint8_t designator_begin = 0;
+        std::uint8_t designator_end = 0;
+        bool valid = false;
+    };
+
+    // Callsigns packed for bulk validation: NUL padded, 16 byte aligned
+    inline constexpr std::size_t max_callsign_length = 15;
+    struct alignas(16) PackedCallsign
+    {
+        std::array<char, 16> chars{};
+
+        constexpr PackedCallsign() = default;
+        constexpr explicit PackedCallsign(std::string_view callsign) noexcept
+        {
+            if (callsign.size() <= max_callsign_length) {
+                std::ranges::copy(callsign, chars.begin());
+            } else {
+                // Unrepresentable; '#' fails every character class
+                chars.fill('#');
+            }
+        }
+
+        [[nodiscard]] constexpr std::string_view view() const noexcept
+        {
+            return { chars.data(), static_cast<std::size_t>(std::ranges::find(chars, '\0') - chars.begin()) };
+        }
+    };
+
+    namespace detail
+    {
+        struct SeriesSource
+        {
+            std::string_view lo;
+            std::string_view hi;
+            std::string_view entity;
+        };
+
+        // ITU Radio Regulations Appendix 42, table of allocation of international call sign series
+        inline constexpr SeriesSource itu_series[] = {
+            { "AA", "AL", "United States" },         { "AM", "AO", "Spain" },
+            { "AP", "AS", "Pakistan" },              { "AT", "AW", "India" },
+            { "AX", "AX", "Australia" },             { "AY", "AZ", "Argentina" },
+            { "A2", "A2", "Botswana" },              { "A3", "A3", "Tonga" },
+            { "A4", "A4", "Oman" },                  { "A5", "A5", "Bhutan" },
+            { "A6", "A6", "United Arab Emirates" },  { "A7", "A7", "Qatar" },
+            { "A8", "A8", "Liberia" },               { "A9", "A9", "Bahrain" },
+            { "B", "B", "China" },
+            { "CA", "CE", "Chile" },                 { "CF", "CK", "Canada" },
+            { "CL", "CM", "Cuba" },                  { "CN", "CN", "Morocco" },
+            { "CO", "CO", "Cuba" },                  { "CP", "CP", "Bolivia" },
+            { "CQ", "CU", "Portugal" },              { "CV", "CX", "Uruguay" },
+            { "CY", "CZ", "Canada" },                { "C2", "C2", "Nauru" },
+            { "C3", "C3", "Andorra" },               { "C4", "C4", "Cyprus" },
+            { "C5", "C5", "Gambia" },                { "C6", "C6", "Bahamas" },
+            { "C7", "C7", "World Meteorological Organization" },
+            { "C8", "C9", "Mozambique" },
+            { "DA", "DR", "Germany" },               { "DS", "DT", "Republic of Korea" },
+            { "DU", "DZ", "Philippines" },           { "D2", "D3", "Angola" },
+            { "D4", "D4", "Cape Verde" },            { "D5", "D5", "Liberia" },
+            { "D6", "D6", "Comoros" },               { "D7", "D9", "Republic of Korea" },
+            { "EA", "EH", "Spain" },                 { "EI", "EJ", "Ireland" },
+            { "EK", "EK", "Armenia" },               { "EL", "EL", "Liberia" },
+            { "EM", "EO", "Ukraine" },               { "EP", "EQ", "Iran" },
+            { "ER", "ER", "Moldova" },               { "ES", "ES", "Estonia" },
+            { "ET", "ET", "Ethiopia" },              { "EU", "EW", "Belarus" },
+            { "EX", "EX", "Kyrgyzstan" },            { "EY", "EY", "Tajikistan" },
+            { "EZ", "EZ", "Turkmenistan" },          { "E2", "E2", "Thailand" },
+            { "E3", "E3", "Eritrea" },               { "E4", "E4", "Palestine" },
+            { "E5", "E5", "Cook Islands" },          { "E6", "E6", "Niue" },
+            { "E7", "E7", "Bosnia and Herzegovina" },
+            { "F", "F", "France" },
+            { "G", "G", "United Kingdom" },
+            { "HA", "HA", "Hungary" },               { "HB", "HB", "Switzerland" },
+            { "HC", "HD", "Ecuador" },               { "HE", "HE", "Switzerland" },
+            { "HF", "HF", "Poland" },                { "HG", "HG", "Hungary" },
+            { "HH", "HH", "Haiti" },                 { "HI", "HI", "Dominican Republic" },
+            { "HJ", "HK", "Colombia" },              { "HL", "HL", "Republic of Korea" },
+            { "HM", "HM", "Democratic People's Republic of Korea" },
+            { "HN", "HN", "Iraq" },                  { "HO", "HP", "Panama" },
+            { "HQ", "HR", "Honduras" },              { "HS", "HS", "Thailand" },
+            { "HT", "HT", "Nicaragua" },             { "HU", "HU", "El Salvador" },
+            { "HV", "HV", "Vatican" },               { "HW", "HY", "France" },
+            { "HZ", "HZ", "Saudi Arabia" },          { "H2", "H2", "Cyprus" },
+            { "H3", "H3", "Panama" },                { "H4", "H4", "Solomon Islands" },
+            { "H6", "H7", "Nicaragua" },             { "H8", "H9", "Panama" },
+            { "I", "I", "Italy" },
+            { "JA", "JS", "Japan" },                 { "JT", "JV", "Mongolia" },
+            { "JW", "JX", "Norway" },                { "JY", "JY", "Jordan" },
+            { "JZ", "JZ", "Indonesia" },             { "J2", "J2", "Djibouti" },
+            { "J3", "J3", "Grenada" },               { "J4", "J4", "Greece" },
+            { "J5", "J5", "Guinea-Bissau" },         { "J6", "J6", "Saint Lucia" },
+            { "J7", "J7", "Dominica" },              { "J8", "J8", "Saint Vincent and the Grenadines" },
+            { "K", "K", "United States" },
+            { "LA", "LN", "Norway" },                { "LO", "LW", "Argentina" },
+            { "LX", "LX", "Luxembourg" },            { "LY", "LY", "Lithuania" },
+            { "LZ", "LZ", "Bulgaria" },              { "L2", "L9", "Argentina" },
+            { "M", "M", "United Kingdom" },
+            { "N", "N", "United States" },
+            { "OA", "OC", "Peru" },                  { "OD", "OD", "Lebanon" },
+            { "OE", "OE", "Austria" },               { "OF", "OJ", "Finland" },
+            { "OK", "OL", "Czech Republic" },        { "OM", "OM", "Slovakia" },
+            { "ON", "OT", "Belgium" },               { "OU", "OZ", "Denmark" },
+            { "PA", "PI", "Netherlands" },           { "PJ", "PJ", "Netherlands (Caribbean)" },
+            { "PK", "PO", "Indonesia" },             { "PP", "PY", "Brazil" },
+            { "PZ", "PZ", "Suriname" },              { "P2", "P2", "Papua New Guinea" },
+            { "P3", "P3", "Cyprus" },                { "P4", "P4", "Aruba" },
+            { "P5", "P9", "Democratic People's Republic of Korea" },
+            { "R", "R", "Russian Federation" },
+            { "SA", "SM", "Sweden" },                { "SN", "SR", "Poland" },
+            { "SSA", "SSM", "Egypt" },               { "SSN", "STZ", "Sudan" },
+            { "SU", "SU", "Egypt" },                 { "SV", "SZ", "Greece" },
+            { "S2", "S3", "Bangladesh" },            { "S5", "S5", "Slovenia" },
+            { "S6", "S6", "Singapore" },             { "S7", "S7", "Seychelles" },
+            { "S8", "S8", "South Africa" },          { "S9", "S9", "Sao Tome and Principe" },
+            { "TA", "TC", "Turkey" },                { "TD", "TD", "Guatemala" },
+            { "TE", "TE", "Costa Rica" },            { "TF", "TF", "Iceland" },
+            { "TG", "TG", "Guatemala" },             { "TH", "TH", "France" },
+            { "TI", "TI", "Costa Rica" },            { "TJ", "TJ", "Cameroon" },
+            { "TK", "TK", "France" },                { "TL", "TL", "Central African Republic" },
+            { "TM", "TM", "France" },                { "TN", "TN", "Congo" },
+            { "TO", "TQ", "France" },                { "TR", "TR", "Gabon" },
+            { "TS", "TS", "Tunisia" },               { "TT", "TT", "Chad" },
+            { "TU", "TU", "Cote d'Ivoire" },         { "TV", "TX", "France" },
+            { "TY", "TY", "Benin" },                 { "TZ", "TZ", "Mali" },
+            { "T2", "T2", "Tuvalu" },                { "T3", "T3", "Kiribati" },
+            { "T4", "T4", "Cuba" },                  { "T5", "T5", "Somalia" },
+            { "T6", "T6", "Afghanistan" },           { "T7", "T7", "San Marino" },
+            { "T8", "T8", "Palau" },
+            { "UA", "UI", "Russian Federation" },    { "UJ", "UM", "Uzbekistan" },
+            { "UN", "UQ", "Kazakhstan" },            { "UR", "UZ", "Ukraine" },
+            { "VA", "VG", "Canada" },                { "VH", "VN", "Australia" },
+            { "VO", "VO", "Canada" },                { "VP", "VQ", "United Kingdom" },
+            { "VR", "VR", "China (Hong Kong)" },     { "VS", "VS", "United Kingdom" },
+            { "VT", "VW", "India" },                 { "VX", "VY", "Canada" },
+            { "VZ", "VZ", "Australia" },             { "V2", "V2", "Antigua and Barbuda" },
+            { "V3", "V3", "Belize" },                { "V4", "V4", "Saint Kitts and Nevis" },
+            { "V5", "V5", "Namibia" },               { "V6", "V6", "Micronesia" },
+            { "V7", "V7", "Marshall Islands" },      { "V8", "V8", "Brunei Darussalam" },
+            { "W", "W", "United States" },
+            { "XA", "XI", "Mexico" },                { "XJ", "XO", "Canada" },
+            { "XP", "XP", "Denmark (Greenland)" },   { "XQ", "XR", "Chile" },
+            { "XS", "XS", "China" },                 { "XT", "XT", "Burkina Faso" },
+            { "XU", "XU", "Cambodia" },              { "XV", "XV", "Viet Nam" },
+            { "XW", "XW", "Lao People's Democratic Republic" },
+            { "XX", "XX", "China (Macao)" },         { "XY", "XZ", "Myanmar" },
+            { "YA", "YA", "Afghanistan" },           { "YB", "YH", "Indonesia" },
+            { "YI", "YI", "Iraq" },                  { "YJ", "YJ", "Vanuatu" },
+            { "YK", "YK", "Syrian Arab Republic" },  { "YL", "YL", "Latvia" },
+            { "YM", "YM", "Turkey" },                { "YN", "YN", "Nicaragua" },
+            { "YO", "YR", "Romania" },               { "YS", "YS", "El Salvador" },
+            { "YT", "YU", "Serbia" },                { "YV", "YY", "Venezuela" },
+            { "Y2", "Y9", "Germany" },
+            { "ZA", "ZA", "Albania" },               { "ZB", "ZJ", "United Kingdom" },
+            { "ZK", "ZM", "New Zealand" },           { "ZN", "ZO", "United Kingdom" },
+            { "ZP", "ZP", "Paraguay" },              { "ZQ", "ZQ", "United Kingdom" },
+            { "ZR", "ZU", "South Africa" },          { "ZV", "ZZ", "Brazil" },
+            { "Z2", "Z2", "Zimbabwe" },              { "Z3", "Z3", "North Macedonia" },
+            { "Z8", "Z8", "South Sudan" },
+            { "2", "2", "United Kingdom" },
+            { "3A", "3A", "Monaco" },                { "3B", "3B", "Mauritius" },
+            { "3C", "3C", "Equatorial Guinea" },     { "3DA", "3DM", "Eswatini" },
+            { "3DN", "3DZ", "Fiji" },                { "3E", "3F", "Panama" },
+            { "3G", "3G", "Chile" },                 { "3H", "3U", "China" },
+            { "3V", "3V", "Tunisia" },               { "3W", "3W", "Viet Nam" },
+            { "3X", "3X", "Guinea" },                { "3Y", "3Y", "Norway" },
+            { "3Z", "3Z", "Poland" },
+            { "4A", "4C", "Mexico" },                { "4D", "4I", "Philippines" },
+            { "4J", "4K", "Azerbaijan" },            { "4L", "4L", "Georgia" },
+            { "4M", "4M", "Venezuela" },             { "4O", "4O", "Montenegro" },
+            { "4P", "4S", "Sri Lanka" },             { "4T", "4T", "Peru" },
+            { "4U", "4U", "United Nations" },        { "4V", "4V", "Haiti" },
+            { "4W", "4W", "Timor-Leste" },           { "4X", "4X", "Israel" },
+            { "4Y", "4Y", "International Civil Aviation Organization" },
+            { "4Z", "4Z", "Israel" },
+            { "5A", "5A", "Libya" },                 { "5B", "5B", "Cyprus" },
+            { "5C", "5G", "Morocco" },               { "5H", "5I", "Tanzania" },
+            { "5J", "5K", "Colombia" },              { "5L", "5M", "Liberia" },
+            { "5N", "5O", "Nigeria" },               { "5P", "5Q", "Denmark" },
+            { "5R", "5S", "Madagascar" },            { "5T", "5T", "Mauritania" },
+            { "5U", "5U", "Niger" },                 { "5V", "5V", "Togo" },
+            { "5W", "5W", "Samoa" },                 { "5X", "5X", "Uganda" },
+            { "5Y", "5Z", "Kenya" },
+            { "6A", "6B", "Egypt" },                 { "6C", "6C", "Syrian Arab Republic" },
+            { "6D", "6J", "Mexico" },                { "6K", "6N", "Republic of Korea" },
+            { "6O", "6O", "Somalia" },               { "6P", "6S", "Pakistan" },
+            { "6T", "6U", "Sudan" },                 { "6V", "6W", "Senegal" },
+            { "6X", "6X", "Madagascar" },            { "6Y", "6Y", "Jamaica" },
+            { "6Z", "6Z", "Liberia" },
+            { "7A", "7I", "Indonesia" },             { "7J", "7N", "Japan" },
+            { "7O", "7O", "Yemen" },                 { "7P", "7P", "Lesotho" },
+            { "7Q", "7Q", "Malawi" },                { "7R", "7R", "Algeria" },
+            { "7S", "7S", "Sweden" },                { "7T", "7Y", "Algeria" },
+            { "7Z", "7Z", "Saudi Arabia" },
+            { "8A", "8I", "Indonesia" },             { "8J", "8N", "Japan" },
+            { "8O", "8O", "Botswana" },              { "8P", "8P", "Barbados" },
+            { "8Q", "8Q", "Maldives" },              { "8R", "8R", "Guyana" },
+            { "8S", "8S", "Sweden" },                { "8T", "8Y", "India" },
+            { "8Z", "8Z", "Saudi Arabia" },
+            { "9A", "9A", "Croatia" },               { "9B", "9D", "Iran" },
+            { "9E", "9F", "Ethiopia" },              { "9G", "9G", "Ghana" },
+            { "9H", "9H", "Malta" },                 { "9I", "9J", "Zambia" },
+            { "9K", "9K", "Kuwait" },                { "9L", "9L", "Sierra Leone" },
+            { "9M", "9M", "Malaysia" },              { "9N", "9N", "Nepal" },
+            { "9O", "9T", "Democratic Republic of the Congo" },
+            { "9U", "9U", "Burundi" },               { "9V", "9V", "Singapore" },
+            { "9W", "9W", "Malaysia" },              { "9X", "9X", "Rwanda" },
+            { "9Y", "9Z", "Trinidad and Tobago" },
+        };
+
+        /* Pad designator bounds to three characters. '0' sorts below and 'Z'
+         * above every character a callsign may contain, so the single letter
+         * series K covers K0 through KZZ. */
+        constexpr std::array<char, 3>
+        pad(std::string_view s, char fill)
+        {
+            std::array<char, 3> res{ fill, fill, fill };
+            std::ranges::copy(s, res.begin());
+            return res;
+        }
+
+        consteval auto
+        build_itu_table()
+        {
+            std::array<ItuAllocation, std::size(itu_series)> table{};
+            for (std::size_t i = 0; i < table.size(); ++i) {
+                table[i] = { pad(itu_series[i].lo, '0'), pad(itu_series[i].hi, 'Z'), itu_series[i].entity };
+            }
+            std::ranges::sort(table, {}, &ItuAllocation::lo);
+            return table;
+        }
+
+        constexpr bool is_letter(char c) noexcept { return c >= 'A' && c <= 'Z'; }
+        constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+        // Character class bitmasks, one bit per character position
+        struct ClassMasks
+        {
+            std::uint32_t present = 0;
+            std::uint32_t letter = 0;
+            std::uint32_t digit = 0;
+            std::uint32_t slash = 0;
+        };
+
+        constexpr ClassMasks
+        classify(std::string_view s) noexcept
+        {
+            ClassMasks m;
+            for (std::size_t i = 0; i < s.size() && i < 32; ++i) {
+                auto bit = std::uint32_t{1} << i;
+                m.present |= bit;
+                if (is_letter(s[i])) m.letter |= bit;
+                if (is_digit(s[i]))  m.digit  |= bit;
+                if ('/' == s[i])     m.slash  |= bit;
+            }
+            return m;
+        }
+
+        /* The base callsign grammar evaluated on character class masks, so
+         * the scalar and vector paths share it exactly. Expects no slashes.
+         * Returns the suffix position, or 0 if m is not a base callsign. */
+        constexpr std::uint8_t
+        split_base_masks(const ClassMasks& m) noexcept
+        {
+            if (0 == m.present || 0 != (m.present & (m.present + 1))) return 0;   // empty or holes
+            if (0 != (m.present & ~(m.letter | m.digit))) return 0;
+            if (0 == m.digit) return 0;
+
+            auto numeral_end = static_cast<int>(std::bit_width(m.digit));                       // one past the last digit
+            auto suffix_len = std::popcount(m.present >> numeral_end);
+            if (suffix_len < 1 || suffix_len > 4) return 0;
+
+            auto below = (std::uint32_t{1} << (numeral_end - 1)) - 1;
+            auto stem_end = static_cast<int>(std::bit_width(~m.digit & below));                 // numeral starts here
+            auto numeral_len = numeral_end - stem_end;
+            if (stem_end < 1 || stem_end > 3 || numeral_len > 4) return 0;
+            if (0 == (m.letter & ((std::uint32_t{1} << stem_end) - 1))) return 0;
+            return static_cast<std::uint8_t>(numeral_end);
+        }
+
+        constexpr std::uint8_t
+        split_base(std::string_view s) noexcept
+        {
+            return s.size() > max_callsign_length ? 0 : split_base_masks(classify(s));
+        }
+
+        constexpr bool
+        is_modifier(std::string_view s) noexcept
+        {
+            constexpr std::string_view modifiers[] = { "P", "M", "MM", "AM", "A", "QRP", "QRPP", "LH" };
+            return std::ranges::find(modifiers, s) != std::end(modifiers) ||
+                (1 == s.size() && is_digit(s[0]));
+        }
+
+        // KH6, VE3, F, VP2E: a location prefix in front of or behind a call
+        constexpr bool
+        is_designator(std::string_view s) noexcept
+        {
+            return !s.empty() && s.size() <= 4 && !is_modifier(s) &&
+                std::ranges::all_of(s, [](char c) { return is_letter(c) || is_digit(c); }) &&
+                std::ranges::any_of(s, is_letter);
+        }
+
+    } // namespace detail
+
+    inline constexpr auto itu_table = detail::build_itu_table();
+
+    [[nodiscard]] constexpr const ItuAllocation*
+    lookup_itu(std::string_view designator) noexcept
+    {
+        if (designator.empty()) return nullptr;
+        std::array<char, 3> key{ '0', '0', '0' };
+        std::ranges::copy(designator.substr(0, 3), key.begin());
+        auto it = std::ranges::upper_bound(itu_table, key, {}, &ItuAllocation::lo);
+        if (it == itu_table.begin()) return nullptr;
+        --it;
+        return key <= it->hi ? &*it : nullptr;
+    }
+
+    [[nodiscard]] constexpr CallsignSplit
+    split_callsign(std::string_view callsign) noexcept
+    {
+        if (callsign.empty() || callsign.size() > max_callsign_length) return {};
+
+        if (callsign.find('/') == std::string_view::npos) {
+            auto suffix_begin = detail::split_base(callsign);
+            return { suffix_begin, 0, suffix_begin, 0 != suffix_begin };
+        }
+
+        std::array<std::string_view, 3> parts;
+        std::array<std::size_t, 3> offsets{};
+        std::size_t n = 0;
+        for (std::size_t pos = 0; ; ++n) {
+            if (n == parts.size()) return {};
+            auto slash = callsign.find('/', pos);
+            offsets[n] = pos;
+            parts[n] = callsign.substr(pos, slash == std::string_view::npos ? slash : slash - pos);
+            if (parts[n].empty()) return {};
+            if (slash == std::string_view::npos) { ++n; break; }
+            pos = slash + 1;
+        }
+
+        /* The base is the part that parses as a callsign. If two do
+         * (VP2E/W1AW) prefer the longer suffix, then the longer part. */
+        std::size_t base = n;
+        std::uint8_t base_suffix = 0;
+        auto score = [&](std::size_t i, std::uint8_t suffix) {
+            return std::pair{ parts[i].size() - suffix, parts[i].size() };
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            auto s = detail::split_base(parts[i]);
+            if (0 != s && (base == n || score(i, s) > score(base, base_suffix))) {
+                base = i;
+                base_suffix = s;
+            }
+        }
+        if (base == n) return {};
+
+        std::size_t designator = n;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i == base) continue;
+            if (detail::is_designator(parts[i]) || detail::split_base(parts[i])) {
+                if (designator != n || i > base + 1) return {};
+                designator = i;
+            } else if (!detail::is_modifier(parts[i]) || i < base) {
+                return {};
+            }
+        }
+
+        CallsignSplit res;
+        res.valid = true;
+        res.suffix_begin = static_cast<std::uint8_t>(offsets[base] + base_suffix);
+        if (designator != n) {
+            res.designator_begin = static_cast<std::uint8_t>(offsets[designator]);
+            res.designator_end = static_cast<std::uint8_t>(offsets[designator] + parts[designator].size());
+        } else {
+            res.designator_begin = static_cast<std::uint8_t>(offsets[base]);
+            res.designator_end = res.suffix_begin;
+        }
+        return res;
+    }
+
+    [[nodiscard]] constexpr bool
+    is_valid_callsign(std::string_view callsign) noexcept
+    {
+        return split_callsign(callsign).valid;
+    }
+
+    // ITU entity for a callsign, or an empty view
+    [[nodiscard]] constexpr std::string_view
+    callsign_entity(std::string_view callsign, const CallsignSplit& split) noexcept
+    {
+        if (!split.valid) return {};
+        auto alloc = lookup_itu(callsign.substr(split.designator_begin, split.designator_end - split.designator_begin));
+        return alloc ? alloc->entity : std::string_view{};
+    }
+
+    [[nodiscard]] constexpr std::string_view
+    callsign_entity(std::string_view callsign) noexcept
+    {
+        return callsign_entity(callsign, split_callsign(callsign));
+    }
+
+    /* split_callsign over a packed array. Character classification runs 16
+     * lanes at a time with SSE2 or NEON where available; callsigns with a
+     * '/' fall back to the scalar parser. out must be as large as in. */
+    void split_callsigns(std::span<const PackedCallsign> in, std::span<CallsignSplit> out) noexcept;
+
+} // namespace mnn
@@ -0,0 +1,106 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include "checkin_replay.hpp"
+
+namespace mnn
+{
+    Histogram&
+    checkin_command_latency()
+    {
+        static auto& h = metrics().histogram("mnn_checkin_command_seconds", "Time to apply one check-in or acknowledgement, notify handlers included");
+        return h;
+    }
+
+    CheckinReplay::CheckinReplay(std::vector<CheckinEvent> events, double speedup, Lookup lookup, Finished finished) :
+        events(std::move(events)),
+        speedup(std::max(speedup, 0.001)),
+        lookup(std::move(lookup)),
+        finished(std::move(finished))
+    {
+    }
+
+    CheckinReplay::~CheckinReplay()
+    {
+        stop();
+    }
+
+    void
+    CheckinReplay::start()
+    {
+        stop();
+        next = applied = missed = 0;
+        start_us = g_get_monotonic_time();
+        schedule_next();
+    }
+
+    void
+    CheckinReplay::stop()
+    {
+        if (0 != source_id) {
+            g_source_remove(source_id);
+            source_id = 0;
+        }
+    }
+
+    void
+    CheckinReplay::schedule_next()
+    {
+        if (next >= events.size()) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::microseconds(g_get_monotonic_time() - start_us));
+            if (finished) finished(applied, missed, elapsed);
+            return;
+        }
+        auto due_us = static_cast<gint64>(std::chrono::duration<double, std::micro>(events[next].offset).count() / speedup);
+        auto wait_us = std::max<gint64>(0, start_us + due_us - g_get_monotonic_time());
+        source_id = g_timeout_add_full(G_PRIORITY_DEFAULT, static_cast<guint>(wait_us / 1000), &CheckinReplay::on_timeout, this, nullptr);
+    }
+
+    void
+    CheckinReplay::apply_due()
+    {
+        auto now_offset = std::chrono::duration<double, std::milli>((g_get_monotonic_time() - start_us) / 1000.0) * speedup;
+        while (next < events.size() && events[next].offset <= now_offset) {
+            const auto& e = events[next++];
+            ScopedTimer timer(checkin_command_latency());
+            auto station = lookup(e.callsign);
+            if (nullptr == station) {
+                ++missed;
+                continue;
+            }
+            if (e.acknowledged) {
+                station->set_is_acknowledged(true);
+            } else {
+                station->set_status(e.status);
+            }
+            ++applied;
+        }
+    }
+
+    gboolean
+    CheckinReplay::on_timeout(gpointer data)
+    {
+        auto self = static_cast<CheckinReplay*>(data);
+        self->source_id = 0;
+        self->apply_due();
+        self->schedule_next();
+        return G_SOURCE_REMOVE;
+    }
+
+} // namespace mnn
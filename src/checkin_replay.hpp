@@ -0,0 +1,69 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string_view>
+#include <vector>
+#include <glib.h>
+#include "metrics.hpp"
+#include "net_generator.hpp"
+#include "station.hpp"
+
+namespace mnn
+{
+    // From looking up the callsign to every notify handler having run
+    [[nodiscard]] Histogram& checkin_command_latency();
+
+    /* Plays a check-in event stream into live Station objects on the GLib
+     * main loop, speedup times faster than real time. Every due event is
+     * applied on each wakeup, so very large speedups degrade to batches
+     * rather than to one timeout per event. */
+    class CheckinReplay
+    {
+    public:
+        using Lookup = std::function<Station*(std::string_view callsign)>;
+        using Finished = std::function<void(std::size_t applied, std::size_t missed, std::chrono::milliseconds elapsed)>;
+
+        CheckinReplay(std::vector<CheckinEvent> events, double speedup, Lookup lookup, Finished finished);
+        ~CheckinReplay();
+        CheckinReplay(const CheckinReplay&) = delete;
+        CheckinReplay& operator=(const CheckinReplay&) = delete;
+
+        void start();
+        void stop();
+
+    private:
+        static gboolean on_timeout(gpointer self);
+        void schedule_next();
+        void apply_due();
+
+        std::vector<CheckinEvent> events;
+        double speedup;
+        Lookup lookup;
+        Finished finished;
+        std::size_t next = 0;
+        std::size_t applied = 0;
+        std::size_t missed = 0;
+        gint64 start_us = 0;
+        guint source_id = 0;
+    };
+
+} // namespace mnn
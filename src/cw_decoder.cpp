@@ -0,0 +1,201 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include "callsign.hpp"
+#include "cw_decoder.hpp"
+
+namespace
+{
+    using namespace std::literals;
+
+    constexpr float block_seconds = 0.008f;
+    /* Toward a new level per block. The floor is the mean noise magnitude,
+     * which noise alone seldom doubles; anything stronger is let in only
+     * slowly, so a long dash barely moves it. Peaks hold across a word. */
+    constexpr float noise_follow = 0.05f;
+    constexpr float noise_rise = 0.002f;
+    constexpr float peak_decay = 0.005f;
+    // Peak over floor before anything counts as keyed, 12 dB
+    constexpr float min_snr = 4.0f;
+    constexpr float min_peak = 1e-4f;
+    // Of the way from floor to peak; apart so a marginal tone doesn't chatter
+    constexpr float key_down_at = 0.6f;
+    constexpr float key_up_at = 0.4f;
+    // Blocks a change must last; shorter blips are noise
+    constexpr unsigned debounce_blocks = 2;
+    constexpr float speed_follow = 0.2f;
+
+    // Dits go left and dahs right from the root at 1
+    constexpr auto morse_tree = [] {
+        std::array<char, 128> tree{};
+        constexpr std::pair<char, std::string_view> codes[] = {
+            { 'A', ".-"sv },    { 'B', "-..."sv },  { 'C', "-.-."sv },  { 'D', "-.."sv },   { 'E', "."sv },
+            { 'F', "..-."sv },  { 'G', "--."sv },   { 'H', "...."sv },  { 'I', ".."sv },    { 'J', ".---"sv },
+            { 'K', "-.-"sv },   { 'L', ".-.."sv },  { 'M', "--"sv },    { 'N', "-."sv },    { 'O', "---"sv },
+            { 'P', ".--."sv },  { 'Q', "--.-"sv },  { 'R', ".-."sv },   { 'S', "..."sv },   { 'T', "-"sv },
+            { 'U', "..-"sv },   { 'V', "...-"sv },  { 'W', ".--"sv },   { 'X', "-..-"sv },  { 'Y', "-.--"sv },
+            { 'Z', "--.."sv },  { '0', "-----"sv }, { '1', ".----"sv }, { '2', "..---"sv }, { '3', "...--"sv },
+            { '4', "....-"sv }, { '5', "....."sv }, { '6', "-...."sv }, { '7', "--..."sv }, { '8', "---.."sv },
+            { '9', "----."sv }, { '/', "-..-."sv }, { '?', "..--.."sv }, { '=', "-...-"sv }, { '.', ".-.-.-"sv },
+            { ',', "--..--"sv },
+        };
+        for (auto [c, code] : codes) {
+            unsigned i = 1;
+            for (auto e : code) i = i * 2 + ('-' == e);
+            tree[i] = c;
+        }
+        return tree;
+    }();
+
+} // anonymous namespace
+
+namespace mnn
+{
+    CwDecoder::CwDecoder(float sample_rate) :
+        block_size(std::max<std::size_t>(static_cast<std::size_t>(std::lround(sample_rate * block_seconds)), 16)),
+        block_length_ms(static_cast<float>(block_size) * 1000.0f / sample_rate)
+    {
+        for (std::size_t k = 0; k < bin_count; ++k) {
+            auto hz = lowest_tone_hz + bin_spacing_hz * static_cast<float>(k);
+            coeff[k] = 2.0f * std::cos(2.0f * std::numbers::pi_v<float> * hz / sample_rate);
+        }
+        word.reserve(max_word_length);
+    }
+
+    bool
+    CwDecoder::process_block() noexcept
+    {
+        bool first = 0 == filled_blocks++;
+        filled = 0;
+        std::array<float, bin_count> mag;
+        auto scale = 2.0f / static_cast<float>(block_size);
+        for (std::size_t k = 0; k < bin_count; ++k) {
+            auto power = s1[k] * s1[k] + s2[k] * s2[k] - coeff[k] * s1[k] * s2[k];
+            mag[k] = std::sqrt(std::max(power, 0.0f)) * scale;
+            s1[k] = s2[k] = 0.0f;
+        }
+        for (std::size_t k = 0; k < bin_count; ++k) {
+            if (first) noise[k] = mag[k];
+            noise[k] += (mag[k] - noise[k]) * (mag[k] < 2.0f * noise[k] ? noise_follow : noise_rise);
+            peak[k] = mag[k] > peak[k] ? mag[k] : peak[k] - (peak[k] - noise[k]) * peak_decay;
+        }
+        if (!down) {
+            // Follow the strongest pitch, but never mid-element
+            std::size_t best = active;
+            for (std::size_t k = 0; k < bin_count; ++k) {
+                if (peak[k] - noise[k] > peak[best] - noise[best]) best = k;
+            }
+            active = best;
+        }
+
+        auto m = mag[active], floor = noise[active], top = peak[active];
+        bool keyed = top > floor * min_snr && top > min_peak &&
+            m > floor + (top - floor) * (down ? key_up_at : key_down_at);
+
+        ++run;
+        if (keyed != down) {
+            if (++pending >= debounce_blocks) {
+                // The change began pending blocks ago
+                run -= pending;
+                key(keyed);
+                run = pending;
+                pending = 0;
+            }
+        } else {
+            pending = 0;
+        }
+
+        if (!down) {
+            auto space_ms = static_cast<float>(run) * block_length_ms;
+            if (1 != code && space_ms >= 2.0f * dot_ms) end_character();
+            if (!word.empty() && space_ms >= 5.0f * dot_ms) return true;
+        }
+        return false;
+    }
+
+    void
+    CwDecoder::key(bool now_down) noexcept
+    {
+        if (down && !now_down) {
+            auto mark_ms = static_cast<float>(run) * block_length_ms;
+            if (mark_ms < 2.0f * dot_ms) {
+                code = code * 2;
+                dot_ms += (mark_ms - dot_ms) * speed_follow;
+            } else {
+                code = code * 2 + 1;
+                dot_ms += (mark_ms / 3.0f - dot_ms) * speed_follow;
+            }
+            // 6 to 60 WPM
+            dot_ms = std::clamp(dot_ms, 20.0f, 200.0f);
+            // Past the tree; stays 0 until the character ends
+            if (code >= morse_tree.size()) code = 0;
+        }
+        down = now_down;
+    }
+
+    void
+    CwDecoder::end_character() noexcept
+    {
+        if (1 == code) return;
+        auto c = morse_tree[code];
+        if (word.size() < max_word_length) {
+            word.push_back(c ? c : '*');
+        }
+        code = 1;
+    }
+
+    std::optional<std::string_view>
+    cw_callsign(std::string_view word) noexcept
+    {
+        std::optional<std::string_view> best;
+        for (std::size_t pos = 0; pos <= word.size();) {
+            auto slash = std::min(word.find('/', pos), word.size());
+            auto part = word.substr(pos, slash - pos);
+            if (is_valid_callsign(part) && (!best || part.size() > best->size())) best = part;
+            pos = slash + 1;
+        }
+        return best;
+    }
+
+    std::optional<CwMatch>
+    match_roster_callsign(std::string_view decoded, std::span<const std::string> roster) noexcept
+    {
+        if (std::ranges::binary_search(roster, decoded)) {
+            return CwMatch{ .callsign = *std::ranges::lower_bound(roster, decoded), .exact = true };
+        }
+        std::optional<CwMatch> near;
+        for (const auto& callsign : roster) {
+            if (callsign.size() != decoded.size()) continue;
+            std::size_t misses = 0;
+            for (std::size_t i = 0; i < callsign.size() && misses < 2; ++i) {
+                misses += callsign[i] != decoded[i];
+            }
+            if (1 != misses) continue;
+            // Two near misses say nothing
+            if (near) return std::nullopt;
+            near = CwMatch{ .callsign = callsign, .exact = false };
+        }
+        return near;
+    }
+
+} // namespace mnn
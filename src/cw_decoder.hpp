@@ -0,0 +1,127 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace mnn
+{
+    /* Morse from audio: a bank of Goertzel filters across the usual CW
+     * pitches, each with its own adaptive noise floor and peak, keys the
+     * strongest tone; mark and space lengths are then read against a dot
+     * length that follows the sender's speed.
+     *
+     * Samples are taken a block at a time (8 ms), so timing is to the
+     * block. The filter bank runs lane-wise across the bins, which
+     * compilers vectorize. A word is handed out once 5 dots of silence
+     * follow it, a few hundred milliseconds at usual speeds. */
+    class CwDecoder
+    {
+    public:
+        static constexpr std::size_t bin_count = 8;
+        static constexpr float lowest_tone_hz = 400.0f;
+        static constexpr float bin_spacing_hz = 100.0f;
+        static constexpr std::size_t max_word_length = 16;
+
+        explicit CwDecoder(float sample_rate = 48000.0f);
+
+        // Calls on_word(std::string_view) for each word completed by samples
+        template <typename F>
+        void
+        feed(std::span<const float> samples, F&& on_word)
+        {
+            for (auto x : samples) {
+                for (std::size_t k = 0; k < bin_count; ++k) {
+                    auto s0 = x + coeff[k] * s1[k] - s2[k];
+                    s2[k] = s1[k];
+                    s1[k] = s0;
+                }
+                if (++filled == block_size && process_block()) {
+                    on_word(std::string_view(word));
+                    word.clear();
+                }
+            }
+        }
+
+        // End of input; hands out whatever was being sent
+        template <typename F>
+        void
+        flush(F&& on_word)
+        {
+            end_character();
+            if (!word.empty()) {
+                on_word(std::string_view(word));
+                word.clear();
+            }
+        }
+
+        [[nodiscard]] float tone_hz() const noexcept { return lowest_tone_hz + bin_spacing_hz * static_cast<float>(active); }
+        [[nodiscard]] float wpm() const noexcept { return 1200.0f / dot_ms; }
+        [[nodiscard]] float block_ms() const noexcept { return block_length_ms; }
+
+    private:
+        // Returns true when a word is complete in word
+        bool process_block() noexcept;
+        void key(bool down) noexcept;
+        void end_character() noexcept;
+
+        std::size_t block_size;
+        float block_length_ms;
+        std::size_t filled = 0;
+        std::size_t filled_blocks = 0;
+        alignas(32) std::array<float, bin_count> coeff{};
+        alignas(32) std::array<float, bin_count> s1{};
+        alignas(32) std::array<float, bin_count> s2{};
+        std::array<float, bin_count> noise{};
+        std::array<float, bin_count> peak{};
+        std::size_t active = 0;
+
+        bool down = false;
+        // Blocks raw has disagreed with down, and blocks in the current run
+        unsigned pending = 0;
+        unsigned run = 0;
+        float dot_ms = 60.0f;
+        // Position in the dot (left) / dash (right) tree, 1 at the root
+        unsigned code = 1;
+        std::string word;
+    };
+
+    // The callsign in a decoded word, "KI6KVZ/R" -> "KI6KVZ"
+    [[nodiscard]] std::optional<std::string_view> cw_callsign(std::string_view word) noexcept;
+
+    struct CwMatch
+    {
+        std::string_view callsign;
+        // False for a near miss, one character off
+        bool exact;
+    };
+
+    /* The roster callsign a decoded one most likely is: itself, or the only
+     * one of the same length a single character away, as a misread dit or
+     * dah gives. roster must be sorted. */
+    [[nodiscard]] std::optional<CwMatch> match_roster_callsign(std::string_view decoded, std::span<const std::string> roster) noexcept;
+
+} // namespace mnn
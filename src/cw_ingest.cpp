@@ -0,0 +1,305 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <span>
+#include <fcntl.h>
+#include <gio/gunixinputstream.h>
+#include <glib/gstdio.h>
+#include "cw_ingest.hpp"
+#include "net_library.hpp"
+
+namespace
+{
+    using namespace std::literals;
+
+    constexpr float default_sample_rate = 48000.0f;
+    constexpr gint64 repeat_window_us = 60 * G_USEC_PER_SEC;
+
+    struct WavFormat
+    {
+        float sample_rate;
+        std::size_t channels;
+        std::size_t data_offset;
+    };
+
+    std::uint32_t
+    read_le(std::span<const std::uint8_t> b, std::size_t at, std::size_t size)
+    {
+        std::uint32_t v = 0;
+        for (std::size_t i = 0; i < size; ++i) v |= static_cast<std::uint32_t>(b[at + i]) << (8 * i);
+        return v;
+    }
+
+    // 16 bit PCM only, with the header all in b
+    std::optional<WavFormat>
+    parse_wav(std::span<const std::uint8_t> b)
+    {
+        auto tag = [&b](std::size_t at, std::string_view t) {
+            return at + 4 <= b.size() && 0 == std::memcmp(b.data() + at, t.data(), 4);
+        };
+        if (!tag(0, "RIFF"sv) || !tag(8, "WAVE"sv)) return std::nullopt;
+        std::optional<WavFormat> format;
+        for (std::size_t at = 12; at + 8 <= b.size();) {
+            auto size = read_le(b, at + 4, 4);
+            if (tag(at, "fmt "sv) && at + 24 <= b.size()) {
+                if (1 != read_le(b, at + 8, 2) || 16 != read_le(b, at + 22, 2)) return std::nullopt;
+                format = WavFormat{ .sample_rate = static_cast<float>(read_le(b, at + 12, 4)),
+                                    .channels = std::max<std::size_t>(read_le(b, at + 10, 2), 1),
+                                    .data_offset = 0 };
+            } else if (tag(at, "data"sv)) {
+                if (format) format->data_offset = at + 8;
+                return format;
+            }
+            at += 8 + size + (size & 1);
+        }
+        return std::nullopt;
+    }
+
+    struct Candidate
+    {
+        std::weak_ptr<mnn::CwIngest::CandidateHandler> handler;
+        std::string callsign;
+        bool exact;
+    };
+
+} // anonymous namespace
+
+namespace mnn
+{
+    using namespace peel;
+
+    CwIngest::CwIngest(Net& net, std::string source, CandidateHandler on_candidate) :
+        net(net),
+        source(std::move(source)),
+        handler(std::make_shared<CandidateHandler>(std::move(on_candidate))),
+        words(metrics().counter("mnn_cw_words", "Words decoded from CW audio")),
+        candidates(metrics().counter("mnn_cw_candidates", "CW callsigns matched to the roster and suggested")),
+        dsp_time(metrics().histogram("mnn_cw_dsp_seconds", "Time to decode one read of CW audio"))
+    {
+    }
+
+    CwIngest::~CwIngest()
+    {
+        stop();
+    }
+
+    void
+    CwIngest::update_roster()
+    {
+        auto keys = std::make_shared<std::vector<std::string>>();
+        keys->reserve(net.by_callsign.size());
+        for (const auto& [callsign, station] : net.by_callsign) {
+            keys->push_back(callsign);
+        }
+        std::ranges::sort(*keys);
+        roster.store(std::move(keys));
+    }
+
+    void
+    CwIngest::on_items_changed(GListModel* model, guint position, guint removed, guint added, gpointer data)
+    {
+        auto self = static_cast<CwIngest*>(data);
+        if (0 != removed || position + added != g_list_model_get_n_items(model)) {
+            self->update_roster();
+            return;
+        }
+        // A walk-in: read it from the store and slot it into a copy, rather than re-sorting the roster
+        auto keys = std::make_shared<std::vector<std::string>>(*self->roster.load());
+        for (auto i = position; i < position + added; ++i) {
+            auto item = g_list_model_get_item(model, i);
+            auto callsign = reinterpret_cast<Station*>(item)->get_callsign();
+            g_object_unref(item);
+            if (auto at = std::ranges::lower_bound(*keys, callsign); keys->end() == at || *at != callsign) {
+                keys->insert(at, std::move(callsign));
+            }
+        }
+        self->roster.store(std::move(keys));
+    }
+
+    void
+    CwIngest::start()
+    {
+        stop();
+        update_roster();
+        items_changed_id = g_signal_connect(static_cast<Gio::ListStore*>(net.stations), "items-changed",
+                                            G_CALLBACK(&CwIngest::on_items_changed), this);
+        cancellable = g_cancellable_new();
+        worker = std::thread(&CwIngest::run, this);
+    }
+
+    void
+    CwIngest::stop()
+    {
+        if (cancellable) {
+            /* Pipes, FIFOs and the recorder's output are read through
+             * GUnixInputStream, which polls the cancellable; regular files
+             * never block for long. The worker stops its recorder itself. */
+            g_cancellable_cancel(cancellable);
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+        g_clear_object(&cancellable);
+        if (0 != items_changed_id) {
+            g_signal_handler_disconnect(static_cast<Gio::ListStore*>(net.stations), items_changed_id);
+            items_changed_id = 0;
+        }
+    }
+
+    GInputStream*
+    CwIngest::open_source(GSubprocess*& recorder)
+    {
+        std::string_view s = source;
+        GError* error = nullptr;
+        if ("pulse"sv == s || s.starts_with("pulse:"sv)) {
+            // parec talks to PipeWire's pulse server just the same
+            std::vector<const char*> argv = { "parec", "--raw", "--format=s16le", "--rate=48000", "--channels=1", "--latency-msec=20" };
+            std::string device;
+            if (s.starts_with("pulse:"sv)) {
+                device = std::format("--device={}", s.substr(6));
+                argv.push_back(device.c_str());
+            }
+            argv.push_back(nullptr);
+            recorder = g_subprocess_newv(argv.data(), static_cast<GSubprocessFlags>(G_SUBPROCESS_FLAGS_STDOUT_PIPE | G_SUBPROCESS_FLAGS_STDERR_SILENCE), &error);
+            if (!recorder) {
+                g_warning("Unable to record CW audio with parec: %s", error->message);
+                g_error_free(error);
+                return nullptr;
+            }
+            return G_INPUT_STREAM(g_object_ref(g_subprocess_get_stdout_pipe(recorder)));
+        }
+        GStatBuf st;
+        if (0 == g_stat(source.c_str(), &st) && !S_ISREG(st.st_mode)) {
+            /* A FIFO or device: opening a FIFO blocks until a writer shows
+             * up, and GFile reads ignore the cancellable, so open without
+             * waiting and read through a stream that polls the cancellable */
+            int fd = g_open(source.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC, 0);
+            if (fd < 0) {
+                g_warning("Unable to open CW audio %s: %s", source.c_str(), g_strerror(errno));
+                return nullptr;
+            }
+            // Reads happen only once the stream has polled the fd readable
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+            return g_unix_input_stream_new(fd, TRUE);
+        }
+        auto file = g_file_new_for_path(source.c_str());
+        auto stream = g_file_read(file, cancellable, &error);
+        g_object_unref(file);
+        if (!stream) {
+            g_warning("Unable to open CW audio %s: %s", source.c_str(), error->message);
+            g_error_free(error);
+            return nullptr;
+        }
+        return G_INPUT_STREAM(stream);
+    }
+
+    void
+    CwIngest::run()
+    {
+        GSubprocess* recorder = nullptr;
+        auto stream = open_source(recorder);
+        if (!stream) return;
+
+        std::optional<CwDecoder> decoder;
+        std::size_t channels = 1;
+        auto on_word = [this](std::string_view word) { handle_word(word); };
+        std::array<std::uint8_t, 16 * 1024> bytes;
+        std::array<float, 8 * 1024> samples;
+        std::size_t filled = 0;
+        GError* error = nullptr;
+        for (;;) {
+            auto n = g_input_stream_read(stream, bytes.data() + filled, bytes.size() - filled, cancellable, &error);
+            if (n <= 0) break;
+            filled += static_cast<std::size_t>(n);
+
+            std::size_t offset = 0;
+            if (!decoder) {
+                auto wav = parse_wav(std::span(bytes).first(filled));
+                // Anything that isn't a WAV file is taken as raw audio
+                decoder.emplace(wav ? wav->sample_rate : default_sample_rate);
+                if (wav) {
+                    channels = wav->channels;
+                    offset = wav->data_offset;
+                }
+            }
+            auto frame_bytes = 2 * channels;
+            auto frames = std::min((filled - offset) / frame_bytes, samples.size());
+            for (std::size_t i = 0; i < frames; ++i) {
+                // The first channel, little endian
+                auto at = offset + i * frame_bytes;
+                samples[i] = static_cast<float>(static_cast<std::int16_t>(bytes[at] | bytes[at + 1] << 8)) / 32768.0f;
+            }
+            {
+                ScopedTimer timer(dsp_time);
+                decoder->feed(std::span(samples).first(frames), on_word);
+            }
+            auto consumed = offset + frames * frame_bytes;
+            std::memmove(bytes.data(), bytes.data() + consumed, filled - consumed);
+            filled -= consumed;
+        }
+        if (error && !g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            g_warning("Unable to read CW audio from %s: %s", source.c_str(), error->message);
+        }
+        g_clear_error(&error);
+        if (decoder && !g_cancellable_is_cancelled(cancellable)) {
+            // End of a file; whatever was being sent is complete
+            decoder->flush(on_word);
+        }
+        g_object_unref(stream);
+        if (recorder) {
+            g_subprocess_force_exit(recorder);
+            g_subprocess_wait(recorder, nullptr, nullptr);
+            g_object_unref(recorder);
+        }
+    }
+
+    void
+    CwIngest::handle_word(std::string_view word)
+    {
+        words.add();
+        auto callsign = cw_callsign(word);
+        if (!callsign) return;
+        auto keys = roster.load();
+        auto match = match_roster_callsign(*callsign, *keys);
+        if (!match) return;
+        auto now = g_get_monotonic_time();
+        if (match->callsign == last_candidate && now - last_candidate_us < repeat_window_us) return;
+        last_candidate = match->callsign;
+        last_candidate_us = now;
+        candidates.add();
+
+        g_idle_add_full(G_PRIORITY_DEFAULT, [](gpointer data) -> gboolean {
+            auto candidate = static_cast<Candidate*>(data);
+            if (auto h = candidate->handler.lock()) {
+                (*h)(candidate->callsign, candidate->exact);
+            }
+            return G_SOURCE_REMOVE;
+        }, new Candidate{ handler, std::string(match->callsign), match->exact }, [](gpointer data) {
+            delete static_cast<Candidate*>(data);
+        });
+    }
+
+} // namespace mnn
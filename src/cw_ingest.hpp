@@ -0,0 +1,85 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gio/gio.h>
+#include "cw_decoder.hpp"
+#include "metrics.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    /* Listens for callsigns sent in CW and suggests the roster station each
+     * most likely is. source is one of
+     *   pulse            the default PulseAudio or PipeWire input, via parec
+     *   pulse:device     a named input, e.g. a monitor of the radio's sink
+     *   a file path      a WAV file, or raw 48 kHz mono s16le from a file or pipe
+     *
+     * Reading and decoding run on a worker thread; only matches reach the
+     * main loop, where on_candidate gets the roster callsign and whether
+     * it was decoded exactly. A callsign repeated within a minute, as
+     * repeaters do, is suggested once. */
+    class CwIngest
+    {
+    public:
+        using CandidateHandler = std::function<void(const std::string& callsign, bool exact)>;
+
+        CwIngest(Net& net, std::string source, CandidateHandler on_candidate);
+        ~CwIngest();
+        CwIngest(const CwIngest&) = delete;
+        CwIngest& operator=(const CwIngest&) = delete;
+
+        void start();
+        void stop();
+
+    private:
+        static void on_items_changed(GListModel*, guint position, guint removed, guint added, gpointer self);
+
+        void update_roster();
+        void run();
+        // recorder is set when audio comes from a child process
+        GInputStream* open_source(GSubprocess*& recorder);
+        void handle_word(std::string_view word);
+
+        Net& net;
+        std::string source;
+        // Main thread only; candidates posted after stop() find it gone
+        std::shared_ptr<CandidateHandler> handler;
+        std::atomic<std::shared_ptr<const std::vector<std::string>>> roster;
+        GCancellable* cancellable = nullptr;
+        std::thread worker;
+        gulong items_changed_id = 0;
+        // Worker only
+        std::string last_candidate;
+        gint64 last_candidate_us = 0;
+
+        Counter& words;
+        Counter& candidates;
+        Histogram& dsp_time;
+    };
+
+} // namespace mnn
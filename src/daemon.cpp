@@ -0,0 +1,98 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <print>
+#include <glib.h>
+#include "daemon_client.hpp"
+#include "net_daemon.hpp"
+#include "net_session.hpp"
+
+/* Headless net state for logging bots, digital mode decoders and scripts.
+ *
+ *   monday-night-net-daemon --net big-net.json
+ *
+ * Clients connect with mnn::DaemonClient (or speak ipc_protocol.hpp
+ * themselves) on $XDG_RUNTIME_DIR/monday-night-net.sock. The GUI joins as
+ * one more client when its daemon-socket setting names the socket. */
+namespace
+{
+    mnn::NetDaemon* running = nullptr;
+
+    extern "C" void
+    on_signal(int)
+    {
+        if (running) running->request_stop();
+    }
+
+} // anonymous namespace
+
+int
+main(int argc, char *argv[])
+{
+    gchar *net_path = nullptr;
+    gchar *socket_path = nullptr;
+
+    GOptionEntry entries[] = {
+        { "net", 'n', 0, G_OPTION_ARG_FILENAME, &net_path, "Net definition to serve", "FILE" },
+        { "socket", 's', 0, G_OPTION_ARG_FILENAME, &socket_path, "Listen here instead of the default socket", "PATH" },
+        G_OPTION_ENTRY_NULL
+    };
+
+    g_autoptr(GOptionContext) context = g_option_context_new("- serve Monday Night Net state over a local socket");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    g_autoptr(GError) error = nullptr;
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        std::println(std::cerr, "{}", error->message);
+        return 1;
+    }
+    if (!net_path) {
+        std::println(std::cerr, "--net is required");
+        return 1;
+    }
+
+    std::ifstream file(net_path);
+    auto json = nlohmann::json::parse(file, nullptr, false);
+    if (!file || json.is_discarded()) {
+        std::println(std::cerr, "Unable to read a net definition from {}", net_path);
+        return 1;
+    }
+    mnn::NetSession session(json);
+    if (session.skipped() > 0) {
+        std::println(std::cerr, "Skipped {} invalid station records", session.skipped());
+    }
+
+    mnn::NetDaemon daemon(session, socket_path ? socket_path : mnn::default_daemon_socket_path());
+    if (auto ec = daemon.listen()) {
+        std::println(std::cerr, "Unable to listen: {}", ec.message());
+        return 1;
+    }
+    running = &daemon;
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+    std::println("Serving {} stations", session.stations().size());
+    daemon.run();
+    running = nullptr;
+
+    g_free(net_path);
+    g_free(socket_path);
+    return 0;
+}
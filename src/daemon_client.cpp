@@ -0,0 +1,175 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "daemon_client.hpp"
+
+namespace mnn
+{
+    std::string
+    default_daemon_socket_path()
+    {
+        if (auto runtime = std::getenv("XDG_RUNTIME_DIR"); runtime && *runtime) {
+            return std::format("{}/monday-night-net.sock", runtime);
+        }
+        return std::format("/tmp/monday-night-net-{}.sock", getuid());
+    }
+
+    DaemonClient::~DaemonClient()
+    {
+        close();
+    }
+
+    void
+    DaemonClient::close()
+    {
+        if (sock >= 0) {
+            ::close(sock);
+            sock = -1;
+        }
+        reader = {};
+        outgoing.clear();
+        outgoing_begin = 0;
+    }
+
+    std::error_code
+    DaemonClient::connect(const std::string& path)
+    {
+        close();
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            return std::make_error_code(std::errc::filename_too_long);
+        }
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        sock = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (sock < 0 || ::connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            auto ec = std::error_code(errno, std::system_category());
+            close();
+            return ec;
+        }
+        return {};
+    }
+
+    std::error_code
+    DaemonClient::write_all(std::span<const std::byte> bytes)
+    {
+        while (!bytes.empty()) {
+            auto n = ::send(sock, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+            if (n < 0) {
+                if (EINTR == errno) continue;
+                if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                    // receive() leaves the socket non-blocking; wait for room
+                    pollfd p{ sock, POLLOUT, 0 };
+                    ::poll(&p, 1, -1);
+                    continue;
+                }
+                return { errno, std::system_category() };
+            }
+            bytes = bytes.subspan(static_cast<std::size_t>(n));
+        }
+        return {};
+    }
+
+    std::error_code
+    DaemonClient::send(std::span<const IpcUpdate> updates)
+    {
+        if (sock < 0) return std::make_error_code(std::errc::not_connected);
+        if (updates.empty()) return {};
+        buffer.clear();
+        encode_updates(FrameKind::REQUEST, updates, buffer);
+        return write_all(buffer);
+    }
+
+    std::error_code
+    DaemonClient::queue(std::span<const IpcUpdate> updates)
+    {
+        if (sock < 0) return std::make_error_code(std::errc::not_connected);
+        if (updates.empty()) return {};
+        encode_updates(FrameKind::REQUEST, updates, outgoing);
+        if (outgoing.size() - outgoing_begin > max_queued_bytes) {
+            return std::make_error_code(std::errc::no_buffer_space);
+        }
+        return flush();
+    }
+
+    std::error_code
+    DaemonClient::flush()
+    {
+        if (sock < 0) return std::make_error_code(std::errc::not_connected);
+        while (outgoing_begin < outgoing.size()) {
+            auto n = ::send(sock, outgoing.data() + outgoing_begin, outgoing.size() - outgoing_begin, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n < 0) {
+                if (EINTR == errno) continue;
+                if (EAGAIN == errno || EWOULDBLOCK == errno) return {};
+                return { errno, std::system_category() };
+            }
+            outgoing_begin += static_cast<std::size_t>(n);
+        }
+        outgoing.clear();
+        outgoing_begin = 0;
+        return {};
+    }
+
+    std::error_code
+    DaemonClient::subscribe()
+    {
+        IpcUpdate u{ .op = IpcOp::SUBSCRIBE };
+        return send(std::span(&u, 1));
+    }
+
+    std::expected<std::vector<Frame>, std::error_code>
+    DaemonClient::receive()
+    {
+        if (sock < 0) return std::unexpected(std::make_error_code(std::errc::not_connected));
+        ::fcntl(sock, F_SETFL, ::fcntl(sock, F_GETFL) | O_NONBLOCK);
+        std::array<std::byte, 64 * 1024> chunk;
+        for (;;) {
+            auto n = ::recv(sock, chunk.data(), chunk.size(), 0);
+            if (n > 0) {
+                reader.feed(std::span(chunk).first(static_cast<std::size_t>(n)));
+                continue;
+            }
+            if (0 == n) {
+                return std::unexpected(std::make_error_code(std::errc::connection_reset));
+            }
+            if (EINTR == errno) continue;
+            if (EAGAIN == errno || EWOULDBLOCK == errno) break;
+            return std::unexpected(std::error_code(errno, std::system_category()));
+        }
+        std::vector<Frame> frames;
+        while (auto frame = reader.next()) {
+            frames.push_back(std::move(*frame));
+        }
+        if (reader.failed()) {
+            return std::unexpected(std::make_error_code(std::errc::protocol_error));
+        }
+        return frames;
+    }
+
+} // namespace mnn
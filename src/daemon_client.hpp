@@ -0,0 +1,78 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <expected>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "ipc_protocol.hpp"
+
+namespace mnn
+{
+    // $XDG_RUNTIME_DIR/monday-night-net.sock, or a per user path in /tmp
+    [[nodiscard]] std::string default_daemon_socket_path();
+
+    /* Client side of the daemon socket for bots, decoders and the GUI.
+     * send() blocks until the frame is written, which suits bots. A main
+     * loop uses queue() instead, which never blocks: whatever the socket
+     * won't take stays buffered until flush() is called once fd() is
+     * writable. receive() never blocks either. */
+    class DaemonClient
+    {
+    public:
+        static constexpr std::size_t max_queued_bytes = 4 * 1024 * 1024;
+
+        DaemonClient() = default;
+        ~DaemonClient();
+        DaemonClient(const DaemonClient&) = delete;
+        DaemonClient& operator=(const DaemonClient&) = delete;
+
+        std::error_code connect(const std::string& path);
+        void close();
+        [[nodiscard]] int fd() const { return sock; }
+
+        // One RESULT frame comes back per 65535 updates
+        std::error_code send(std::span<const IpcUpdate>);
+        /* Writes what the socket takes now and buffers the rest. Fails
+         * with no_buffer_space rather than buffer more than
+         * max_queued_bytes for a daemon that has stopped reading. */
+        std::error_code queue(std::span<const IpcUpdate>);
+        // Writes as much of the queued output as the socket takes
+        std::error_code flush();
+        [[nodiscard]] bool wants_write() const { return !outgoing.empty(); }
+        // Ask for EVENTS frames: current state first, then every change
+        std::error_code subscribe();
+        // Whatever frames are complete; an error once the daemon has gone
+        [[nodiscard]] std::expected<std::vector<Frame>, std::error_code> receive();
+
+    private:
+        std::error_code write_all(std::span<const std::byte>);
+
+        int sock = -1;
+        FrameReader reader;
+        std::vector<std::byte> buffer;
+        // Queued frames not yet taken by the socket, from outgoing_begin on
+        std::vector<std::byte> outgoing;
+        std::size_t outgoing_begin = 0;
+    };
+
+} // namespace mnn
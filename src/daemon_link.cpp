@@ -0,0 +1,197 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <cstring>
+#include <glib-unix.h>
+#include "daemon_link.hpp"
+#include "net_library.hpp"
+#include "replica_state.hpp"
+
+namespace mnn
+{
+    using namespace peel;
+
+    DaemonLink::DaemonLink(Net& net) :
+        net(net)
+    {
+    }
+
+    DaemonLink::~DaemonLink()
+    {
+        disconnect();
+    }
+
+    std::error_code
+    DaemonLink::connect(const std::string& socket_path)
+    {
+        disconnect();
+        if (auto ec = client.connect(socket_path)) {
+            return ec;
+        }
+        if (auto ec = client.subscribe()) {
+            client.close();
+            return ec;
+        }
+        watch.start(net, { "notify::status", "notify::is-acknowledged", "notify::has-location" },
+                    G_CALLBACK(&DaemonLink::on_notify), this);
+        fd_source = g_unix_fd_add(client.fd(), static_cast<GIOCondition>(G_IO_IN | G_IO_HUP | G_IO_ERR), &DaemonLink::on_readable, this);
+        return {};
+    }
+
+    void
+    DaemonLink::disconnect()
+    {
+        watch.stop();
+        if (0 != fd_source) {
+            g_source_remove(fd_source);
+            fd_source = 0;
+        }
+        if (0 != flush_id) {
+            g_source_remove(flush_id);
+            flush_id = 0;
+        }
+        if (0 != write_source) {
+            g_source_remove(write_source);
+            write_source = 0;
+        }
+        pending.clear();
+        client.close();
+    }
+
+    void
+    DaemonLink::on_notify(GObject* object, GParamSpec* pspec, gpointer data)
+    {
+        auto self = static_cast<DaemonLink*>(data);
+        if (self->applying) return;
+        auto station = reinterpret_cast<Station*>(object);
+        IpcUpdate u{ .op = IpcOp::CHECK_IN, .callsign = station->get_callsign() };
+        if (0 == std::strcmp(pspec->name, "status")) {
+            u.value = static_cast<std::uint8_t>(station->get_status());
+        } else if (0 == std::strcmp(pspec->name, "is-acknowledged")) {
+            u.op = IpcOp::ACKNOWLEDGE;
+            u.value = station->is_acknowledged();
+        } else if (station->has_location()) {
+            u.op = IpcOp::LOCATION;
+            u.latitude_udeg = to_microdegrees(station->get_latitude());
+            u.longitude_udeg = to_microdegrees(station->get_longitude());
+        } else {
+            u.op = IpcOp::CLEAR_LOCATION;
+        }
+        self->pending.push_back(std::move(u));
+        if (0 == self->flush_id) {
+            self->flush_id = g_idle_add(&DaemonLink::on_flush, self);
+        }
+    }
+
+    gboolean
+    DaemonLink::on_flush(gpointer data)
+    {
+        auto self = static_cast<DaemonLink*>(data);
+        self->flush_id = 0;
+        auto ec = self->client.queue(self->pending);
+        self->pending.clear();
+        if (ec) {
+            self->lost(ec);
+        } else {
+            self->update_write_source();
+        }
+        return G_SOURCE_REMOVE;
+    }
+
+    gboolean
+    DaemonLink::on_writable(gint, GIOCondition, gpointer data)
+    {
+        auto self = static_cast<DaemonLink*>(data);
+        if (auto ec = self->client.flush()) {
+            self->write_source = 0;
+            self->lost(ec);
+            return G_SOURCE_REMOVE;
+        }
+        if (self->client.wants_write()) return G_SOURCE_CONTINUE;
+        self->write_source = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    void
+    DaemonLink::update_write_source()
+    {
+        if (client.wants_write() && 0 == write_source) {
+            write_source = g_unix_fd_add(client.fd(), G_IO_OUT, &DaemonLink::on_writable, this);
+        }
+    }
+
+    void
+    DaemonLink::lost(std::error_code ec)
+    {
+        g_warning("Lost the net daemon: %s", ec.message().c_str());
+        disconnect();
+    }
+
+    void
+    DaemonLink::apply(const IpcUpdate& u)
+    {
+        auto station = net.find(u.callsign);
+        if (!station) return;
+        switch (u.op) {
+            case IpcOp::CHECK_IN:
+                if (u.value <= static_cast<std::uint8_t>(StationStatus::HEARD_RELAY) &&
+                    station->get_status() != static_cast<StationStatus>(u.value)) {
+                    station->set_status(static_cast<StationStatus>(u.value));
+                }
+                break;
+            case IpcOp::ACKNOWLEDGE:
+                if (station->is_acknowledged() != static_cast<bool>(u.value)) {
+                    station->set_is_acknowledged(u.value);
+                }
+                break;
+            case IpcOp::LOCATION:
+                station->set_location(from_microdegrees(u.latitude_udeg), from_microdegrees(u.longitude_udeg));
+                break;
+            case IpcOp::CLEAR_LOCATION:
+                if (station->has_location()) {
+                    station->set_location(SHUMATE_MIN_LATITUDE, SHUMATE_MIN_LONGITUDE);
+                }
+                break;
+            case IpcOp::SUBSCRIBE:
+                break;
+        }
+    }
+
+    gboolean
+    DaemonLink::on_readable(gint, GIOCondition, gpointer data)
+    {
+        auto self = static_cast<DaemonLink*>(data);
+        auto frames = self->client.receive();
+        if (!frames) {
+            self->fd_source = 0;
+            self->lost(frames.error());
+            return G_SOURCE_REMOVE;
+        }
+        self->applying = true;
+        for (const auto& frame : *frames) {
+            if (FrameKind::EVENTS != frame.kind) continue;
+            for (const auto& u : frame.updates) {
+                self->apply(u);
+            }
+        }
+        self->applying = false;
+        return G_SOURCE_CONTINUE;
+    }
+
+} // namespace mnn
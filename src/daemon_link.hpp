@@ -0,0 +1,74 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <string>
+#include <system_error>
+#include <vector>
+#include <glib.h>
+#include <glib-object.h>
+#include "daemon_client.hpp"
+#include "station.hpp"
+#include "station_watch.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    /* Makes the GUI a client of monday-night-net-daemon: the daemon's
+     * events are applied to the net's Stations, and check-ins logged in
+     * this window are sent to the daemon, batched per main loop iteration.
+     * Sending never blocks the main loop; a daemon that stops reading
+     * long enough to back up DaemonClient::max_queued_bytes is dropped. */
+    class DaemonLink
+    {
+    public:
+        explicit DaemonLink(Net& net);
+        ~DaemonLink();
+        DaemonLink(const DaemonLink&) = delete;
+        DaemonLink& operator=(const DaemonLink&) = delete;
+
+        std::error_code connect(const std::string& socket_path);
+        void disconnect();
+
+    private:
+        static void on_notify(GObject* station, GParamSpec* pspec, gpointer self);
+        static gboolean on_readable(gint fd, GIOCondition condition, gpointer self);
+        static gboolean on_flush(gpointer self);
+        static gboolean on_writable(gint fd, GIOCondition condition, gpointer self);
+
+        // Watches for room in the socket while output is queued
+        void update_write_source();
+        void lost(std::error_code);
+
+        void apply(const IpcUpdate&);
+
+        Net& net;
+        DaemonClient client;
+        StationWatch watch;
+        std::vector<IpcUpdate> pending;
+        // Set while applying daemon events so they aren't sent back
+        bool applying = false;
+        guint fd_source = 0;
+        guint flush_id = 0;
+        guint write_source = 0;
+    };
+
+} // namespace mnn
@@ -0,0 +1,95 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <print>
+#include <glib.h>
+#include "net_generator.hpp"
+
+/* Writes synthetic net definitions and check-in streams for load testing.
+ *
+ *   mnn-generate-net --stations 3000 --itu --net big-net.json \
+ *                    --checkins 3000 --duration 120 --events big-net-events.json
+ *
+ * Point the current-net setting at big-net.json, then start the app with
+ * MNN_REPLAY_EVENTS=big-net-events.json MNN_REPLAY_SPEED=1440 to replay the
+ * two hour exercise in about five seconds. */
+int
+main(int argc, char *argv[])
+{
+    gint stations = 60;
+    gint columns = 4;
+    gboolean itu = FALSE;
+    gint64 seed = 0;
+    gint checkins = 0;
+    gint duration_minutes = 120;
+    gchar *net_path = nullptr;
+    gchar *events_path = nullptr;
+
+    GOptionEntry entries[] = {
+        { "stations", 's', 0, G_OPTION_ARG_INT, &stations, "Number of stations in the roster", "N" },
+        { "columns", 'c', 0, G_OPTION_ARG_INT, &columns, "Number of alphabetical columns", "N" },
+        { "itu", 'i', 0, G_OPTION_ARG_NONE, &itu, "Draw prefixes from all ITU allocations, not just the US", nullptr },
+        { "seed", 0, 0, G_OPTION_ARG_INT64, &seed, "Random seed", "SEED" },
+        { "checkins", 'n', 0, G_OPTION_ARG_INT, &checkins, "Number of check-in events to generate", "N" },
+        { "duration", 'd', 0, G_OPTION_ARG_INT, &duration_minutes, "Length of the net in minutes", "MINUTES" },
+        { "net", 0, 0, G_OPTION_ARG_FILENAME, &net_path, "Write the net definition here (default stdout)", "FILE" },
+        { "events", 0, 0, G_OPTION_ARG_FILENAME, &events_path, "Write check-in events here", "FILE" },
+        G_OPTION_ENTRY_NULL
+    };
+
+    g_autoptr(GOptionContext) context = g_option_context_new("- generate a synthetic Monday Night Net roster");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    g_autoptr(GError) error = nullptr;
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        std::println(std::cerr, "{}", error->message);
+        return 1;
+    }
+
+    mnn::GeneratorOptions opts;
+    opts.station_count = static_cast<std::size_t>(std::max(0, stations));
+    opts.column_count = static_cast<std::size_t>(std::max(1, columns));
+    opts.itu_prefixes = itu;
+    opts.seed = static_cast<std::uint64_t>(seed);
+    auto net = mnn::generate_net(opts);
+
+    if (net_path) {
+        std::ofstream(net_path) << net.dump(2) << '\n';
+    } else {
+        std::cout << net.dump(2) << '\n';
+    }
+
+    if (checkins > 0) {
+        mnn::CheckinOptions checkin_opts;
+        checkin_opts.checkin_count = static_cast<std::size_t>(checkins);
+        checkin_opts.duration = std::chrono::minutes(duration_minutes);
+        checkin_opts.seed = opts.seed;
+        auto events = mnn::checkins_to_json(mnn::generate_checkins(net, checkin_opts));
+        if (events_path) {
+            std::ofstream(events_path) << events.dump() << '\n';
+        } else {
+            std::println(std::cerr, "--checkins given without --events, not writing events");
+        }
+    }
+
+    g_free(net_path);
+    g_free(events_path);
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "gio_async.hpp"
+
+namespace
+{
+    GCancellable*
+    c_cancellable(peel::Gio::Cancellable* c)
+    {
+        return reinterpret_cast<GCancellable*>(c);
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    std::error_code
+    to_error_code(const GError* error)
+    {
+        if (!error) return {};
+        if (error->domain == G_IO_ERROR) {
+            switch (error->code) {
+                case G_IO_ERROR_CANCELLED:         return std::make_error_code(std::errc::operation_canceled);
+                case G_IO_ERROR_NOT_FOUND:         return std::make_error_code(std::errc::no_such_file_or_directory);
+                case G_IO_ERROR_PERMISSION_DENIED: return std::make_error_code(std::errc::permission_denied);
+                case G_IO_ERROR_IS_DIRECTORY:      return std::make_error_code(std::errc::is_a_directory);
+                case G_IO_ERROR_NO_SPACE:          return std::make_error_code(std::errc::no_space_on_device);
+                default: break;
+            }
+        }
+        return std::make_error_code(std::errc::io_error);
+    }
+
+    void
+    ResumeOnMain::await_suspend(std::coroutine_handle<> h)
+    {
+        handle = h;
+        // Runs inline when already on the owner of the main context
+        g_main_context_invoke(nullptr, &ResumeOnMain::on_invoke, this);
+    }
+
+    gboolean
+    ResumeOnMain::on_invoke(gpointer data)
+    {
+        static_cast<ResumeOnMain*>(data)->handle.resume();
+        return G_SOURCE_REMOVE;
+    }
+
+    bool
+    ResumeOnMain::await_resume() const noexcept
+    {
+        return !cancellable || !g_cancellable_is_cancelled(c_cancellable(cancellable));
+    }
+
+    void
+    LoadContents::await_suspend(std::coroutine_handle<> h)
+    {
+        handle = h;
+        auto file = g_file_new_for_path(path.c_str());
+        g_file_load_contents_async(file, c_cancellable(cancellable), &LoadContents::on_loaded, this);
+        g_object_unref(file);
+    }
+
+    void
+    LoadContents::on_loaded(GObject* source, GAsyncResult* res, gpointer data)
+    {
+        auto self = static_cast<LoadContents*>(data);
+        char* contents = nullptr;
+        gsize length = 0;
+        GError* error = nullptr;
+        if (g_file_load_contents_finish(G_FILE(source), res, &contents, &length, nullptr, &error)) {
+            self->result.emplace(contents, length);
+            g_free(contents);
+        } else {
+            self->result = std::unexpected(to_error_code(error));
+            g_error_free(error);
+        }
+        self->handle.resume();
+    }
+
+    void
+    ReplaceContents::await_suspend(std::coroutine_handle<> h)
+    {
+        handle = h;
+        auto file = g_file_new_for_path(path.c_str());
+        // contents lives in the awaiter, which outlives the operation
+        g_file_replace_contents_async(file, contents.data(), contents.size(), nullptr, FALSE,
+                                      G_FILE_CREATE_REPLACE_DESTINATION, c_cancellable(cancellable),
+                                      &ReplaceContents::on_replaced, this);
+        g_object_unref(file);
+    }
+
+    void
+    ReplaceContents::on_replaced(GObject* source, GAsyncResult* res, gpointer data)
+    {
+        auto self = static_cast<ReplaceContents*>(data);
+        GError* error = nullptr;
+        if (!g_file_replace_contents_finish(G_FILE(source), res, nullptr, &error)) {
+            self->result = to_error_code(error);
+            g_error_free(error);
+        }
+        self->handle.resume();
+    }
+
+} // namespace mnn
@@ -0,0 +1,114 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <coroutine>
+#include <expected>
+#include <string>
+#include <system_error>
+#include <gio/gio.h>
+#include <peel/Gio/Gio.h>
+#include "task.hpp"
+
+namespace mnn
+{
+    // GError to error_code: cancellation is std::errc::operation_canceled
+    [[nodiscard]] std::error_code to_error_code(const GError*);
+
+    /* Resumes the awaiting Task on the default GLib main context. Yields
+     * false instead when the cancellable was cancelled meanwhile; the
+     * caller must then not touch whatever owns the cancellable.
+     *
+     *     co_await thread_pool().schedule();
+     *     auto result = expensive();
+     *     if (!co_await resume_on_main(cancellable)) co_return;
+     *     widget->show(result);
+     */
+    class [[nodiscard]] ResumeOnMain
+    {
+    public:
+        explicit ResumeOnMain(peel::Gio::Cancellable* cancellable) noexcept : cancellable(cancellable) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>);
+        bool await_resume() const noexcept;
+
+    private:
+        static gboolean on_invoke(gpointer self);
+
+        peel::Gio::Cancellable* cancellable;
+        std::coroutine_handle<> handle;
+    };
+
+    [[nodiscard]] inline ResumeOnMain resume_on_main(peel::Gio::Cancellable* cancellable = nullptr) noexcept { return ResumeOnMain{ cancellable }; }
+
+    /* The whole file via g_file_load_contents_async(). Must be awaited on
+     * the main context; it resumes there. */
+    class [[nodiscard]] LoadContents
+    {
+    public:
+        LoadContents(std::string path, peel::Gio::Cancellable* cancellable) noexcept :
+            path(std::move(path)), cancellable(cancellable) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>);
+        std::expected<std::string, std::error_code> await_resume() { return std::move(result); }
+
+    private:
+        static void on_loaded(GObject*, GAsyncResult*, gpointer self);
+
+        std::string path;
+        peel::Gio::Cancellable* cancellable;
+        std::coroutine_handle<> handle;
+        std::expected<std::string, std::error_code> result;
+    };
+
+    [[nodiscard]] inline LoadContents load_contents(std::string path, peel::Gio::Cancellable* cancellable = nullptr) { return { std::move(path), cancellable }; }
+
+    /* Writes the file via g_file_replace_contents_async(), which goes
+     * through a temporary and a rename. Must be awaited on the main
+     * context; it resumes there. */
+    class [[nodiscard]] ReplaceContents
+    {
+    public:
+        ReplaceContents(std::string path, std::string contents, peel::Gio::Cancellable* cancellable) noexcept :
+            path(std::move(path)), contents(std::move(contents)), cancellable(cancellable) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>);
+        std::error_code await_resume() const noexcept { return result; }
+
+    private:
+        static void on_replaced(GObject*, GAsyncResult*, gpointer self);
+
+        std::string path;
+        std::string contents;
+        peel::Gio::Cancellable* cancellable;
+        std::coroutine_handle<> handle;
+        std::error_code result;
+    };
+
+    [[nodiscard]] inline ReplaceContents
+    replace_contents(std::string path, std::string contents, peel::Gio::Cancellable* cancellable = nullptr)
+    {
+        return { std::move(path), std::move(contents), cancellable };
+    }
+
+} // namespace mnn
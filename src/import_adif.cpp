@@ -0,0 +1,111 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <print>
+#include <glib.h>
+#include "adif.hpp"
+#include "net_generator.hpp"
+
+/* Seeds a net definition from years of ADIF net logs.
+ *
+ *   mnn-import-adif --net club-net.json logs/2019.adi logs/2020.adi ...
+ *
+ * Stations already in --net keep their entries; new callsigns are added
+ * with the name and grid of their latest QSO. Without an existing --net
+ * file a fresh four column definition is started. */
+int
+main(int argc, char *argv[])
+{
+    gchar *net_path = nullptr;
+    gchar *output_path = nullptr;
+
+    GOptionEntry entries[] = {
+        { "net", 'n', 0, G_OPTION_ARG_FILENAME, &net_path, "Net definition to merge into", "FILE" },
+        { "output", 'o', 0, G_OPTION_ARG_FILENAME, &output_path, "Write here instead of back to --net", "FILE" },
+        G_OPTION_ENTRY_NULL
+    };
+
+    g_autoptr(GOptionContext) context = g_option_context_new("LOG.adi... - seed a roster from ADIF logs");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    g_autoptr(GError) error = nullptr;
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        std::println(std::cerr, "{}", error->message);
+        return 1;
+    }
+    if (!net_path || argc < 2) {
+        std::println(std::cerr, "--net and at least one log are required");
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    mnn::AdifAggregator aggregator;
+    mnn::AdifReader reader([&aggregator](std::span<const mnn::AdifField> record) { aggregator.add(record); });
+    constexpr std::size_t chunk_size = 1 << 20;
+    auto buffer = std::make_unique<char[]>(chunk_size);
+    std::size_t bytes = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream log(argv[i], std::ios::binary);
+        if (!log) {
+            std::println(std::cerr, "Unable to read {}", argv[i]);
+            return 1;
+        }
+        while (log.read(buffer.get(), chunk_size) || log.gcount() > 0) {
+            reader.feed({ buffer.get(), static_cast<std::size_t>(log.gcount()) });
+            bytes += static_cast<std::size_t>(log.gcount());
+        }
+        // Each file ends its own records
+        reader.finish();
+    }
+    auto summary = std::move(aggregator).finish();
+
+    nlohmann::json net;
+    if (std::ifstream existing(net_path); existing) {
+        net = nlohmann::json::parse(existing, nullptr, false);
+        if (net.is_discarded()) {
+            std::println(std::cerr, "Unable to parse {}", net_path);
+            return 1;
+        }
+    } else {
+        net = mnn::generate_net({ .station_count = 0 });
+        net["meta"]["location"] = "Imported";
+    }
+    mnn::merge_adif(net, summary);
+    // Written beside the target and renamed over it, so a failed write leaves the roster as it was
+    auto out = net.dump(2) + '\n';
+    auto target = output_path ? output_path : net_path;
+    if (!g_file_set_contents(target, out.data(), static_cast<gssize>(out.size()), &error)) {
+        std::println(std::cerr, "Unable to write {}: {}", target, error->message);
+        return 1;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::println("Read {} QSOs ({} MiB) in {}: {} stations, {} records without a valid call",
+                 summary.records, bytes >> 20, elapsed, summary.stations.size(), summary.skipped);
+    if (reader.dropped_bytes() > 0) {
+        std::println(std::cerr, "Dropped {} bytes of incomplete records", reader.dropped_bytes());
+    }
+
+    g_free(net_path);
+    g_free(output_path);
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <print>
+#include <glib.h>
+#include "uls.hpp"
+
+/* Builds the offline licensee index the window uses to fill in names.
+ *
+ *   curl -O https://data.fcc.gov/download/pub/uls/complete/l_amat.zip
+ *   unzip l_amat.zip EN.dat HD.dat AM.dat -d l_amat
+ *   mnn-import-uls --dir l_amat
+ *
+ * The index lands in the user data directory unless --output says
+ * otherwise; point the uls-index-path setting at it if you move it. */
+int
+main(int argc, char *argv[])
+{
+    gchar *dir = nullptr;
+    gchar *output = nullptr;
+    gint threads = 0;
+
+    GOptionEntry entries[] = {
+        { "dir", 'd', 0, G_OPTION_ARG_FILENAME, &dir, "Directory holding EN.dat, HD.dat and AM.dat", "DIR" },
+        { "output", 'o', 0, G_OPTION_ARG_FILENAME, &output, "Where to write the index", "FILE" },
+        { "threads", 'j', 0, G_OPTION_ARG_INT, &threads, "Parser threads (default: one per core)", "N" },
+        G_OPTION_ENTRY_NULL
+    };
+
+    g_autoptr(GOptionContext) context = g_option_context_new("- build a callsign index from the FCC ULS amateur dump");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    g_autoptr(GError) error = nullptr;
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        std::println(std::cerr, "{}", error->message);
+        return 1;
+    }
+    if (!dir) {
+        std::println(std::cerr, "--dir is required");
+        return 1;
+    }
+
+    std::filesystem::path out = output ? std::filesystem::path(output) : mnn::default_uls_index_path();
+    std::error_code ec;
+    std::filesystem::create_directories(out.parent_path(), ec);
+
+    auto start = std::chrono::steady_clock::now();
+    auto count = mnn::build_uls_index(dir, out, static_cast<unsigned>(std::max(threads, 0)));
+    if (!count) {
+        std::println(std::cerr, "Unable to build {}: {}", out.string(), count.error().message());
+        return 1;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::println("Indexed {} active licensees into {} in {}", *count, out.string(), elapsed);
+
+    g_free(dir);
+    g_free(output);
+    return 0;
+}
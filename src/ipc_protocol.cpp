@@ -0,0 +1,185 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include "ipc_protocol.hpp"
+
+namespace
+{
+    template<typename T>
+    void
+    put(std::vector<std::byte>& out, T v)
+    {
+        auto u = static_cast<std::make_unsigned_t<T>>(v);
+        for (auto i = 0UZ; i < sizeof(T); ++i) {
+            out.push_back(static_cast<std::byte>(u >> (8 * i)));
+        }
+    }
+
+    template<typename T>
+    T
+    get(const std::byte* p)
+    {
+        std::make_unsigned_t<T> u = 0;
+        for (auto i = 0UZ; i < sizeof(T); ++i) {
+            u |= static_cast<std::make_unsigned_t<T>>(std::to_integer<unsigned>(p[i])) << (8 * i);
+        }
+        return static_cast<T>(u);
+    }
+
+    bool
+    decode_update(std::span<const std::byte>& in, mnn::IpcUpdate& u)
+    {
+        if (in.size() < 2) return false;
+        u.op = static_cast<mnn::IpcOp>(in[0]);
+        auto length = std::to_integer<std::size_t>(in[1]);
+        in = in.subspan(2);
+        if (in.size() < length) return false;
+        u.callsign.assign(reinterpret_cast<const char*>(in.data()), length);
+        in = in.subspan(length);
+        switch (u.op) {
+            case mnn::IpcOp::CHECK_IN:
+            case mnn::IpcOp::ACKNOWLEDGE:
+                if (in.empty()) return false;
+                u.value = std::to_integer<std::uint8_t>(in[0]);
+                in = in.subspan(1);
+                return true;
+            case mnn::IpcOp::LOCATION:
+                if (in.size() < 8) return false;
+                u.latitude_udeg = get<std::int32_t>(in.data());
+                u.longitude_udeg = get<std::int32_t>(in.data() + 4);
+                in = in.subspan(8);
+                return true;
+            case mnn::IpcOp::CLEAR_LOCATION:
+            case mnn::IpcOp::SUBSCRIBE:
+                return true;
+        }
+        return false;
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    void
+    encode_updates(FrameKind kind, std::span<const IpcUpdate> updates, std::vector<std::byte>& out)
+    {
+        do {
+            auto chunk = updates.first(std::min(updates.size(), max_updates_per_frame));
+            updates = updates.subspan(chunk.size());
+
+            auto header = out.size();
+            put<std::uint32_t>(out, 0);
+            out.push_back(static_cast<std::byte>(kind));
+            put<std::uint16_t>(out, static_cast<std::uint16_t>(chunk.size()));
+            for (const auto& u : chunk) {
+                auto callsign = std::string_view(u.callsign).substr(0, 255);
+                out.push_back(static_cast<std::byte>(u.op));
+                out.push_back(static_cast<std::byte>(callsign.size()));
+                auto bytes = std::as_bytes(std::span(callsign));
+                out.insert(out.end(), bytes.begin(), bytes.end());
+                switch (u.op) {
+                    case IpcOp::CHECK_IN:
+                    case IpcOp::ACKNOWLEDGE:
+                        out.push_back(static_cast<std::byte>(u.value));
+                        break;
+                    case IpcOp::LOCATION:
+                        put(out, u.latitude_udeg);
+                        put(out, u.longitude_udeg);
+                        break;
+                    case IpcOp::CLEAR_LOCATION:
+                    case IpcOp::SUBSCRIBE:
+                        break;
+                }
+            }
+            auto length = static_cast<std::uint32_t>(out.size() - header - 4);
+            for (auto i = 0; i < 4; ++i) {
+                out[header + i] = static_cast<std::byte>(length >> (8 * i));
+            }
+        } while (!updates.empty());
+    }
+
+    void
+    encode_result(const IpcResult& r, std::vector<std::byte>& out)
+    {
+        put<std::uint32_t>(out, 13);
+        out.push_back(static_cast<std::byte>(FrameKind::RESULT));
+        put(out, r.applied);
+        put(out, r.unknown);
+        put(out, r.malformed);
+    }
+
+    void
+    FrameReader::feed(std::span<const std::byte> bytes)
+    {
+        // Compact lazily so a stream of small frames doesn't memmove each time
+        if (consumed > 0 && consumed >= buffer.size() / 2) {
+            buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(consumed));
+            consumed = 0;
+        }
+        buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+    }
+
+    std::optional<Frame>
+    FrameReader::next()
+    {
+        if (broken) return std::nullopt;
+        std::span<const std::byte> avail(buffer.data() + consumed, buffer.size() - consumed);
+        if (avail.size() < 5) return std::nullopt;
+        auto length = get<std::uint32_t>(avail.data());
+        if (length < 1 || length > max_frame_size) {
+            broken = true;
+            return std::nullopt;
+        }
+        if (avail.size() < 4UZ + length) return std::nullopt;
+
+        auto body = avail.subspan(5, length - 1);
+        Frame frame{ .kind = static_cast<FrameKind>(avail[4]) };
+        consumed += 4 + length;
+        switch (frame.kind) {
+            case FrameKind::RESULT:
+                if (body.size() < 12) break;
+                frame.result = { get<std::uint32_t>(body.data()),
+                                 get<std::uint32_t>(body.data() + 4),
+                                 get<std::uint32_t>(body.data() + 8) };
+                return frame;
+            case FrameKind::REQUEST:
+            case FrameKind::EVENTS: {
+                if (body.size() < 2) break;
+                auto count = get<std::uint16_t>(body.data());
+                body = body.subspan(2);
+                frame.updates.resize(count);
+                for (auto i = 0UZ; i < count; ++i) {
+                    if (!decode_update(body, frame.updates[i])) {
+                        // Keep what parsed; the rest of the frame is counted as malformed
+                        frame.result.malformed = static_cast<std::uint32_t>(count - i);
+                        frame.updates.resize(i);
+                        break;
+                    }
+                }
+                return frame;
+            }
+        }
+        broken = true;
+        return std::nullopt;
+    }
+
+} // namespace mnn
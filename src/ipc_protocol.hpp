@@ -0,0 +1,110 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace mnn
+{
+    /* Framing for the daemon's local socket. Everything is little endian:
+     *
+     *   frame:  u32 body length, u8 kind, body
+     *   REQUEST and EVENTS bodies: u16 count, then count updates
+     *   update: u8 op, u8 callsign length, callsign, then by op
+     *           CHECK_IN      u8 status
+     *           ACKNOWLEDGE   u8 0 or 1
+     *           LOCATION      i32 latitude, i32 longitude in microdegrees
+     *           CLEAR_LOCATION, SUBSCRIBE: nothing (SUBSCRIBE has no callsign)
+     *   RESULT body: u32 applied, u32 unknown callsign, u32 malformed
+     *
+     * Clients send REQUEST frames and get one RESULT back for each.
+     * Subscribers are also sent EVENTS frames, which use the same update
+     * records, starting with the current state of every station that isn't
+     * pending. Batching thousands of updates per frame is what makes high
+     * rates cheap; there is no per-update round trip. */
+    enum class FrameKind : std::uint8_t
+    {
+        REQUEST = 1,
+        RESULT = 2,
+        EVENTS = 3,
+    };
+
+    enum class IpcOp : std::uint8_t
+    {
+        CHECK_IN = 1,
+        ACKNOWLEDGE = 2,
+        LOCATION = 3,
+        CLEAR_LOCATION = 4,
+        SUBSCRIBE = 5,
+    };
+
+    struct IpcUpdate
+    {
+        IpcOp op;
+        std::string callsign;
+        std::uint8_t value = 0;
+        std::int32_t latitude_udeg = 0;
+        std::int32_t longitude_udeg = 0;
+    };
+
+    struct IpcResult
+    {
+        std::uint32_t applied = 0;
+        std::uint32_t unknown = 0;
+        std::uint32_t malformed = 0;
+    };
+
+    struct Frame
+    {
+        FrameKind kind;
+        std::vector<IpcUpdate> updates;
+        IpcResult result;
+    };
+
+    inline constexpr std::size_t max_updates_per_frame = 0xffff;
+    // Larger frames are a protocol error and drop the connection
+    inline constexpr std::size_t max_frame_size = 4 * 1024 * 1024;
+
+    // Appends one frame per max_updates_per_frame updates
+    void encode_updates(FrameKind, std::span<const IpcUpdate>, std::vector<std::byte>& out);
+    void encode_result(const IpcResult&, std::vector<std::byte>& out);
+
+    /* Reassembles frames from a byte stream. feed() what the socket gave
+     * you, then call next() until it returns nothing. */
+    class FrameReader
+    {
+    public:
+        void feed(std::span<const std::byte>);
+        // nullopt when more bytes are needed; check failed() to tell a broken stream apart
+        [[nodiscard]] std::optional<Frame> next();
+        [[nodiscard]] bool failed() const { return broken; }
+
+    private:
+        std::vector<std::byte> buffer;
+        std::size_t consumed = 0;
+        bool broken = false;
+    };
+
+} // namespace mnn
@@ -0,0 +1,254 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <bit>
+#include <cmath>
+#include <format>
+#include <ranges>
+#include "metrics.hpp"
+
+namespace
+{
+    // Prometheus' default buckets, which dashboards already know
+    constexpr std::array exposition_bounds = { 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0 };
+
+    std::string
+    render_labels(const mnn::MetricLabels& labels)
+    {
+        if (labels.empty()) return {};
+        std::string out = "{";
+        for (const auto& [key, value] : labels) {
+            if (out.size() > 1) out += ',';
+            out += key;
+            out += "=\"";
+            for (auto c : value) {
+                if ('\\' == c || '"' == c) out += '\\';
+                if ('\n' == c) {
+                    out += "\\n";
+                    continue;
+                }
+                out += c;
+            }
+            out += '"';
+        }
+        out += '}';
+        return out;
+    }
+
+    // Adds one more label to an already rendered set
+    std::string
+    with_label(std::string_view labels, std::string_view extra)
+    {
+        if (labels.empty()) return std::format("{{{}}}", extra);
+        return std::format("{},{}}}", labels.substr(0, labels.size() - 1), extra);
+    }
+
+    double
+    seconds(std::uint64_t ns)
+    {
+        return static_cast<double>(ns) / 1e9;
+    }
+
+    std::string
+    human(std::uint64_t ns)
+    {
+        if (ns < 10'000) return std::format("{} ns", ns);
+        if (ns < 10'000'000) return std::format("{:.1f} us", static_cast<double>(ns) / 1e3);
+        if (ns < 10'000'000'000) return std::format("{:.1f} ms", static_cast<double>(ns) / 1e6);
+        return std::format("{:.1f} s", seconds(ns));
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    std::size_t
+    Histogram::bucket_index(std::uint64_t value) noexcept
+    {
+        if (value < 2 * sub_count) return static_cast<std::size_t>(value);
+        auto exponent = static_cast<std::size_t>(std::bit_width(value)) - 1;
+        auto mantissa = static_cast<std::size_t>(value >> (exponent - sub_bits));
+        return 2 * sub_count + (exponent - sub_bits - 1) * sub_count + (mantissa - sub_count);
+    }
+
+    std::uint64_t
+    Histogram::bucket_upper_bound(std::size_t index) noexcept
+    {
+        if (index < 2 * sub_count) return index;
+        auto exponent = (index - 2 * sub_count) / sub_count + sub_bits + 1;
+        auto mantissa = (index - 2 * sub_count) % sub_count + sub_count;
+        auto shift = exponent - sub_bits;
+        return ((static_cast<std::uint64_t>(mantissa) + 1) << shift) - 1;
+    }
+
+    void
+    Histogram::record(std::uint64_t nanoseconds) noexcept
+    {
+        buckets[bucket_index(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+        auto seen = max.load(std::memory_order_relaxed);
+        while (nanoseconds > seen && !max.compare_exchange_weak(seen, nanoseconds, std::memory_order_relaxed)) {}
+    }
+
+    Histogram::Snapshot
+    Histogram::snapshot() const
+    {
+        Snapshot s;
+        s.buckets.reserve(bucket_count);
+        for (const auto& b : buckets) {
+            s.buckets.push_back(b.load(std::memory_order_relaxed));
+        }
+        // Derived from the buckets so the counts always agree with each other
+        for (auto b : s.buckets) s.count += b;
+        s.sum = sum.load(std::memory_order_relaxed);
+        s.max = max.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    std::uint64_t
+    Histogram::Snapshot::percentile(double q) const noexcept
+    {
+        if (0 == count) return 0;
+        auto rank = static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count)));
+        std::uint64_t seen = 0;
+        for (auto i = 0UZ; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= std::max<std::uint64_t>(rank, 1)) {
+                return std::min(bucket_upper_bound(i), max);
+            }
+        }
+        return max;
+    }
+
+    std::uint64_t
+    Histogram::Snapshot::count_at_or_below(std::uint64_t value) const noexcept
+    {
+        std::uint64_t n = 0;
+        for (auto i = 0UZ; i < buckets.size() && bucket_upper_bound(i) <= value; ++i) {
+            n += buckets[i];
+        }
+        return n;
+    }
+
+    MetricsRegistry::Entry&
+    MetricsRegistry::find_or_add(std::string_view name, std::string_view help, Kind kind, const MetricLabels& labels)
+    {
+        auto rendered = render_labels(labels);
+        std::lock_guard lock(mutex);
+        for (auto& e : entries) {
+            if (e.name == name && e.labels == rendered && e.kind == kind) return e;
+        }
+        auto& e = entries.emplace_back(Entry{ .name = std::string(name), .help = std::string(help), .kind = kind, .labels = std::move(rendered) });
+        switch (kind) {
+            case Kind::COUNTER:   e.counter = std::make_unique<Counter>(); break;
+            case Kind::GAUGE:     e.gauge = std::make_unique<Gauge>(); break;
+            case Kind::HISTOGRAM: e.histogram = std::make_unique<Histogram>(); break;
+        }
+        return e;
+    }
+
+    Counter&
+    MetricsRegistry::counter(std::string_view name, std::string_view help, MetricLabels labels)
+    {
+        return *find_or_add(name, help, Kind::COUNTER, labels).counter;
+    }
+
+    Gauge&
+    MetricsRegistry::gauge(std::string_view name, std::string_view help, MetricLabels labels)
+    {
+        return *find_or_add(name, help, Kind::GAUGE, labels).gauge;
+    }
+
+    Histogram&
+    MetricsRegistry::histogram(std::string_view name, std::string_view help, MetricLabels labels)
+    {
+        return *find_or_add(name, help, Kind::HISTOGRAM, labels).histogram;
+    }
+
+    std::string
+    MetricsRegistry::render_openmetrics() const
+    {
+        std::lock_guard lock(mutex);
+        std::string out;
+        std::vector<std::string_view> families;
+        for (const auto& e : entries) {
+            if (std::ranges::find(families, e.name) != families.end()) continue;
+            families.push_back(e.name);
+
+            constexpr std::array type_names = { "counter", "gauge", "histogram" };
+            out += std::format("# TYPE {} {}\n# HELP {} {}\n", e.name, type_names[static_cast<std::size_t>(e.kind)], e.name, e.help);
+            for (const auto& m : entries | std::views::filter([&e](const Entry& x) { return x.name == e.name; })) {
+                switch (m.kind) {
+                    case Kind::COUNTER:
+                        out += std::format("{}_total{} {}\n", m.name, m.labels, m.counter->get());
+                        break;
+                    case Kind::GAUGE:
+                        out += std::format("{}{} {}\n", m.name, m.labels, m.gauge->get());
+                        break;
+                    case Kind::HISTOGRAM: {
+                        auto s = m.histogram->snapshot();
+                        for (auto bound : exposition_bounds) {
+                            auto ns = static_cast<std::uint64_t>(bound * 1e9);
+                            out += std::format("{}_bucket{} {}\n", m.name, with_label(m.labels, std::format("le=\"{}\"", bound)), s.count_at_or_below(ns));
+                        }
+                        out += std::format("{}_bucket{} {}\n", m.name, with_label(m.labels, "le=\"+Inf\""), s.count);
+                        out += std::format("{}_count{} {}\n", m.name, m.labels, s.count);
+                        out += std::format("{}_sum{} {}\n", m.name, m.labels, seconds(s.sum));
+                        break;
+                    }
+                }
+            }
+        }
+        out += "# EOF\n";
+        return out;
+    }
+
+    std::string
+    MetricsRegistry::render_summary() const
+    {
+        std::lock_guard lock(mutex);
+        std::string out;
+        for (const auto& e : entries) {
+            switch (e.kind) {
+                case Kind::COUNTER:
+                    out += std::format("{}{}  {}\n", e.name, e.labels, e.counter->get());
+                    break;
+                case Kind::GAUGE:
+                    out += std::format("{}{}  {}\n", e.name, e.labels, e.gauge->get());
+                    break;
+                case Kind::HISTOGRAM: {
+                    auto s = e.histogram->snapshot();
+                    out += std::format("{}{}  n={} p50={} p90={} p99={} max={}\n", e.name, e.labels, s.count,
+                                       human(s.percentile(0.5)), human(s.percentile(0.9)), human(s.percentile(0.99)), human(s.max));
+                    break;
+                }
+            }
+        }
+        return out;
+    }
+
+    MetricsRegistry&
+    metrics()
+    {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+} // namespace mnn
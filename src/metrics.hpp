@@ -0,0 +1,151 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mnn
+{
+    class Counter
+    {
+    public:
+        void add(std::uint64_t n = 1) noexcept { value.fetch_add(n, std::memory_order_relaxed); }
+        [[nodiscard]] std::uint64_t get() const noexcept { return value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<std::uint64_t> value = 0;
+    };
+
+    class Gauge
+    {
+    public:
+        void set(std::int64_t v) noexcept { value.store(v, std::memory_order_relaxed); }
+        void add(std::int64_t n) noexcept { value.fetch_add(n, std::memory_order_relaxed); }
+        [[nodiscard]] std::int64_t get() const noexcept { return value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<std::int64_t> value = 0;
+    };
+
+    /* Log-linear (HDR style) histogram of nanosecond durations: exact below
+     * 64 ns, then 32 buckets per power of two, so any recorded value is
+     * known to within about 3% from 64 ns to centuries. Recording is a
+     * few relaxed atomic adds and never allocates or locks. */
+    class Histogram
+    {
+    public:
+        static constexpr std::size_t sub_bits = 5;
+        static constexpr std::size_t sub_count = 1 << sub_bits;
+        static constexpr std::size_t bucket_count = 2 * sub_count + (64 - sub_bits - 1) * sub_count;
+
+        struct Snapshot
+        {
+            std::vector<std::uint64_t> buckets;
+            std::uint64_t count = 0;
+            std::uint64_t sum = 0;
+            std::uint64_t max = 0;
+
+            // Upper bound of the bucket holding quantile q in [0, 1]
+            [[nodiscard]] std::uint64_t percentile(double q) const noexcept;
+            // Observations no larger than value, to bucket resolution
+            [[nodiscard]] std::uint64_t count_at_or_below(std::uint64_t value) const noexcept;
+        };
+
+        [[nodiscard]] static std::size_t bucket_index(std::uint64_t value) noexcept;
+        [[nodiscard]] static std::uint64_t bucket_upper_bound(std::size_t index) noexcept;
+
+        void record(std::uint64_t nanoseconds) noexcept;
+        void record(std::chrono::nanoseconds d) noexcept { record(static_cast<std::uint64_t>(std::max<std::int64_t>(0, d.count()))); }
+        [[nodiscard]] Snapshot snapshot() const;
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+        std::atomic<std::uint64_t> count = 0;
+        std::atomic<std::uint64_t> sum = 0;
+        std::atomic<std::uint64_t> max = 0;
+    };
+
+    // Records the lifetime of the scope
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(Histogram& h) : histogram(h), start(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() { histogram.record(std::chrono::steady_clock::now() - start); }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Histogram& histogram;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+    /* Named metrics for the whole process. Looking one up takes a lock, so
+     * callers do it once and keep the reference; updating it never does.
+     * Asking again with the same name and labels returns the same metric. */
+    class MetricsRegistry
+    {
+    public:
+        // Counter family names leave off _total; it's added on output
+        Counter& counter(std::string_view name, std::string_view help, MetricLabels labels = {});
+        Gauge& gauge(std::string_view name, std::string_view help, MetricLabels labels = {});
+        // Exposed in seconds
+        Histogram& histogram(std::string_view name, std::string_view help, MetricLabels labels = {});
+
+        // OpenMetrics text exposition, terminated by # EOF
+        [[nodiscard]] std::string render_openmetrics() const;
+        // One line per metric with histogram percentiles, for people
+        [[nodiscard]] std::string render_summary() const;
+
+    private:
+        enum class Kind { COUNTER, GAUGE, HISTOGRAM };
+        struct Entry
+        {
+            std::string name;
+            std::string help;
+            Kind kind;
+            // Rendered as {a="b",c="d"}, or empty
+            std::string labels;
+            std::unique_ptr<Counter> counter;
+            std::unique_ptr<Gauge> gauge;
+            std::unique_ptr<Histogram> histogram;
+        };
+
+        Entry& find_or_add(std::string_view name, std::string_view help, Kind, const MetricLabels&);
+
+        mutable std::mutex mutex;
+        std::deque<Entry> entries;
+    };
+
+    [[nodiscard]] MetricsRegistry& metrics();
+
+} // namespace mnn
@@ -0,0 +1,157 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "metrics.hpp"
+#include "metrics_server.hpp"
+
+namespace
+{
+    // A scraper that hasn't sent its request by now isn't going to
+    constexpr int request_timeout_ms = 2000;
+
+    void
+    send_all(int fd, std::string_view data)
+    {
+        while (!data.empty()) {
+            auto n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+            if (n < 0) {
+                if (EINTR == errno) continue;
+                if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                    pollfd p{ fd, POLLOUT, 0 };
+                    if (::poll(&p, 1, request_timeout_ms) > 0) continue;
+                }
+                return;
+            }
+            data.remove_prefix(static_cast<std::size_t>(n));
+        }
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    MetricsServer::MetricsServer(const MetricsRegistry& registry) :
+        registry(registry)
+    {
+    }
+
+    MetricsServer::~MetricsServer()
+    {
+        stop();
+    }
+
+    std::error_code
+    MetricsServer::start(std::uint16_t port)
+    {
+        stop();
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int one = 1;
+        if (listen_fd < 0 ||
+            ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) < 0 ||
+            ::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            ::listen(listen_fd, 8) < 0 ||
+            ::pipe2(wake_fds, O_NONBLOCK | O_CLOEXEC) < 0) {
+            std::error_code ec{ errno, std::system_category() };
+            stop();
+            return ec;
+        }
+        socklen_t len = sizeof(addr);
+        ::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        bound_port = ntohs(addr.sin_port);
+        thread = std::jthread([this](std::stop_token token) { run(token); });
+        return {};
+    }
+
+    void
+    MetricsServer::stop()
+    {
+        if (thread.joinable()) {
+            thread.request_stop();
+            [[maybe_unused]] auto n = ::write(wake_fds[1], "x", 1);
+            thread.join();
+        }
+        for (auto& fd : { &listen_fd, &wake_fds[0], &wake_fds[1] }) {
+            if (*fd >= 0) ::close(*fd);
+            *fd = -1;
+        }
+    }
+
+    void
+    MetricsServer::run(std::stop_token token)
+    {
+        while (!token.stop_requested()) {
+            pollfd fds[] = { { wake_fds[0], POLLIN, 0 }, { listen_fd, POLLIN, 0 } };
+            if (::poll(fds, 2, -1) < 0) {
+                if (EINTR == errno) continue;
+                return;
+            }
+            if (fds[1].revents & POLLIN) {
+                while (!token.stop_requested()) {
+                    auto fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (fd < 0) break;
+                    serve(fd);
+                    ::close(fd);
+                }
+            }
+        }
+    }
+
+    void
+    MetricsServer::serve(int fd)
+    {
+        std::string request;
+        char buf[2048];
+        while (std::string::npos == request.find("\r\n\r\n") && request.size() < 8192) {
+            pollfd p{ fd, POLLIN, 0 };
+            if (::poll(&p, 1, request_timeout_ms) <= 0) return;
+            auto n = ::recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                if (n < 0 && (EINTR == errno || EAGAIN == errno)) continue;
+                return;
+            }
+            request.append(buf, static_cast<std::size_t>(n));
+        }
+
+        std::string_view line(request);
+        line = line.substr(0, line.find("\r\n"));
+        if (line.starts_with("GET /metrics ") || line.starts_with("GET /metrics?")) {
+            auto body = registry.render_openmetrics();
+            send_all(fd, "HTTP/1.1 200 OK\r\nContent-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                         "Content-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n");
+            send_all(fd, body);
+        } else {
+            send_all(fd, "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\nContent-Length: 13\r\n"
+                         "Connection: close\r\n\r\nTry /metrics\n");
+        }
+    }
+
+} // namespace mnn
@@ -0,0 +1,59 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <system_error>
+#include <thread>
+
+namespace mnn
+{
+    class MetricsRegistry;
+
+    /* Serves GET /metrics from a registry in OpenMetrics text format, for
+     * Prometheus or curl. Listens on loopback only: the numbers say a lot
+     * about the operator's machine and nothing a served agency needs.
+     * Scrapes are handled one at a time on a thread of its own. */
+    class MetricsServer
+    {
+    public:
+        explicit MetricsServer(const MetricsRegistry&);
+        ~MetricsServer();
+        MetricsServer(const MetricsServer&) = delete;
+        MetricsServer& operator=(const MetricsServer&) = delete;
+
+        // Port 0 picks a free one; see port()
+        std::error_code start(std::uint16_t port);
+        void stop();
+
+        [[nodiscard]] std::uint16_t port() const { return bound_port; }
+
+    private:
+        void run(std::stop_token);
+        void serve(int fd);
+
+        const MetricsRegistry& registry;
+        int listen_fd = -1;
+        int wake_fds[2] = { -1, -1 };
+        std::uint16_t bound_port = 0;
+        std::jthread thread;
+    };
+
+} // namespace mnn
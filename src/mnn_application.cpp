@@ -19,10 +19,21 @@
 
 #include "mnn_application.hpp"
 #include "mnn_application_window.hpp"
+#include "metrics.hpp"
 #include "mnn.hpp"
 #include "config.hpp"
+#include "power_monitor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string_view>
 #include <print>
 
+namespace
+{
+    constexpr guint heartbeat_interval_ms = 50;
+
+} // anonymous namespace
+
 namespace mnn
 {
     using namespace peel;
@@ -32,16 +43,175 @@ namespace mnn
     void
     Application::init(Class *)
     {
+        new (&m) Members;
+        m.net_library = std::make_unique<NetLibrary>();
+
         RefPtr<Gio::SimpleAction> action = Gio::SimpleAction::create ("quit", nullptr);
         action->connect_activate (this, &Application::action_quit);
         cast<Gio::ActionMap> ()->add_action (action);
         set_accels_for_action ("app.quit", (const char *[]) { "<Ctrl>Q", nullptr });
+
+        RefPtr<Gio::SimpleAction> new_window = Gio::SimpleAction::create ("new-window", nullptr);
+        new_window->connect_activate (this, &Application::action_new_window);
+        cast<Gio::ActionMap> ()->add_action (new_window);
+        set_accels_for_action ("app.new-window", (const char *[]) { "<Ctrl><Shift>N", nullptr });
+    }
+
+    void
+    Application::vfunc_startup()
+    {
+        parent_vfunc_startup<Application>();
+
+        // Only the primary instance gets here; a second launch just forwards its activation
+        PowerMonitor::install();
+
+        m.settings = Gio::Settings::create("radio.ki6kvz.MondayNightNet.State");
+        g_signal_connect(static_cast<Gio::Settings*>(m.settings), "changed::low-power-mode",
+                         G_CALLBACK(&Application::on_low_power_setting_changed), this);
+        m.power_profile = g_power_profile_monitor_dup_default();
+        if (m.power_profile) {
+            g_signal_connect(m.power_profile, "notify::power-saver-enabled", G_CALLBACK(&Application::on_power_saver_changed), this);
+        }
+        // Starts the heartbeat unless we launch in low power mode
+        update_power_mode();
+
+        if (auto port = m.settings->get_int("metrics-port"); port > 0) {
+            m.metrics_server = std::make_unique<MetricsServer>(metrics());
+            if (auto ec = m.metrics_server->start(static_cast<std::uint16_t>(port))) {
+                g_warning("Unable to serve metrics on port %d: %s", port, ec.message().c_str());
+                m.metrics_server.reset();
+            }
+        }
+    }
+
+    void
+    Application::vfunc_shutdown()
+    {
+        m.metrics_server.reset();
+        stop_heartbeat();
+        if (m.power_profile) {
+            g_signal_handlers_disconnect_by_data(m.power_profile, this);
+            g_clear_object(&m.power_profile);
+        }
+        if (m.settings) {
+            g_signal_handlers_disconnect_by_data(static_cast<Gio::Settings*>(m.settings), this);
+        }
+        parent_vfunc_shutdown<Application>();
+    }
+
+    gboolean
+    Application::on_heartbeat(gpointer data)
+    {
+        // How late the main loop got round to us is how long it was busy elsewhere
+        static auto& stalls = metrics().histogram("mnn_main_loop_stall_seconds", "How late a 50 ms main loop heartbeat fired");
+        auto self = static_cast<Application*>(data);
+        auto now = g_get_monotonic_time();
+        stalls.record(std::chrono::microseconds(std::max<gint64>(0, now - self->m.heartbeat_due_us)));
+        self->m.heartbeat_due_us = now + heartbeat_interval_ms * 1000;
+        return G_SOURCE_CONTINUE;
+    }
+
+    void
+    Application::start_heartbeat()
+    {
+        if (0 != m.heartbeat_id) return;
+        m.heartbeat_due_us = g_get_monotonic_time() + heartbeat_interval_ms * 1000;
+        m.heartbeat_id = g_timeout_add(heartbeat_interval_ms, &Application::on_heartbeat, this);
+    }
+
+    void
+    Application::stop_heartbeat()
+    {
+        if (0 == m.heartbeat_id) return;
+        g_source_remove(m.heartbeat_id);
+        m.heartbeat_id = 0;
+    }
+
+    void
+    Application::on_low_power_setting_changed(GSettings*, const char*, gpointer data)
+    {
+        static_cast<Application*>(data)->update_power_mode();
+    }
+
+    void
+    Application::on_power_saver_changed(::GObject*, GParamSpec*, gpointer data)
+    {
+        static_cast<Application*>(data)->update_power_mode();
+    }
+
+    void
+    Application::update_power_mode()
+    {
+        auto mode = m.settings->get_string("low-power-mode");
+        std::string_view setting = static_cast<const char*>(mode);
+        bool low_power = "on" == setting
+            || ("auto" == setting && m.power_profile && g_power_profile_monitor_get_power_saver_enabled(m.power_profile));
+        bool changed = low_power != m.low_power;
+        m.low_power = low_power;
+
+        // The heartbeat alone is 20 wakeups a second
+        if (low_power) {
+            stop_heartbeat();
+        } else {
+            start_heartbeat();
+        }
+        // Caught up whenever out of step, in case there was no display yet on an earlier call
+        if (auto gtk_settings = gtk_settings_get_default(); gtk_settings && low_power != m.cursor_blink_off) {
+            // A blinking cursor is a redraw every half second while an entry has focus
+            if (low_power) {
+                g_object_set(gtk_settings, "gtk-cursor-blink", FALSE, nullptr);
+            } else {
+                gtk_settings_reset_property(gtk_settings, "gtk-cursor-blink");
+            }
+            m.cursor_blink_off = low_power;
+        }
+        if (!changed) return;
+        for (auto l = gtk_application_get_windows(GTK_APPLICATION(this)); l; l = l->next) {
+            // Print dialogs land in this list too
+            if (G_TYPE_CHECK_INSTANCE_TYPE(l->data, Type::of<ApplicationWindow>())) {
+                static_cast<ApplicationWindow*>(l->data)->set_low_power(low_power);
+            }
+        }
     }
 
     void
     Application::Class::init()
     {
+        override_vfunc_startup<Application>();
+        override_vfunc_shutdown<Application>();
         override_vfunc_activate<Application>();
+        override_vfunc_finalize<Application>();
+    }
+
+    void
+    Application::vfunc_finalize()
+    {
+        m.~Members();
+        parent_vfunc_finalize<Application>();
+    }
+
+    NetLibrary&
+    Application::get_net_library()
+    {
+        return *m.net_library;
+    }
+
+    const UlsIndex*
+    Application::get_uls_index()
+    {
+        if (!m.uls_index_tried) {
+            m.uls_index_tried = true;
+            auto settings = Gio::Settings::create("radio.ki6kvz.MondayNightNet.State");
+            auto setting = settings->get_string("uls-index-path");
+            auto configured = static_cast<const char*>(setting);
+            std::filesystem::path path = configured && *configured ? std::filesystem::path(configured) : default_uls_index_path();
+            if (auto index = UlsIndex::open(path)) {
+                m.uls_index.emplace(std::move(*index));
+            } else if (configured && *configured) {
+                g_warning("Unable to open the ULS index %s: %s", path.c_str(), index.error().message().c_str());
+            }
+        }
+        return m.uls_index ? &*m.uls_index : nullptr;
     }
 
     void
@@ -50,6 +220,7 @@ namespace mnn
         parent_vfunc_activate<Application> ();
 
         ApplicationWindow *window = ApplicationWindow::create (this);
+        window->set_low_power (m.low_power);
         window->present ();
     }
 
@@ -59,11 +230,23 @@ namespace mnn
         quit();
     }
 
+    void
+    Application::action_new_window(Gio::SimpleAction *, GLib::Variant *)
+    {
+        // A second operator display; it shares the nets of the first
+        ApplicationWindow *window = ApplicationWindow::create (this);
+        window->set_low_power (m.low_power);
+        window->present ();
+    }
+
     RefPtr<Application>
     Application::create()
     {
         return Object::create<Application>(prop_application_id(),
                                            APP_ID,
+                                           // Devel builds have their own id but the same resources, style.css included
+                                           prop_resource_base_path(),
+                                           "/radio/ki6kvz/MondayNightNet",
                                            prop_flags(),
                                            Gio::Application::Flags::DEFAULT_FLAGS);
     }
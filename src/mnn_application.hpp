@@ -22,6 +22,11 @@
 #include <peel/Gio/Gio.h>
 #include <peel/GLib/GLib.h>
 #include <peel/class.h>
+#include <memory>
+#include <optional>
+#include "metrics_server.hpp"
+#include "net_library.hpp"
+#include "uls.hpp"
 
 namespace mnn
 {
@@ -31,10 +36,46 @@ namespace mnn
         friend class peel::Gio::Application;
 
         void init(Class *);
+        void vfunc_startup();
+        void vfunc_shutdown();
         void vfunc_activate();
+        void vfunc_finalize();
         void action_quit(peel::Gio::SimpleAction *, peel::GLib::Variant *);
+        void action_new_window(peel::Gio::SimpleAction *, peel::GLib::Variant *);
+
+        struct Members {
+            std::unique_ptr<NetLibrary> net_library;
+            std::optional<UlsIndex> uls_index;
+            bool uls_index_tried = false;
+            std::unique_ptr<MetricsServer> metrics_server;
+            guint heartbeat_id = 0;
+            gint64 heartbeat_due_us = 0;
+            peel::RefPtr<peel::Gio::Settings> settings;
+            GPowerProfileMonitor* power_profile = nullptr;
+            bool low_power = false;
+            // Whether gtk-cursor-blink is currently forced off
+            bool cursor_blink_off = false;
+        } m;
+
+        static gboolean on_heartbeat(gpointer self);
+        static void on_low_power_setting_changed(GSettings*, const char* key, gpointer self);
+        static void on_power_saver_changed(::GObject*, GParamSpec*, gpointer self);
+
+        void start_heartbeat();
+        void stop_heartbeat();
+        // Reads the low-power-mode setting and the system power saver
+        void update_power_mode();
 
     public:
+        // Shared by every window, so a net is only parsed once
+        [[nodiscard]] NetLibrary& get_net_library();
+        // Mapped on first use; nullptr when mnn-import-uls hasn't been run
+        [[nodiscard]] const UlsIndex* get_uls_index();
+        /* Fewer main loop wakeups for running on a battery: no stall
+         * heartbeat, no cursor blink, and windows batch redraws and
+         * autosaves (see ApplicationWindow::set_low_power()). */
+        [[nodiscard]] bool is_low_power() const { return m.low_power; }
+
         [[nodiscard]] static peel::RefPtr<Application> create();
     };
 
@@ -16,13 +16,131 @@
   along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "gio_async.hpp"
 #include "mnn.hpp"
+#include "mnn_application.hpp"
 #include "mnn_application_window.hpp"
+#include "metrics.hpp"
+#include "mnn_error.hpp"
+#include "power_monitor.hpp"
+#include "replica_state.hpp"
+#include "roster_import.hpp"
+#include "roster_sheet.hpp"
 #include "station.hpp"
+#include "station_history.hpp"
+#include "thread_pool.hpp"
 #include <glib/gi18n.h>
+#include <cairo-pdf.h>
 #include <peel/widget-template.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <optional>
 #include <ranges>
 
+namespace
+{
+    using namespace std::literals;
+
+    // roster-sort setting values, indexed by RosterSort like the sort dropdown
+    constexpr std::array sort_names = { "suffix"sv, "callsign"sv, "name"sv, "status"sv, "distance"sv };
+
+    // Low power mode: how often queued station updates are applied, and the shortest autosave period
+    constexpr auto low_power_update_interval = std::chrono::milliseconds(250);
+    constexpr auto low_power_autosave_interval = std::chrono::seconds(60);
+
+    struct DiagnosticsView
+    {
+        GtkLabel* label;
+        mnn::PowerMonitor power;
+    };
+
+    // Rates need a whole refresh interval behind them, so the first render has none
+    std::string
+    render_diagnostics(std::optional<mnn::PowerMonitor::Rates> rates)
+    {
+        auto power = rates ? std::format("Main loop wakeups/s {:.1f}  CPU {:.1f}%", rates->wakeups_per_second, rates->cpu_percent)
+                           : "Main loop wakeups/s -  CPU -"s;
+        return std::format("{}\n\n{}", power, mnn::metrics().render_summary());
+    }
+
+    // The save dialog doesn't say which filter was picked, so go by the name
+    mnn::ExportFormat
+    export_format_for(std::string_view basename)
+    {
+        if (basename.ends_with(".adi"sv) || basename.ends_with(".adif"sv)) return mnn::ExportFormat::ADIF;
+        if (basename.ends_with(".txt"sv)) return mnn::ExportFormat::ICS309;
+        return mnn::ExportFormat::CSV;
+    }
+
+    struct ExportProgress
+    {
+        GtkProgressBar* bar;
+        double fraction;
+    };
+
+    // Any thread; the bar is only touched from the main loop
+    void
+    post_export_progress(GtkProgressBar* bar, std::size_t done, std::size_t total)
+    {
+        auto update = new ExportProgress{ GTK_PROGRESS_BAR(g_object_ref(bar)), total ? static_cast<double>(done) / static_cast<double>(total) : 1.0 };
+        g_idle_add_full(G_PRIORITY_DEFAULT, [](gpointer data) -> gboolean {
+            auto update = static_cast<ExportProgress*>(data);
+            gtk_progress_bar_set_fraction(update->bar, update->fraction);
+            return G_SOURCE_REMOVE;
+        }, update, [](gpointer data) {
+            auto update = static_cast<ExportProgress*>(data);
+            g_object_unref(update->bar);
+            delete update;
+        });
+    }
+
+    // GTK only prints from the main loop, one draw-page per page
+    struct SheetPrintJob
+    {
+        mnn::SheetData data;
+        std::unique_ptr<mnn::SheetRenderer> renderer;
+
+        static void
+        on_begin_print(GtkPrintOperation* op, GtkPrintContext* context, gpointer self)
+        {
+            auto job = static_cast<SheetPrintJob*>(self);
+            auto pango = gtk_print_context_create_pango_context(context);
+            job->renderer = std::make_unique<mnn::SheetRenderer>(std::move(job->data), pango,
+                                                                 gtk_print_context_get_width(context),
+                                                                 gtk_print_context_get_height(context));
+            g_object_unref(pango);
+            gtk_print_operation_set_n_pages(op, static_cast<gint>(job->renderer->page_count()));
+        }
+
+        static void
+        on_draw_page(GtkPrintOperation*, GtkPrintContext* context, gint page, gpointer self)
+        {
+            auto job = static_cast<SheetPrintJob*>(self);
+            job->renderer->draw_page(gtk_print_context_get_cairo_context(context), static_cast<std::size_t>(page));
+        }
+    };
+
+    struct PdfStream
+    {
+        GOutputStream* out;
+        GCancellable* cancel;
+        GError** error;
+    };
+
+    cairo_status_t
+    write_pdf(void* closure, const unsigned char* data, unsigned int length)
+    {
+        auto stream = static_cast<PdfStream*>(closure);
+        if (*stream->error) return CAIRO_STATUS_WRITE_ERROR;
+        return g_output_stream_write_all(stream->out, data, length, nullptr, stream->cancel, stream->error)
+            ? CAIRO_STATUS_SUCCESS : CAIRO_STATUS_WRITE_ERROR;
+    }
+
+} // anonymous namespace
+
 namespace mnn
 {
     using namespace peel;
@@ -33,9 +151,20 @@ namespace mnn
     void
     ApplicationWindow::vfunc_dispose()
     {
+        // Loads still in flight must not come back to us
+        m.cancellable->cancel();
         // Popovers need to be unparented
         m.date_entry_popover->unparent();
         m.date_entry_popover = nullptr;
+        m.replay.reset();
+        m.autosave.reset();
+        m.history.reset();
+        m.cw.reset();
+        if (m.net) {
+            m.net->updates->detach(reinterpret_cast<GtkWidget*>(this));
+        }
+        // The library keeps the net cached for the next window
+        m.net.reset();
 
         dispose_template(Type::of<ApplicationWindow> ());
         parent_vfunc_dispose<ApplicationWindow> ();
@@ -55,16 +184,72 @@ namespace mnn
 
         add_binding_action (GDK_KEY_T, Gdk::ModifierType::CONTROL_MASK, "win.new-tab", nullptr);
         */
+        install_action ("win.switch-net", "s", [] (Gtk::Widget *widget, const char *, GLib::Variant *parameter)
+        {
+            widget->cast<ApplicationWindow> ()->open_net (parameter->get_string (nullptr));
+        });
+        install_action ("win.show-metrics", nullptr, [] (Gtk::Widget *widget, const char *, GLib::Variant *)
+        {
+            widget->cast<ApplicationWindow> ()->show_metrics ();
+        });
+        add_binding_action (GDK_KEY_M, Gdk::ModifierType::CONTROL_MASK | Gdk::ModifierType::SHIFT_MASK, "win.show-metrics", nullptr);
+        install_action ("win.find", nullptr, [] (Gtk::Widget *widget, const char *, GLib::Variant *)
+        {
+            widget->cast<ApplicationWindow> ()->m.search_bar->set_search_mode(true);
+        });
+        add_binding_action (GDK_KEY_F, Gdk::ModifierType::CONTROL_MASK, "win.find", nullptr);
+        install_action ("win.export", nullptr, [] (Gtk::Widget *widget, const char *, GLib::Variant *)
+        {
+            widget->cast<ApplicationWindow> ()->choose_export_file ();
+        });
+        add_binding_action (GDK_KEY_E, Gdk::ModifierType::CONTROL_MASK, "win.export", nullptr);
+        install_action ("win.save-sheet", nullptr, [] (Gtk::Widget *widget, const char *, GLib::Variant *)
+        {
+            widget->cast<ApplicationWindow> ()->choose_sheet_file ();
+        });
+        add_binding_action (GDK_KEY_P, Gdk::ModifierType::CONTROL_MASK | Gdk::ModifierType::SHIFT_MASK, "win.save-sheet", nullptr);
+        install_action ("win.print", nullptr, [] (Gtk::Widget *widget, const char *, GLib::Variant *)
+        {
+            widget->cast<ApplicationWindow> ()->print_sheet ();
+        });
+        add_binding_action (GDK_KEY_P, Gdk::ModifierType::CONTROL_MASK, "win.print", nullptr);
+        install_action ("win.undo", nullptr, [] (Gtk::Widget *widget, const char *, GLib::Variant *)
+        {
+            widget->cast<ApplicationWindow> ()->undo ();
+        });
+        add_binding_action (GDK_KEY_Z, Gdk::ModifierType::CONTROL_MASK, "win.undo", nullptr);
+        install_action ("win.redo", nullptr, [] (Gtk::Widget *widget, const char *, GLib::Variant *)
+        {
+            widget->cast<ApplicationWindow> ()->redo ();
+        });
+        add_binding_action (GDK_KEY_Z, Gdk::ModifierType::CONTROL_MASK | Gdk::ModifierType::SHIFT_MASK, "win.redo", nullptr);
+        install_action ("win.check-in", "s", [] (Gtk::Widget *widget, const char *, GLib::Variant *parameter)
+        {
+            widget->cast<ApplicationWindow> ()->check_in (parameter->get_string (nullptr));
+        });
+        install_action ("win.reset-checkins", nullptr, [] (Gtk::Widget *widget, const char *, GLib::Variant *)
+        {
+            widget->cast<ApplicationWindow> ()->reset_checkins ();
+        });
         set_template_from_resource("/radio/ki6kvz/MondayNightNet/mnn-app-window.ui");
 
         PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.date_entry, "date-entry");
         PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.date_entry_popover, "date-entry-popover");
         PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.date_entry_calendar, "date-entry-calendar");
         PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.frequency_entry, "frequency-entry");
-        PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.columns_flowbox, "columns-flowbox");
+        PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.callsign_entry, "callsign-entry");
+        PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.name_entry, "name-entry");
+        PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.sort_dropdown, "sort-dropdown");
+        PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.search_bar, "search-bar");
+        PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.export_progress, "export-progress");
+        PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.roster_grid, "roster-grid");
         PEEL_WIDGET_TEMPLATE_BIND_CHILD (ApplicationWindow, m.toast_overlay, "toast-overlay");
         PEEL_WIDGET_TEMPLATE_BIND_CALLBACK (ApplicationWindow, on_calendar_day_selected);
         PEEL_WIDGET_TEMPLATE_BIND_CALLBACK (ApplicationWindow, on_date_entry_icon_pressed);
+        PEEL_WIDGET_TEMPLATE_BIND_CALLBACK (ApplicationWindow, on_callsign_entry_changed);
+        PEEL_WIDGET_TEMPLATE_BIND_CALLBACK (ApplicationWindow, on_callsign_entry_activate);
+        PEEL_WIDGET_TEMPLATE_BIND_CALLBACK (ApplicationWindow, on_sort_changed);
+        PEEL_WIDGET_TEMPLATE_BIND_CALLBACK (ApplicationWindow, on_search_changed);
     }
 
     void
@@ -72,87 +257,677 @@ namespace mnn
     {
         new (&m) Members;
         init_template();
+        m.cancellable = Gio::Cancellable::create();
         m.settings = Gio::Settings::create("radio.ki6kvz.MondayNightNet.State");
         m.settings->bind("width", this, "default-width", Gio::Settings::BindFlags::DEFAULT);
         m.settings->bind("height", this, "default-height", Gio::Settings::BindFlags::DEFAULT);
         m.settings->bind("is-maximized", this, "maximized", Gio::Settings::BindFlags::DEFAULT);
         m.settings->bind("is-fullscreen", this, "fullscreened", Gio::Settings::BindFlags::DEFAULT);
+        auto sort = m.settings->get_string("roster-sort");
+        auto saved = std::ranges::find(sort_names, std::string_view(static_cast<const char*>(sort)));
+        m.sort_dropdown->set_selected(static_cast<guint>(saved != sort_names.end() ? saved - sort_names.begin() : 0));
+        on_calendar_day_selected(m.date_entry_calendar);
+        update_history_actions();
+    }
+
+    void
+    ApplicationWindow::open_net(std::string_view id)
+    {
+        spawn(open_net_async(std::string(id)));
+    }
+
+    Task<bool>
+    ApplicationWindow::open_net_async(std::string id)
+    {
+        auto app = get_application();
+        if (!app) co_return false;
+        if (auto net = app->cast<Application>()->get_net_library().find(id)) {
+            show_net(std::move(net));
+            co_return true;
+        }
+
+        // The frame's own reference; once we are disposed it is all that is left to look at
+        RefPtr<Gio::Cancellable> cancellable = m.cancellable;
+        auto cancel = static_cast<Gio::Cancellable*>(cancellable);
+        std::optional<std::string> contents;
+        if (!id.empty() && "default-net.json" != id) {
+            auto loaded = co_await load_contents(id, cancel);
+            if (cancel->is_cancelled()) co_return false;
+            if (!loaded) {
+                report_net_error(std::make_error_code(error::unreadable_net));
+                co_return false;
+            }
+            contents = std::move(*loaded);
+        }
+
+        // Parsing and building a large roster is the slow part
+        co_await thread_pool().schedule();
+        auto net = load_net(id, contents);
+        if (!co_await resume_on_main(cancel)) co_return false;
 
-        auto net = m.settings->get_string("current-net");
-        if (!net || net == "default-net.json") {
-            auto json = mnn::get_default_net();
-            setup_net(json);
-            on_calendar_day_selected(m.date_entry_calendar);
+        app = get_application();
+        if (!net || !app) {
+            if (!net) report_net_error(net.error());
+            co_return false;
         }
+        show_net(app->cast<Application>()->get_net_library().adopt(std::move(*net)));
+        co_return true;
     }
 
     void
-    ApplicationWindow::on_date_entry_icon_pressed(Gtk::Entry*, Gtk::Entry::IconPosition pos)
+    ApplicationWindow::show_net(std::shared_ptr<Net> net)
     {
-        if (Gtk::Entry::IconPosition::SECONDARY == pos) {
-            m.date_entry_popover->popup();
+        m.settings->set_string("current-net", net->id.c_str());
+        set_net(std::move(net));
+    }
+
+    void
+    ApplicationWindow::report_net_error(std::error_code ec)
+    {
+        const char* msg = _("Unable to open the net definition");
+        if (std::make_error_code(error::invalid_net_version) == ec) {
+            msg = _("Invalid Net Definition provided. no meta or version invalid");
+        } else if (std::make_error_code(error::missing_columns) == ec) {
+            msg = _("Invalid Net Definition provided: No columns defined");
+        } else if (std::make_error_code(error::no_valid_columns) == ec) {
+            msg = _("Invalid Net Definition provided: No valid columns (need begin and end)");
+        }
+        m.toast_overlay->add_toast(Adw::Toast::create(msg));
+    }
+
+    Task<void>
+    ApplicationWindow::startup(std::string id)
+    {
+        if (co_await open_net_async(std::move(id))) {
+            start_replay_from_env();
         }
     }
 
     void
-    ApplicationWindow::on_calendar_day_selected(Gtk::Calendar* cal)
+    ApplicationWindow::set_net(std::shared_ptr<Net> net)
     {
-        auto date = cal->get_date();
-        auto str = date->format("%F");
-        m.date_entry->get_buffer()->set_text(str, -1);
+        if (net == m.net) return;
+        m.replay.reset();
+        m.autosave.reset();
+        m.history.reset();
+        m.cw.reset();
+        if (m.net) {
+            m.net->updates->detach(reinterpret_cast<GtkWidget*>(this));
+        }
+        m.net = std::move(net);
+        m.net->updates->attach(reinterpret_cast<GtkWidget*>(this));
+        start_autosave();
+        apply_power_mode();
+        m.history = std::make_unique<StationHistory>(*m.net);
+        m.history->set_changed_callback([this] { update_history_actions(); });
+        update_history_actions();
+        auto cw_source = m.settings->get_string("cw-source");
+        if (auto source = static_cast<const char*>(cw_source); source && *source) {
+            m.cw = std::make_unique<CwIngest>(*m.net, source, [this](const std::string& callsign, bool exact) {
+                suggest_check_in(callsign, exact);
+            });
+            m.cw->start();
+        }
+
+        if (!m.net->replicator && m.settings->get_boolean("replication-enabled")) {
+            auto group = m.settings->get_string("replication-group");
+            ReplicationOptions options{ .group = static_cast<const char*>(group),
+                                        .port = static_cast<std::uint16_t>(m.settings->get_int("replication-port")) };
+            m.net->replicator = std::make_unique<NetReplicator>(*m.net, std::move(options));
+            if (m.net->replicator->start()) {
+                m.net->replicator.reset();
+                m.toast_overlay->add_toast(Adw::Toast::create(_("Unable to start replication, check-ins stay local")));
+            }
+        }
+        auto socket = m.settings->get_string("daemon-socket");
+        if (auto path = static_cast<const char*>(socket); !m.net->daemon_link && path && *path) {
+            m.net->daemon_link = std::make_unique<DaemonLink>(*m.net);
+            if (auto ec = m.net->daemon_link->connect(path)) {
+                g_warning("Unable to connect to the net daemon: %s", ec.message().c_str());
+                m.net->daemon_link.reset();
+                m.toast_overlay->add_toast(Adw::Toast::create(_("Unable to reach the net daemon")));
+            }
+        }
+        auto aprs_source = m.settings->get_string("aprs-source");
+        if (auto source = static_cast<const char*>(aprs_source); !m.net->aprs && source && *source) {
+            m.net->aprs = std::make_unique<AprsIngest>(*m.net, source);
+            m.net->aprs->start();
+        }
+
+        if (!m.net->status_board && m.settings->get_boolean("status-board-enabled")) {
+            auto address = m.settings->get_string("status-board-address");
+            StatusBoardOptions options{ .address = static_cast<const char*>(address),
+                                        .port = static_cast<std::uint16_t>(m.settings->get_int("status-board-port")) };
+            m.net->status_board = std::make_unique<StatusBoardLink>(*m.net, std::move(options));
+            if (auto ec = m.net->status_board->start()) {
+                g_warning("Unable to start the status board: %s", ec.message().c_str());
+                m.net->status_board.reset();
+                m.toast_overlay->add_toast(Adw::Toast::create(_("Unable to start the status board")));
+            }
+        }
+
+        if (!m.net->diagnostics.empty()) {
+            constexpr auto max_logged = 50UZ;
+            for (const auto& d : m.net->diagnostics | std::views::take(max_logged)) {
+                g_warning("Skipped station %s", format_diagnostic(d).c_str());
+            }
+            if (m.net->diagnostics.size() > max_logged) {
+                g_warning("... and %zu more invalid station records", m.net->diagnostics.size() - max_logged);
+            }
+            auto loaded = m.net->by_callsign.size();
+            auto skipped = m.net->diagnostics.size();
+            auto msg = std::vformat(_("Loaded {} stations, skipped {} invalid records"), std::make_format_args(loaded, skipped));
+            m.toast_overlay->add_toast(Adw::Toast::create(msg.c_str()));
+        }
+        m.roster_grid->set_net(*m.net);
     }
 
     void
-    ApplicationWindow::setup_net(const nlohmann::json& j)
+    ApplicationWindow::start_autosave()
     {
-        if (!j.contains("meta") || !j["meta"].contains("version") || 1 != j["meta"]["version"])
-        {
-            auto toast = Adw::Toast::create(_("Invalid Net Definition provided. no meta or version invalid"));
-            m.toast_overlay->add_toast(toast);
-            return;
+        auto interval = m.settings->get_int("autosave-interval");
+        if (interval <= 0) return;
+        m.autosave = std::make_unique<Autosave>(*m.net, Autosave::default_path(m.net->id), std::chrono::seconds(interval),
+                                                [this] { return read_session(); });
+    }
+
+    void
+    ApplicationWindow::set_low_power(bool low_power)
+    {
+        if (low_power == m.low_power) return;
+        m.low_power = low_power;
+        apply_power_mode();
+    }
+
+    void
+    ApplicationWindow::apply_power_mode()
+    {
+        if (!m.net) return;
+        m.net->updates->set_min_interval(m.low_power ? low_power_update_interval : std::chrono::milliseconds(0));
+        if (m.autosave) {
+            std::chrono::seconds interval(m.settings->get_int("autosave-interval"));
+            // Fewer, larger writes; a crash costs at most a minute of check-ins
+            m.autosave->set_interval(m.low_power ? std::max(interval, low_power_autosave_interval) : interval);
         }
-        if (!j.contains("columns")) {
-            auto toast = Adw::Toast::create(_("Invalid Net Definition provided: No columns defined"));
-            m.toast_overlay->add_toast(toast);
-            return;
+    }
+
+    void
+    ApplicationWindow::update_history_actions()
+    {
+        auto widget = reinterpret_cast<GtkWidget*>(this);
+        gtk_widget_action_set_enabled(widget, "win.undo", m.history && m.history->can_undo());
+        gtk_widget_action_set_enabled(widget, "win.redo", m.history && m.history->can_redo());
+    }
+
+    void
+    ApplicationWindow::undo()
+    {
+        if (m.history && m.history->undo() > 1) {
+            m.toast_overlay->add_toast(Adw::Toast::create(_("Restored the previous check-ins")));
+        }
+    }
+
+    void
+    ApplicationWindow::redo()
+    {
+        if (m.history) {
+            (void) m.history->redo();
+        }
+    }
+
+    void
+    ApplicationWindow::reset_checkins()
+    {
+        if (!m.history) return;
+        m.history->reset_all();
+        auto toast = Adw::Toast::create(_("Check-ins reset"));
+        toast->set_button_label(_("Undo"));
+        toast->set_action_name("win.undo");
+        m.toast_overlay->add_toast(std::move(toast));
+    }
+
+    void
+    ApplicationWindow::check_in(std::string_view callsign)
+    {
+        if (!m.net || !m.history) return;
+        if (auto station = m.net->find(callsign)) {
+            m.history->set_status(station, StationStatus::HEARD_DIRECT);
         }
-        auto valid_col = [](const auto& j) { return j.contains("begin") && j.contains("end"); };
-        auto vol_view = std::views::filter(j["columns"], valid_col);
-        if (0UZ == std::ranges::distance(vol_view)) {
-            auto toast = Adw::Toast::create(_("Invalid Net Definition provided: No valid columns (need begin and end)"));
-            m.toast_overlay->add_toast(toast);
+    }
+
+    void
+    ApplicationWindow::suggest_check_in(const std::string& callsign, bool exact)
+    {
+        auto station = m.net ? m.net->find(callsign) : nullptr;
+        // Already in; an ID repeats more often than anyone checks in
+        if (!station || StationStatus::PENDING != station->get_status()) return;
+        // Never checks anyone in itself; Enter or the toast button does
+        if (0 == m.callsign_entry->get_buffer()->get_length()) {
+            m.callsign_entry->get_buffer()->set_text(callsign.c_str(), -1);
+        }
+        auto msg = exact
+            ? std::vformat(_("Heard {} in CW"), std::make_format_args(callsign))
+            : std::vformat(_("Heard {} in CW, or close to it"), std::make_format_args(callsign));
+        auto toast = Adw::Toast::create(msg.c_str());
+        toast->set_button_label(_("Check In"));
+        auto action = std::format("win.check-in::{}", callsign);
+        toast->set_detailed_action_name(action.c_str());
+        m.toast_overlay->add_toast(std::move(toast));
+    }
+
+    SessionInfo
+    ApplicationWindow::read_session() const
+    {
+        auto text = [](Gtk::Entry* entry) { return std::string(entry->get_buffer()->get_text()); };
+        return { .net_id = m.net ? m.net->id : std::string(),
+                 .date = text(m.date_entry),
+                 .frequency = text(m.frequency_entry),
+                 .control_callsign = text(m.callsign_entry),
+                 .control_name = text(m.name_entry) };
+    }
+
+    void
+    ApplicationWindow::choose_export_file()
+    {
+        if (!m.net) return;
+        auto dialog = gtk_file_dialog_new();
+        gtk_file_dialog_set_title(dialog, _("Export Net Log"));
+        gtk_file_dialog_set_initial_name(dialog, "net-log.csv");
+        auto filters = g_list_store_new(GTK_TYPE_FILE_FILTER);
+        auto add_filter = [filters](const char* name, const char* pattern) {
+            auto filter = gtk_file_filter_new();
+            gtk_file_filter_set_name(filter, name);
+            gtk_file_filter_add_pattern(filter, pattern);
+            g_list_store_append(filters, filter);
+            g_object_unref(filter);
+        };
+        add_filter(_("CSV (*.csv)"), "*.csv");
+        add_filter(_("ADIF (*.adi)"), "*.adi");
+        add_filter(_("ICS 309 Communications Log (*.txt)"), "*.txt");
+        gtk_file_dialog_set_filters(dialog, G_LIST_MODEL(filters));
+        g_object_unref(filters);
+        gtk_file_dialog_save(dialog, GTK_WINDOW(this), G_CANCELLABLE(static_cast<Gio::Cancellable*>(m.cancellable)),
+                             &ApplicationWindow::on_export_file_chosen, this);
+        g_object_unref(dialog);
+    }
+
+    void
+    ApplicationWindow::on_export_file_chosen(::GObject* dialog, GAsyncResult* result, gpointer data)
+    {
+        GError* error = nullptr;
+        auto file = gtk_file_dialog_save_finish(GTK_FILE_DIALOG(dialog), result, &error);
+        if (!file) {
+            // Dismissed, or the window went away and cancelled it
+            g_error_free(error);
             return;
         }
-        auto store = Gio::ListStore::create(Type::of<Station>());
-        for (const auto& s : j["stations"]) {
-            auto station = Station::create(s);
-            store->append(station);
+        auto self = static_cast<ApplicationWindow*>(data);
+        auto basename = g_file_get_basename(file);
+        auto format = export_format_for(basename ? basename : "");
+        g_free(basename);
+        RefPtr<Gio::File> ref = reinterpret_cast<Gio::File*>(file);
+        g_object_unref(file);
+        spawn(self->export_log(std::move(ref), format));
+    }
+
+    Task<void>
+    ApplicationWindow::export_log(RefPtr<Gio::File> file, ExportFormat format)
+    {
+        RefPtr<Gio::Cancellable> cancellable = m.cancellable;
+        auto cancel = G_CANCELLABLE(static_cast<Gio::Cancellable*>(cancellable));
+
+        // Plain copies, so the pool never touches a Station
+        std::vector<ExportRecord> records;
+        auto store = G_LIST_MODEL(static_cast<Gio::ListStore*>(m.net->stations));
+        auto n = g_list_model_get_n_items(store);
+        records.reserve(n);
+        for (guint i = 0; i < n; ++i) {
+            auto station = static_cast<Station*>(g_list_model_get_item(store, i));
+            auto& r = records.emplace_back(ExportRecord{ .callsign = station->get_callsign(),
+                                                         .name = station->get_name(),
+                                                         .status = station->get_status(),
+                                                         .acknowledged = station->is_acknowledged(),
+                                                         .heard_unix_ms = station->get_heard_time() });
+            if (auto location = station->get_location()) {
+                r.has_location = true;
+                r.latitude_udeg = to_microdegrees(location->first);
+                r.longitude_udeg = to_microdegrees(location->second);
+            }
+            g_object_unref(station);
         }
-        auto callsign_factory = Gtk::BuilderListItemFactory::create_from_resource(nullptr, "/radio/ki6kvz/MondayNightNet/mnn-callsign-list-item-factory.ui");
+        auto session = read_session();
+        // Held by the frame so the pool can post to it after we are gone
+        RefPtr<Gtk::ProgressBar> bar_ref = m.export_progress;
+        auto bar = GTK_PROGRESS_BAR(static_cast<Gtk::ProgressBar*>(bar_ref));
+        gtk_progress_bar_set_fraction(bar, 0.0);
+        m.export_progress->set_visible(true);
 
-        for (const auto& col : vol_view) {
-            auto filter = Gtk::CustomFilter::create([begin = col["begin"].get<std::string>(), end = col["end"].get<std::string>()]
-                                                    (Object* o) -> bool {
-                auto station = reinterpret_cast<Station*>(o);
-                auto suf = station->get_property(Station::prop_suffix());
-                return suf && *suf >= begin.front() && *suf <= end.front();
+        co_await thread_pool().schedule();
+        auto gfile = G_FILE(static_cast<Gio::File*>(file));
+        GError* error = nullptr;
+        bool ok = false;
+        if (auto stream = g_file_replace(gfile, nullptr, FALSE, G_FILE_CREATE_REPLACE_DESTINATION, cancel, &error)) {
+            auto out = G_OUTPUT_STREAM(stream);
+            ok = write_export(format, session, records, [out, cancel, &error](std::span<const char> chunk) {
+                return static_cast<bool>(g_output_stream_write_all(out, chunk.data(), chunk.size(), nullptr, cancel, &error));
+            }, [bar](std::size_t done, std::size_t total) {
+                post_export_progress(bar, done, total);
             });
-            auto filter_model = Gtk::FilterListModel::create(store, filter);
-            auto selection_model = Gtk::NoSelection::create(filter_model);
-            auto view = Gtk::ColumnView::create(selection_model);
+            if (ok) {
+                ok = g_output_stream_close(out, cancel, &error);
+            } else {
+                // Closing with a cancelled cancellable drops the temporary and keeps the old file
+                auto abandon = g_cancellable_new();
+                g_cancellable_cancel(abandon);
+                g_output_stream_close(out, abandon, nullptr);
+                g_object_unref(abandon);
+            }
+            g_object_unref(stream);
+        }
+        auto ec = ok ? std::error_code() : to_error_code(error);
+        g_clear_error(&error);
+        if (!co_await resume_on_main(static_cast<Gio::Cancellable*>(cancellable))) co_return;
 
-            auto callsign_column = Gtk::ColumnView::Column::create(_("Callsign"), callsign_factory);
-            view->append_column(callsign_column);
-            m.columns_flowbox->append(view);
+        m.export_progress->set_visible(false);
+        if (ec) {
+            g_warning("Unable to export the net log: %s", ec.message().c_str());
+            m.toast_overlay->add_toast(Adw::Toast::create(_("Unable to export the net log")));
+            co_return;
         }
+        auto count = ExportFormat::CSV == format
+            ? records.size()
+            : static_cast<std::size_t>(std::ranges::count_if(records, [](const auto& r) { return StationStatus::PENDING != r.status; }));
+        auto msg = std::vformat(_("Exported {} stations"), std::make_format_args(count));
+        m.toast_overlay->add_toast(Adw::Toast::create(msg.c_str()));
+    }
 
+    void
+    ApplicationWindow::choose_sheet_file()
+    {
+        if (!m.net) return;
+        auto dialog = gtk_file_dialog_new();
+        gtk_file_dialog_set_title(dialog, _("Save Check-in Sheet"));
+        gtk_file_dialog_set_initial_name(dialog, "check-in-sheet.pdf");
+        auto filters = g_list_store_new(GTK_TYPE_FILE_FILTER);
+        auto filter = gtk_file_filter_new();
+        gtk_file_filter_set_name(filter, _("PDF (*.pdf)"));
+        gtk_file_filter_add_pattern(filter, "*.pdf");
+        g_list_store_append(filters, filter);
+        g_object_unref(filter);
+        gtk_file_dialog_set_filters(dialog, G_LIST_MODEL(filters));
+        g_object_unref(filters);
+        gtk_file_dialog_save(dialog, GTK_WINDOW(this), G_CANCELLABLE(static_cast<Gio::Cancellable*>(m.cancellable)),
+                             &ApplicationWindow::on_sheet_file_chosen, this);
+        g_object_unref(dialog);
+    }
 
+    void
+    ApplicationWindow::on_sheet_file_chosen(::GObject* dialog, GAsyncResult* result, gpointer data)
+    {
+        GError* error = nullptr;
+        auto file = gtk_file_dialog_save_finish(GTK_FILE_DIALOG(dialog), result, &error);
+        if (!file) {
+            g_error_free(error);
+            return;
+        }
+        RefPtr<Gio::File> ref = reinterpret_cast<Gio::File*>(file);
+        g_object_unref(file);
+        spawn(static_cast<ApplicationWindow*>(data)->save_sheet(std::move(ref)));
+    }
+
+    Task<void>
+    ApplicationWindow::save_sheet(RefPtr<Gio::File> file)
+    {
+        RefPtr<Gio::Cancellable> cancellable = m.cancellable;
+        auto cancel = G_CANCELLABLE(static_cast<Gio::Cancellable*>(cancellable));
+        auto data = collect_sheet(*m.net, read_session());
+        RefPtr<Gtk::ProgressBar> bar_ref = m.export_progress;
+        auto bar = GTK_PROGRESS_BAR(static_cast<Gtk::ProgressBar*>(bar_ref));
+        gtk_progress_bar_set_fraction(bar, 0.0);
+        m.export_progress->set_visible(true);
+
+        co_await thread_pool().schedule();
+        // Pango font maps are not thread safe, so this thread gets its own
+        auto font_map = pango_cairo_font_map_new();
+        auto context = pango_font_map_create_context(font_map);
+        pango_cairo_context_set_resolution(context, 72.0);
+        GError* error = nullptr;
+        bool ok = false;
+        std::size_t pages = 0;
+        {
+            SheetRenderer renderer(std::move(data), context);
+            pages = renderer.page_count();
+            if (auto stream = g_file_replace(G_FILE(static_cast<Gio::File*>(file)), nullptr, FALSE,
+                                             G_FILE_CREATE_REPLACE_DESTINATION, cancel, &error)) {
+                auto out = G_OUTPUT_STREAM(stream);
+                // The surface streams each page out as it is shown
+                PdfStream sink{ out, cancel, &error };
+                auto surface = cairo_pdf_surface_create_for_stream(&write_pdf, &sink, SheetRenderer::letter_width, SheetRenderer::letter_height);
+                auto cr = cairo_create(surface);
+                for (std::size_t i = 0; i < pages && !g_cancellable_is_cancelled(cancel); ++i) {
+                    renderer.draw_page(cr, i);
+                    cairo_show_page(cr);
+                    post_export_progress(bar, i + 1, pages);
+                }
+                cairo_destroy(cr);
+                cairo_surface_finish(surface);
+                ok = CAIRO_STATUS_SUCCESS == cairo_surface_status(surface) && !g_cancellable_is_cancelled(cancel);
+                cairo_surface_destroy(surface);
+                if (ok) {
+                    ok = g_output_stream_close(out, cancel, &error);
+                } else {
+                    auto abandon = g_cancellable_new();
+                    g_cancellable_cancel(abandon);
+                    g_output_stream_close(out, abandon, nullptr);
+                    g_object_unref(abandon);
+                }
+                g_object_unref(stream);
+            }
+        }
+        g_object_unref(context);
+        g_object_unref(font_map);
+        auto ec = ok ? std::error_code() : error ? to_error_code(error) : std::make_error_code(std::errc::io_error);
+        g_clear_error(&error);
+        if (!co_await resume_on_main(static_cast<Gio::Cancellable*>(cancellable))) co_return;
+
+        m.export_progress->set_visible(false);
+        if (ec) {
+            g_warning("Unable to save the check-in sheet: %s", ec.message().c_str());
+            m.toast_overlay->add_toast(Adw::Toast::create(_("Unable to save the check-in sheet")));
+            co_return;
+        }
+        auto msg = std::vformat(_("Saved {} pages"), std::make_format_args(pages));
+        m.toast_overlay->add_toast(Adw::Toast::create(msg.c_str()));
+    }
+
+    void
+    ApplicationWindow::print_sheet()
+    {
+        if (!m.net) return;
+        auto op = gtk_print_operation_new();
+        gtk_print_operation_set_unit(op, GTK_UNIT_POINTS);
+        gtk_print_operation_set_job_name(op, _("Check-in Sheet"));
+        gtk_print_operation_set_allow_async(op, TRUE);
+        auto job = new SheetPrintJob{ .data = collect_sheet(*m.net, read_session()) };
+        g_object_set_data_full(G_OBJECT(op), "mnn-sheet-print-job", job, [](gpointer p) { delete static_cast<SheetPrintJob*>(p); });
+        g_signal_connect(op, "begin-print", G_CALLBACK(&SheetPrintJob::on_begin_print), job);
+        g_signal_connect(op, "draw-page", G_CALLBACK(&SheetPrintJob::on_draw_page), job);
+        GError* error = nullptr;
+        if (GTK_PRINT_OPERATION_RESULT_ERROR == gtk_print_operation_run(op, GTK_PRINT_OPERATION_ACTION_PRINT_DIALOG, GTK_WINDOW(this), &error)) {
+            g_warning("Unable to print the check-in sheet: %s", error->message);
+            g_error_free(error);
+            m.toast_overlay->add_toast(Adw::Toast::create(_("Unable to print the check-in sheet")));
+        }
+        // A running async operation holds its own reference
+        g_object_unref(op);
+    }
+
+    void
+    ApplicationWindow::start_replay_from_env()
+    {
+        // Load testing hook, see mnn-generate-net --help
+        if (auto events_path = g_getenv("MNN_REPLAY_EVENTS")) {
+            std::ifstream events_file(events_path);
+            auto events = nlohmann::json::parse(events_file, nullptr, false);
+            if (events.is_discarded()) {
+                g_warning("Unable to parse check-in events from %s", events_path);
+            } else {
+                auto speed = g_getenv("MNN_REPLAY_SPEED");
+                replay_checkins(checkins_from_json(events), speed ? g_ascii_strtod(speed, nullptr) : 60.0);
+            }
+        }
+    }
+
+    void
+    ApplicationWindow::replay_checkins(std::vector<CheckinEvent> events, double speedup)
+    {
+        if (!m.net) return;
+        auto lookup = [net = m.net](std::string_view callsign) { return net->find(callsign); };
+        auto finished = [this](std::size_t applied, std::size_t missed, std::chrono::milliseconds elapsed) {
+            g_message("Replayed %zu check-ins (%zu unknown callsigns) in %lld ms",
+                      applied, missed, static_cast<long long>(elapsed.count()));
+            auto seconds = elapsed.count() / 1000.0;
+            auto msg = std::vformat(_("Replayed {} check-ins in {:.1f} s"), std::make_format_args(applied, seconds));
+            m.toast_overlay->add_toast(Adw::Toast::create(msg.c_str()));
+        };
+        m.replay = std::make_unique<CheckinReplay>(std::move(events), speedup, std::move(lookup), std::move(finished));
+        m.replay->start();
+    }
+
+    void
+    ApplicationWindow::on_date_entry_icon_pressed(Gtk::Entry*, Gtk::Entry::IconPosition pos)
+    {
+        if (Gtk::Entry::IconPosition::SECONDARY == pos) {
+            m.date_entry_popover->popup();
+        }
+    }
+
+    void
+    ApplicationWindow::show_metrics()
+    {
+        auto label = Gtk::Label::create(nullptr);
+        label->set_xalign(0);
+        label->set_yalign(0);
+        label->set_selectable(true);
+        label->add_css_class("monospace");
+        label->set_margin_start(12);
+        label->set_margin_end(12);
+        label->set_margin_bottom(12);
+        auto view = new DiagnosticsView{ GTK_LABEL(g_object_ref(static_cast<Gtk::Label*>(label))), PowerMonitor() };
+        label->set_text(render_diagnostics(std::nullopt).c_str());
+
+        auto scrolled = Gtk::ScrolledWindow::create();
+        scrolled->set_child(label);
+        scrolled->set_vexpand(true);
+        auto toolbar = Adw::ToolbarView::create();
+        toolbar->add_top_bar(Adw::HeaderBar::create());
+        toolbar->set_content(scrolled);
+
+        auto dialog = Adw::Dialog::create();
+        dialog->set_title(_("Diagnostics"));
+        dialog->set_content_width(720);
+        dialog->set_content_height(480);
+        dialog->set_child(toolbar);
+
+        /* Refresh while open; the label's ref ends the timer once the dialog
+         * is gone. The rates are since the last refresh, this one's wakeup
+         * included. */
+        g_timeout_add_seconds_full(G_PRIORITY_LOW, 1, [](gpointer data) -> gboolean {
+            auto view = static_cast<DiagnosticsView*>(data);
+            if (!gtk_widget_get_root(GTK_WIDGET(view->label))) return G_SOURCE_REMOVE;
+            gtk_label_set_text(view->label, render_diagnostics(view->power.sample()).c_str());
+            return G_SOURCE_CONTINUE;
+        }, view, [](gpointer data) {
+            auto view = static_cast<DiagnosticsView*>(data);
+            g_object_unref(view->label);
+            delete view;
+        });
+        dialog->present(this);
+    }
+
+    void
+    ApplicationWindow::on_sort_changed(Gtk::DropDown* dropdown, peel::GObject::ParamSpec*)
+    {
+        auto selected = dropdown->get_selected();
+        if (selected >= sort_names.size()) return;
+        m.settings->set_string("roster-sort", sort_names[selected].data());
+        m.roster_grid->set_sort(static_cast<RosterSort>(selected));
+    }
+
+    void
+    ApplicationWindow::on_search_changed(Gtk::SearchEntry* entry)
+    {
+        m.roster_grid->set_search(gtk_editable_get_text(GTK_EDITABLE(entry)));
+    }
+
+    void
+    ApplicationWindow::on_callsign_entry_changed(Gtk::Entry* entry)
+    {
+        auto app = get_application();
+        auto index = app ? app->cast<Application>()->get_uls_index() : nullptr;
+        if (!index) return;
+        std::string_view callsign = entry->get_buffer()->get_text();
+        auto licensee = index->lookup(callsign);
+        if (!licensee) {
+            // Leave a name the operator typed; clear one that belonged to an earlier callsign
+            if (!m.looked_up_name.empty() && m.looked_up_name == std::string_view(m.name_entry->get_buffer()->get_text())) {
+                m.name_entry->get_buffer()->set_text("", -1);
+            }
+            m.looked_up_name.clear();
+            entry->set_tooltip_text(nullptr);
+            return;
+        }
+        m.looked_up_name = licensee->first_name.empty() ? licensee->name : licensee->first_name;
+        m.name_entry->get_buffer()->set_text(m.looked_up_name.c_str(), -1);
+        auto tooltip = licensee->operator_class != ' '
+            ? std::format("{} ({})\n{}", licensee->name, licensee->operator_class, licensee->address)
+            : std::format("{}\n{}", licensee->name, licensee->address);
+        entry->set_tooltip_text(tooltip.c_str());
+    }
+
+    void
+    ApplicationWindow::on_callsign_entry_activate(Gtk::Entry* entry)
+    {
+        if (!m.net) return;
+        ScopedTimer timer(checkin_command_latency());
+        std::string callsign = entry->get_buffer()->get_text();
+        std::ranges::transform(callsign, callsign.begin(), [](unsigned char c) { return g_ascii_toupper(c); });
+        auto station = m.net->find(callsign);
+        if (!station) {
+            // A walk-in; add them for this session without touching the file
+            auto name = std::string(m.name_entry->get_buffer()->get_text());
+            auto created = Station::try_create(nlohmann::json{ { "callsign", callsign }, { "name", name } }, m.net->arena);
+            if (!created) {
+                m.toast_overlay->add_toast(Adw::Toast::create(_("Not a valid callsign")));
+                return;
+            }
+            station = static_cast<Station*>(*created);
+            // Indexed before the store announces it, so items-changed handlers can look it up
+            m.net->by_callsign.emplace(std::move(callsign), std::move(*created));
+            m.net->stations->append(station);
+        }
+        m.history->set_status(station, StationStatus::HEARD_DIRECT);
+        entry->get_buffer()->set_text("", -1);
+        m.name_entry->get_buffer()->set_text("", -1);
+        entry->set_tooltip_text(nullptr);
+    }
+
+    void
+    ApplicationWindow::on_calendar_day_selected(Gtk::Calendar* cal)
+    {
+        auto date = cal->get_date();
+        auto str = date->format("%F");
+        m.date_entry->get_buffer()->set_text(str, -1);
     }
 
     ApplicationWindow*
     ApplicationWindow::create (Adw::Application *app)
     {
-        return Object::create<ApplicationWindow>(prop_application(), app);
+        ApplicationWindow* window = Object::create<ApplicationWindow>(prop_application(), app);
+        // The application isn't set during init, so the net is opened here
+        auto current = window->m.settings->get_string("current-net");
+        spawn(window->startup(current ? std::string(static_cast<const char*>(current)) : "default-net.json"s));
+        return window;
     }
 
 } // namespace mnn
@@ -23,6 +23,20 @@
 #include <peel/Gtk/Gtk.h>
 #include <peel/class.h>
 #include <nlohmann/json.hpp>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "autosave.hpp"
+#include "checkin_replay.hpp"
+#include "cw_ingest.hpp"
+#include "mnn_roster_grid.hpp"
+#include "net_generator.hpp"
+#include "net_export.hpp"
+#include "net_library.hpp"
+#include "station.hpp"
+#include "station_history.hpp"
+#include "task.hpp"
 
 namespace mnn
 {
@@ -34,21 +48,76 @@ namespace mnn
 
         struct Members {
             peel::RefPtr<peel::Gio::Settings> settings;
+            // Cancelled on dispose so async work doesn't resume into a dead window
+            peel::RefPtr<peel::Gio::Cancellable> cancellable;
             peel::Gtk::Entry* date_entry;
             peel::Gtk::Popover* date_entry_popover;
             peel::Gtk::Calendar* date_entry_calendar;
             peel::Gtk::Entry* frequency_entry;
-            peel::Gtk::FlowBox* columns_flowbox;
+            peel::Gtk::Entry* callsign_entry;
+            peel::Gtk::Entry* name_entry;
+            // What the ULS lookup last put in name_entry, so a miss can take it back
+            std::string looked_up_name;
+            peel::Gtk::DropDown* sort_dropdown;
+            peel::Gtk::SearchBar* search_bar;
+            peel::Gtk::ProgressBar* export_progress;
+            RosterGrid* roster_grid;
             peel::Adw::ToastOverlay* toast_overlay;
+            std::shared_ptr<Net> net;
+            std::unique_ptr<CheckinReplay> replay;
+            // Follows m.net; reads the session fields above
+            std::unique_ptr<Autosave> autosave;
+            // Follows m.net; check-ins made here, for undo
+            std::unique_ptr<StationHistory> history;
+            // Set when the cw-source setting is not empty
+            std::unique_ptr<CwIngest> cw;
+            bool low_power = false;
         } m;
 
-        void setup_net(const nlohmann::json&);
+        void open_net(std::string_view id);
+        // Reads on GIO's threads and parses on the pool; true once the net is showing
+        Task<bool> open_net_async(std::string id);
+        Task<void> startup(std::string id);
+        void show_net(std::shared_ptr<Net>);
+        void report_net_error(std::error_code);
+        void set_net(std::shared_ptr<Net>);
+        void start_replay_from_env();
+        void start_autosave();
+        // Pushes m.low_power to the net's dispatcher and our autosave
+        void apply_power_mode();
+        SessionInfo read_session() const;
+        void update_history_actions();
+        void undo();
+        void redo();
+        // One undoable step, however many stations
+        void reset_checkins();
+        void check_in(std::string_view callsign);
+        // A CW ID matched to the roster; fills the callsign entry if it's empty
+        void suggest_check_in(const std::string& callsign, bool exact);
+        void choose_export_file();
+        static void on_export_file_chosen(GObject* dialog, GAsyncResult*, gpointer self);
+        // Copies the roster here, then formats and writes on the pool
+        Task<void> export_log(peel::RefPtr<peel::Gio::File>, ExportFormat);
+        void choose_sheet_file();
+        static void on_sheet_file_chosen(GObject* dialog, GAsyncResult*, gpointer self);
+        // Copies the roster here, then renders the PDF page by page on the pool
+        Task<void> save_sheet(peel::RefPtr<peel::Gio::File>);
+        void print_sheet();
+        void show_metrics();
         void on_calendar_day_selected(peel::Gtk::Calendar*);
         void on_date_entry_icon_pressed(peel::Gtk::Entry*, peel::Gtk::Entry::IconPosition);
+        void on_callsign_entry_changed(peel::Gtk::Entry*);
+        void on_callsign_entry_activate(peel::Gtk::Entry*);
+        void on_sort_changed(peel::Gtk::DropDown*, peel::GObject::ParamSpec*);
+        void on_search_changed(peel::Gtk::SearchEntry*);
     protected:
         void vfunc_dispose();
 
     public:
+        void replay_checkins(std::vector<CheckinEvent> events, double speedup);
+        // Batch station updates at 4 Hz and autosave at most once a minute
+        void set_low_power(bool);
+
         [[nodiscard]] static ApplicationWindow* create(peel::Adw::Application *);
     };
 
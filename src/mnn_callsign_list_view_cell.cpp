@@ -16,9 +16,68 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+
+#include <array>
 #include "mnn_callsign_list_view_cell.hpp"
-#include <peel/widget-template.h>
-#include <peel/GLib/GLib.h>
+#include "metrics.hpp"
+
+namespace
+{
+    using Style = std::uint8_t;
+
+    constexpr Style HEADING = 1 << 0;
+    constexpr Style HEARD_DIRECT = 1 << 1;
+    constexpr Style HEARD_RELAY = 1 << 2;
+    constexpr Style UNACKNOWLEDGED = 1 << 3;
+
+    constexpr std::array statuses = { mnn::StationStatus::PENDING, mnn::StationStatus::HEARD_DIRECT, mnn::StationStatus::HEARD_RELAY };
+
+    constexpr std::size_t
+    style_index(mnn::StationStatus status, bool is_acknowledged)
+    {
+        return static_cast<std::size_t>(status) * 2 + is_acknowledged;
+    }
+
+    // Every state's classes, worked out once instead of per bind
+    constexpr auto style_table = [] {
+        std::array<Style, statuses.size() * 2> table{};
+        for (auto status : statuses) {
+            for (bool ack : { false, true }) {
+                Style s = 0;
+                if (mnn::StationStatus::HEARD_DIRECT == status) s |= HEARD_DIRECT;
+                if (mnn::StationStatus::HEARD_RELAY == status) s |= HEARD_RELAY;
+                if (!ack && mnn::StationStatus::PENDING != status) s |= UNACKNOWLEDGED;
+                table[style_index(status, ack)] = s;
+            }
+        }
+        return table;
+    }();
+
+    // Compared by address, so a notify costs no string compares
+    struct StationPspecs
+    {
+        GParamSpec* prefix;
+        GParamSpec* suffix;
+        GParamSpec* name;
+        GParamSpec* status;
+        GParamSpec* is_acknowledged;
+    };
+
+    const StationPspecs&
+    station_pspecs(GObject* station)
+    {
+        static const StationPspecs pspecs = [station] {
+            auto klass = G_OBJECT_GET_CLASS(station);
+            return StationPspecs{ g_object_class_find_property(klass, "prefix"),
+                                  g_object_class_find_property(klass, "suffix"),
+                                  g_object_class_find_property(klass, "name"),
+                                  g_object_class_find_property(klass, "status"),
+                                  g_object_class_find_property(klass, "is-acknowledged") };
+        }();
+        return pspecs;
+    }
+
+} // anonymous namespace
 
 namespace mnn
 {
@@ -29,35 +88,122 @@ PEEL_CLASS_IMPL (CallsignListViewCell, "MNNCallsignListViewCell", Gtk::Box);
 void
 CallsignListViewCell::vfunc_dispose()
 {
-    dispose_template(Type::of<CallsignListViewCell> ());
+    unbind();
     parent_vfunc_dispose<CallsignListViewCell> ();
 }
 
+void
+CallsignListViewCell::vfunc_finalize()
+{
+    m.~Members();
+    parent_vfunc_finalize<CallsignListViewCell> ();
+}
+
 void
 CallsignListViewCell::Class::init()
 {
     override_vfunc_dispose<CallsignListViewCell>();
-    set_template_from_resource("/radio/ki6kvz/MondayNightNet/mnn-callsign-list-view-cell.ui");
-    PEEL_WIDGET_TEMPLATE_BIND_CALLBACK(CallsignListViewCell, get_css_classes);
-
+    override_vfunc_finalize<CallsignListViewCell>();
 }
 
 void
 CallsignListViewCell::init(Class*)
 {
-    init_template();
+    new (&m) Members;
+    set_spacing(5);
+    auto label = [this](int width_chars) {
+        auto l = Gtk::Label::create(nullptr);
+        l->set_xalign(0);
+        l->set_single_line_mode(true);
+        if (width_chars > 0) {
+            l->set_width_chars(width_chars);
+        } else {
+            l->set_ellipsize(Pango::EllipsizeMode::END);
+        }
+        Gtk::Label* raw = static_cast<Gtk::Label*>(l);
+        append(l);
+        return raw;
+    };
+    m.prefix = label(4);
+    m.suffix = label(4);
+    m.name = label(0);
 }
 
+CallsignListViewCell::Style
+CallsignListViewCell::station_style(StationStatus status, bool is_acknowledged) noexcept
+{
+    return style_table[style_index(status, is_acknowledged)];
+}
 
-Strv
-CallsignListViewCell::get_css_classes(Station*, bool is_acknowledged, StationStatus status)
+void
+CallsignListViewCell::bind(peel::GObject::Object* item)
 {
-    auto builder = GLib::StrvBuilder::create();
-    if (!is_acknowledged && status != StationStatus::PENDING) {
-        builder->add("unacknowledged");
+    static auto& binds = metrics().counter("mnn_cell_binds", "Roster grid cells bound to a slot");
+    binds.add();
+    unbind();
+    m.item = item;
+
+    auto object = reinterpret_cast<::GObject*>(item);
+    if (object && !GTK_IS_STRING_OBJECT(object)) {
+        m.station = reinterpret_cast<Station*>(item);
+        m.notify_id = g_signal_connect(m.station, "notify", G_CALLBACK(&CallsignListViewCell::on_station_notify), this);
+        show_station(nullptr);
+        return;
+    }
+    // Column titles go where the prefix would; blanks are empty titles
+    auto title = object ? gtk_string_object_get_string(GTK_STRING_OBJECT(object)) : "";
+    m.prefix->set_label(title);
+    m.suffix->set_label("");
+    m.name->set_label("");
+    set_style(*title ? HEADING : 0);
+}
+
+void
+CallsignListViewCell::unbind()
+{
+    if (m.station) {
+        g_signal_handler_disconnect(m.station, m.notify_id);
+        m.station = nullptr;
+        m.notify_id = 0;
     }
-    return GLib::StrvBuilder::unref_to_strv(builder);
+    m.item = nullptr;
+}
+
+void
+CallsignListViewCell::on_station_notify(::GObject*, GParamSpec* pspec, gpointer data)
+{
+    static_cast<CallsignListViewCell*>(data)->show_station(pspec);
 }
 
+void
+CallsignListViewCell::show_station(GParamSpec* changed)
+{
+    const auto& p = station_pspecs(reinterpret_cast<::GObject*>(m.station));
+    auto text = [](const char* s) { return s ? s : ""; };
+    if (!changed || p.prefix == changed) m.prefix->set_label(text(m.station->get_property(Station::prop_prefix())));
+    if (!changed || p.suffix == changed) m.suffix->set_label(text(m.station->get_property(Station::prop_suffix())));
+    if (!changed || p.name == changed) m.name->set_label(text(m.station->get_property(Station::prop_name())));
+    if (!changed || p.status == changed || p.is_acknowledged == changed) {
+        set_style(station_style(m.station->get_status(), m.station->is_acknowledged()));
+    }
+}
+
+void
+CallsignListViewCell::set_style(Style style)
+{
+    // Only the classes that differ, so GTK restyles nothing it doesn't have to
+    auto changed = static_cast<Style>(style ^ m.style);
+    if (0 == changed) return;
+    auto widget = reinterpret_cast<GtkWidget*>(this);
+    for (std::size_t i = 0; i < style_classes.size(); ++i) {
+        if (!(changed & (1 << i))) continue;
+        if (style & (1 << i)) {
+            gtk_widget_add_css_class(widget, style_classes[i]);
+        } else {
+            gtk_widget_remove_css_class(widget, style_classes[i]);
+        }
+    }
+    m.style = style;
+}
 
 } // namespace mnn
@@ -16,30 +16,58 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <gtk/gtk.h>
 #include <peel/Gtk/Gtk.h>
 #include <peel/class.h>
-#include <peel/Strv.h>
 #include "station.hpp"
 
 namespace mnn
 {
+    /* One slot of the roster grid, built in code for a
+     * GtkSignalListItemFactory. bind hands it whatever RosterGridModel put
+     * in the slot: a Station, whose labels and style then follow its
+     * notifies, or a GtkStringObject, shown as a column title when it
+     * isn't empty. A recycled cell never shows the previous slot. */
     class CallsignListViewCell final : public peel::Gtk::Box
     {
         PEEL_SIMPLE_CLASS(CallsignListViewCell, peel::Gtk::Box);
 
         void init(Class *);
 
-        peel::Strv get_css_classes(Station*, bool is_acknowledged, StationStatus status);
+        // Bit per CSS class in style_classes
+        using Style = std::uint8_t;
+
+        struct Members {
+            peel::Gtk::Label* prefix;
+            peel::Gtk::Label* suffix;
+            peel::Gtk::Label* name;
+            peel::RefPtr<peel::GObject::Object> item;
+            Station* station;
+            gulong notify_id;
+            Style style;
+        } m;
+
+        static void on_station_notify(GObject*, GParamSpec*, gpointer self);
+        void show_station(GParamSpec* changed);
+        void set_style(Style);
 
     protected:
         void vfunc_dispose();
+        void vfunc_finalize();
 
     public:
-//        PEEL_PROPERTY(peel::Type::of<Station>(), station, "station");
+        static constexpr std::array style_classes = { "heading", "heard-direct", "heard-relay", "unacknowledged" };
+
+        // Style of every station state, indexed by status then acknowledgement
+        [[nodiscard]] static Style station_style(StationStatus, bool is_acknowledged) noexcept;
 
-    private:
+        void bind(peel::GObject::Object* item);
+        void unbind();
     };
 
 } // namespace mnn
@@ -38,6 +38,26 @@ namespace mnn
                 return "Missing callsign in JSON station record"s;
             case error::invalid_callsign:
                 return "Invalid callsign in JSON station record"s;
+            case error::invalid_field_type:
+                return "Field of the wrong type in JSON station record"s;
+            case error::invalid_location:
+                return "Invalid latitude or longitude in JSON station record"s;
+            case error::invalid_net_version:
+                return "Net definition has no meta version or an unsupported one"s;
+            case error::missing_columns:
+                return "Net definition has no columns"s;
+            case error::no_valid_columns:
+                return "Net definition has no valid columns (need begin and end)"s;
+            case error::unreadable_net:
+                return "Net definition could not be read or is not JSON"s;
+            case error::malformed_replication_packet:
+                return "Malformed replication packet"s;
+            case error::replication_socket_failed:
+                return "Unable to open the replication multicast socket"s;
+            case error::malformed_snapshot:
+                return "Net snapshot is truncated or not a snapshot"s;
+            case error::duplicate_callsign:
+                return "Callsign already used by an earlier JSON station record"s;
         }
         return std::format("Unknown Monday Night Net error code {}", ev);
     }
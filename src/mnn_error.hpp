@@ -28,6 +28,24 @@ namespace mnn
         missing_name,
         missing_callsign,
         invalid_callsign,
+        invalid_field_type,
+        invalid_location,
+        invalid_net_version,
+        missing_columns,
+        no_valid_columns,
+        unreadable_net,
+        malformed_replication_packet,
+        replication_socket_failed,
+        malformed_snapshot,
+        duplicate_callsign,
+    };
+
+    /* A problem with one field of a record, for paths that report rather
+     * than throw. field points at a string literal. */
+    struct field_error
+    {
+        const char* field;
+        std::error_code code;
     };
 
     class error_category : public std::error_category {
@@ -0,0 +1,222 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <vector>
+#include "metrics.hpp"
+#include "mnn_callsign_list_view_cell.hpp"
+#include "mnn_roster_grid.hpp"
+#include "net_library.hpp"
+#include "station.hpp"
+
+namespace
+{
+    // The net's own location when the definition has one, else the middle of its located stations
+    std::optional<std::pair<double, double>>
+    distance_origin(const mnn::Net& net)
+    {
+        auto lat = net.meta.find("lat");
+        auto lon = net.meta.find("long");
+        if (net.meta.end() != lat && net.meta.end() != lon && lat->is_number() && lon->is_number()) {
+            return std::pair(lat->get<double>(), lon->get<double>());
+        }
+        double lat_sum = 0.0, lon_sum = 0.0;
+        std::size_t located = 0;
+        for (const auto& [callsign, station] : net.by_callsign) {
+            if (auto location = station->get_location()) {
+                lat_sum += location->first;
+                lon_sum += location->second;
+                ++located;
+            }
+        }
+        if (0 == located) return std::nullopt;
+        return std::pair(lat_sum / static_cast<double>(located), lon_sum / static_cast<double>(located));
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+using namespace peel;
+
+PEEL_CLASS_IMPL (RosterGrid, "MNNRosterGrid", Adw::Bin);
+
+void
+RosterGrid::Class::init()
+{
+    override_vfunc_dispose<RosterGrid>();
+    override_vfunc_finalize<RosterGrid>();
+}
+
+void
+RosterGrid::init(Class*)
+{
+    new (&m) Members;
+    m.sort = RosterSort::SUFFIX;
+    m.search = RosterSearchFilter::create();
+    // Cells are built and bound in code; no builder XML or expressions per row
+    auto factory = Gtk::SignalListItemFactory::create();
+    g_signal_connect(static_cast<Gtk::SignalListItemFactory*>(factory), "setup", G_CALLBACK(&RosterGrid::on_setup), nullptr);
+    g_signal_connect(static_cast<Gtk::SignalListItemFactory*>(factory), "bind", G_CALLBACK(&RosterGrid::on_bind), nullptr);
+    g_signal_connect(static_cast<Gtk::SignalListItemFactory*>(factory), "unbind", G_CALLBACK(&RosterGrid::on_unbind), nullptr);
+    auto view = Gtk::GridView::create(nullptr, factory);
+    m.view = static_cast<Gtk::GridView*>(view);
+    auto scrolled = Gtk::ScrolledWindow::create();
+    scrolled->set_policy(Gtk::PolicyType::NEVER, Gtk::PolicyType::AUTOMATIC);
+    scrolled->set_vexpand(true);
+    scrolled->set_child(view);
+    set_child(scrolled);
+
+    // The scrolled window hands the view an adjustment whose page is the viewport
+    m.hadjustment = GTK_ADJUSTMENT(g_object_ref(gtk_scrollable_get_hadjustment(GTK_SCROLLABLE(m.view))));
+    m.page_size_id = g_signal_connect(m.hadjustment, "notify::page-size", G_CALLBACK(&RosterGrid::on_page_size), this);
+}
+
+void
+RosterGrid::vfunc_dispose()
+{
+    if (m.search_tick_id) {
+        gtk_widget_remove_tick_callback(reinterpret_cast<GtkWidget*>(this), m.search_tick_id);
+        m.search_tick_id = 0;
+    }
+    if (m.hadjustment) {
+        g_signal_handler_disconnect(m.hadjustment, m.page_size_id);
+        g_clear_object(&m.hadjustment);
+    }
+    parent_vfunc_dispose<RosterGrid>();
+}
+
+void
+RosterGrid::vfunc_finalize()
+{
+    m.~Members();
+    parent_vfunc_finalize<RosterGrid>();
+}
+
+void
+RosterGrid::set_net(const Net& net)
+{
+    std::vector<RefPtr<SortedColumnModel>> sorted;
+    std::vector<GListModel*> columns;
+    std::vector<std::string> titles;
+    m.origin = distance_origin(net);
+    for (const auto& col : net.columns) {
+        auto& evaluations = metrics().counter("mnn_filter_evaluations", "Column filter evaluations",
+                                              { { "column", std::format("{}-{}", col.begin, col.end) } });
+        auto filter = Gtk::CustomFilter::create([begin = col.begin.front(), end = col.end.front(), &evaluations]
+                                                (Object* o) -> bool {
+            evaluations.add();
+            auto station = reinterpret_cast<Station*>(o);
+            auto suf = station->get_property(Station::prop_suffix());
+            return suf && *suf >= begin && *suf <= end;
+        });
+        auto filtered = Gtk::FilterListModel::create(net.stations, filter);
+        sorted.push_back(SortedColumnModel::create(G_LIST_MODEL(static_cast<Gtk::FilterListModel*>(filtered)), m.sort, m.origin));
+        /* Search last, so typing neither reruns the column filter nor
+         * touches the sort; it only narrows or widens an already sorted
+         * column, incrementally as the filter allows. */
+        auto searched = Gtk::FilterListModel::create(sorted.back(), m.search);
+        columns.push_back(G_LIST_MODEL(static_cast<Gtk::FilterListModel*>(searched)));
+        titles.push_back(col.begin == col.end ? col.begin : std::format("{} \u2013 {}", col.begin, col.end));
+    }
+    m.columns = std::move(sorted);
+    // Views only; the store and its stations belong to the net
+    m.model = RosterGridModel::create(columns, titles);
+    m.view->set_model(Gtk::NoSelection::create(m.model));
+    update_lanes();
+}
+
+void
+RosterGrid::set_sort(RosterSort sort)
+{
+    if (sort == m.sort) return;
+    m.sort = sort;
+    for (auto& column : m.columns) {
+        column->set_sort(sort, m.origin);
+    }
+}
+
+void
+RosterGrid::set_search(std::string_view text)
+{
+    m.pending_search.assign(text);
+    auto widget = reinterpret_cast<GtkWidget*>(this);
+    if (!gtk_widget_get_mapped(widget)) {
+        // No frames to wait for
+        m.search->set_search(m.pending_search);
+        return;
+    }
+    if (!m.search_tick_id) {
+        m.search_tick_id = gtk_widget_add_tick_callback(widget, &RosterGrid::on_search_tick, this, nullptr);
+    }
+}
+
+gboolean
+RosterGrid::on_search_tick(GtkWidget*, GdkFrameClock*, gpointer data)
+{
+    auto self = static_cast<RosterGrid*>(data);
+    self->m.search_tick_id = 0;
+    self->m.search->set_search(self->m.pending_search);
+    return G_SOURCE_REMOVE;
+}
+
+void
+RosterGrid::on_setup(GtkSignalListItemFactory*, ::GObject* object, gpointer)
+{
+    auto item = GTK_LIST_ITEM(object);
+    gtk_list_item_set_activatable(item, FALSE);
+    auto cell = Object::create<CallsignListViewCell>();
+    gtk_list_item_set_child(item, reinterpret_cast<GtkWidget*>(static_cast<CallsignListViewCell*>(cell)));
+}
+
+void
+RosterGrid::on_bind(GtkSignalListItemFactory*, ::GObject* object, gpointer)
+{
+    auto item = GTK_LIST_ITEM(object);
+    auto cell = reinterpret_cast<CallsignListViewCell*>(gtk_list_item_get_child(item));
+    cell->bind(reinterpret_cast<peel::GObject::Object*>(gtk_list_item_get_item(item)));
+}
+
+void
+RosterGrid::on_unbind(GtkSignalListItemFactory*, ::GObject* object, gpointer)
+{
+    reinterpret_cast<CallsignListViewCell*>(gtk_list_item_get_child(GTK_LIST_ITEM(object)))->unbind();
+}
+
+void
+RosterGrid::on_page_size(::GObject*, GParamSpec*, gpointer data)
+{
+    static_cast<RosterGrid*>(data)->update_lanes();
+}
+
+void
+RosterGrid::update_lanes()
+{
+    auto width = static_cast<int>(gtk_adjustment_get_page_size(m.hadjustment));
+    if (!m.model || width <= 0) return;
+    m.model->set_lanes(static_cast<std::size_t>(std::max(1, width / min_lane_width)));
+    auto lanes = static_cast<guint>(m.model->get_lanes());
+    // The view must agree exactly, or rows would no longer line up with the layout
+    m.view->set_max_columns(lanes);
+    m.view->set_min_columns(lanes);
+}
+
+} // namespace mnn
@@ -0,0 +1,88 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <gtk/gtk.h>
+#include <peel/Adw/Adw.h>
+#include <peel/Gtk/Gtk.h>
+#include <peel/class.h>
+#include "roster_grid_model.hpp"
+#include "roster_search_filter.hpp"
+#include "roster_sort.hpp"
+#include "sorted_column_model.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    /* Every column of the net in one scrolling GtkGridView. Only visible
+     * slots get widgets, recycled across columns as they scroll, and a
+     * width change reflows the columns into more or fewer lanes without
+     * touching the column models. */
+    class RosterGrid final : public peel::Adw::Bin
+    {
+        PEEL_SIMPLE_CLASS (RosterGrid, peel::Adw::Bin);
+
+        void init(Class *);
+
+        struct Members {
+            peel::Gtk::GridView* view;
+            peel::RefPtr<RosterGridModel> model;
+            std::vector<peel::RefPtr<SortedColumnModel>> columns;
+            RosterSort sort;
+            // Where DISTANCE measures from, as (latitude, longitude)
+            std::optional<std::pair<double, double>> origin;
+            // Shared by every column, and kept across nets
+            peel::RefPtr<RosterSearchFilter> search;
+            std::string pending_search;
+            guint search_tick_id;
+            GtkAdjustment* hadjustment;
+            gulong page_size_id;
+        } m;
+
+        static void on_setup(GtkSignalListItemFactory*, GObject* item, gpointer);
+        static void on_bind(GtkSignalListItemFactory*, GObject* item, gpointer);
+        static void on_unbind(GtkSignalListItemFactory*, GObject* item, gpointer);
+        static void on_page_size(GObject*, GParamSpec*, gpointer self);
+        static gboolean on_search_tick(GtkWidget*, GdkFrameClock*, gpointer self);
+        void update_lanes();
+
+    protected:
+        void vfunc_dispose();
+        void vfunc_finalize();
+
+    public:
+        // Narrowest a lane gets before the columns wrap into another band
+        static constexpr int min_lane_width = 240;
+
+        void set_net(const Net&);
+        // Re-sorts every column in place; the layout and cells are kept
+        void set_sort(RosterSort);
+        /* Narrows every column to stations matching text. Keystrokes
+         * within one frame are coalesced into a single filter change. */
+        void set_search(std::string_view text);
+    };
+
+} // namespace mnn
@@ -0,0 +1,122 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace mnn
+{
+    /* Bounded lock-free queue for many producer threads and one consumer
+     * (Vyukov's sequenced ring). Each slot carries a sequence number that
+     * says whose turn it is, so producers only contend on a single
+     * fetch-and-increment and the consumer never writes to the producers'
+     * cache line. try_push() fails instead of blocking when the ring is
+     * full; that is the back-pressure signal. T must be default
+     * constructible and is best kept trivially copyable. */
+    template<typename T>
+    class MpscQueue
+    {
+    public:
+        explicit MpscQueue(std::size_t capacity) :
+            mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+            cells(std::make_unique<Cell[]>(mask + 1))
+        {
+            for (std::size_t i = 0; i <= mask; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Any thread
+        [[nodiscard]] bool
+        try_push(const T& value) noexcept
+        {
+            auto pos = tail.load(std::memory_order_relaxed);
+            for (;;) {
+                auto& cell = cells[pos & mask];
+                auto seq = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (0 == diff) {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.value = value;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // The consumer thread only
+        [[nodiscard]] bool
+        try_pop(T& out) noexcept
+        {
+            auto pos = head.load(std::memory_order_relaxed);
+            auto& cell = cells[pos & mask];
+            auto seq = cell.sequence.load(std::memory_order_acquire);
+            if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1) < 0) {
+                return false;
+            }
+            out = std::move(cell.value);
+            cell.sequence.store(pos + mask + 1, std::memory_order_release);
+            head.store(pos + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // A snapshot; producers may have moved on by the time it's read
+        [[nodiscard]] std::size_t
+        size_approx() const noexcept
+        {
+            auto t = tail.load(std::memory_order_relaxed);
+            auto h = head.load(std::memory_order_relaxed);
+            return t > h ? std::min(t - h, mask + 1) : 0;
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept { return mask + 1; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        // Apart, so producers bumping tail don't bounce the consumer's line
+        static constexpr std::size_t line = 64;
+
+        const std::size_t mask;
+        std::unique_ptr<Cell[]> cells;
+        alignas(line) std::atomic<std::size_t> tail = 0;
+        alignas(line) std::atomic<std::size_t> head = 0;
+    };
+
+} // namespace mnn
@@ -0,0 +1,266 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "net_daemon.hpp"
+
+namespace
+{
+    // Roughly a minute of full rate events; beyond that the client is gone in all but name
+    constexpr std::size_t max_backlog = 16 * 1024 * 1024;
+
+} // anonymous namespace
+
+namespace mnn
+{
+    NetDaemon::NetDaemon(NetSession& session, std::string socket_path) :
+        session(session),
+        socket_path(std::move(socket_path))
+    {
+    }
+
+    NetDaemon::~NetDaemon()
+    {
+        for (auto& c : clients) {
+            ::close(c.fd);
+        }
+        if (listen_fd >= 0) {
+            ::close(listen_fd);
+            ::unlink(socket_path.c_str());
+        }
+        for (auto fd : wake_fds) {
+            if (fd >= 0) ::close(fd);
+        }
+    }
+
+    std::error_code
+    NetDaemon::listen()
+    {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (socket_path.size() >= sizeof(addr.sun_path)) {
+            return std::make_error_code(std::errc::filename_too_long);
+        }
+        std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+        ::unlink(socket_path.c_str());
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listen_fd < 0 ||
+            ::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            ::listen(listen_fd, 16) < 0 ||
+            ::pipe2(wake_fds, O_NONBLOCK | O_CLOEXEC) < 0) {
+            return { errno, std::system_category() };
+        }
+        return {};
+    }
+
+    void
+    NetDaemon::request_stop()
+    {
+        stopping = true;
+        if (wake_fds[1] >= 0) {
+            [[maybe_unused]] auto n = ::write(wake_fds[1], "x", 1);
+        }
+    }
+
+    void
+    NetDaemon::run()
+    {
+        std::vector<pollfd> fds;
+        while (!stopping) {
+            fds.clear();
+            fds.push_back({ listen_fd, POLLIN, 0 });
+            fds.push_back({ wake_fds[0], POLLIN, 0 });
+            for (const auto& c : clients) {
+                short events = POLLIN;
+                if (c.out_sent < c.out.size()) events |= POLLOUT;
+                fds.push_back({ c.fd, events, 0 });
+            }
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (EINTR == errno) continue;
+                break;
+            }
+
+            auto it = clients.begin();
+            for (auto i = 2UZ; i < fds.size(); ++i) {
+                auto& c = *it;
+                bool alive = true;
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    alive = read_client(c);
+                }
+                if (!alive) {
+                    ::close(c.fd);
+                    it = clients.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            if (fds[0].revents & POLLIN) {
+                accept_clients();
+            }
+
+            publish();
+            for (auto c = clients.begin(); clients.end() != c; ) {
+                if (!flush_client(*c)) {
+                    ::close(c->fd);
+                    c = clients.erase(c);
+                } else {
+                    ++c;
+                }
+            }
+        }
+    }
+
+    void
+    NetDaemon::accept_clients()
+    {
+        for (;;) {
+            auto fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;
+            clients.push_back({ .fd = fd });
+        }
+    }
+
+    bool
+    NetDaemon::read_client(Client& c)
+    {
+        std::array<std::byte, 64 * 1024> chunk;
+        for (;;) {
+            auto n = ::recv(c.fd, chunk.data(), chunk.size(), 0);
+            if (n > 0) {
+                c.reader.feed(std::span(chunk).first(static_cast<std::size_t>(n)));
+                // Apply as we go so a fast writer can't grow the reader unbounded
+                while (auto frame = c.reader.next()) {
+                    handle(c, *frame);
+                }
+                if (c.reader.failed()) return false;
+                continue;
+            }
+            if (0 == n) return false;
+            if (EINTR == errno) continue;
+            return EAGAIN == errno || EWOULDBLOCK == errno;
+        }
+    }
+
+    void
+    NetDaemon::handle(Client& c, const Frame& frame)
+    {
+        if (FrameKind::REQUEST != frame.kind) {
+            return;
+        }
+        IpcResult result{ .malformed = frame.result.malformed };
+        for (const auto& u : frame.updates) {
+            bool known = true;
+            switch (u.op) {
+                case IpcOp::CHECK_IN:
+                    if (u.value > static_cast<std::uint8_t>(StationStatus::HEARD_RELAY)) {
+                        ++result.malformed;
+                        continue;
+                    }
+                    known = session.check_in(u.callsign, static_cast<StationStatus>(u.value));
+                    break;
+                case IpcOp::ACKNOWLEDGE:
+                    known = session.acknowledge(u.callsign, 0 != u.value);
+                    break;
+                case IpcOp::LOCATION:
+                    known = session.set_location(u.callsign, std::pair{ u.latitude_udeg, u.longitude_udeg });
+                    break;
+                case IpcOp::CLEAR_LOCATION:
+                    known = session.set_location(u.callsign, std::nullopt);
+                    break;
+                case IpcOp::SUBSCRIBE:
+                    if (!c.subscribed) {
+                        c.subscribed = true;
+                        scratch.clear();
+                        for (const auto& st : session.stations()) {
+                            if (StationStatus::PENDING != st.status || st.acknowledged) {
+                                append_state(st, scratch);
+                            }
+                        }
+                        encode_updates(FrameKind::EVENTS, scratch, c.out);
+                    }
+                    break;
+                default:
+                    ++result.malformed;
+                    continue;
+            }
+            ++(known ? result.applied : result.unknown);
+        }
+        encode_result(result, c.out);
+    }
+
+    void
+    NetDaemon::append_state(const StationState& st, std::vector<IpcUpdate>& out) const
+    {
+        out.push_back({ .op = IpcOp::CHECK_IN, .callsign = st.callsign, .value = static_cast<std::uint8_t>(st.status) });
+        out.push_back({ .op = IpcOp::ACKNOWLEDGE, .callsign = st.callsign, .value = st.acknowledged });
+        if (st.has_location) {
+            out.push_back({ .op = IpcOp::LOCATION, .callsign = st.callsign,
+                            .latitude_udeg = st.latitude_udeg, .longitude_udeg = st.longitude_udeg });
+        } else {
+            out.push_back({ .op = IpcOp::CLEAR_LOCATION, .callsign = st.callsign });
+        }
+    }
+
+    void
+    NetDaemon::publish()
+    {
+        auto changes = session.take_changes();
+        if (changes.empty()) return;
+
+        scratch.clear();
+        for (auto i : changes) {
+            append_state(session.stations()[i], scratch);
+        }
+        // Encoded once, copied to each subscriber
+        events.clear();
+        encode_updates(FrameKind::EVENTS, scratch, events);
+        for (auto& c : clients) {
+            if (c.subscribed) {
+                c.out.insert(c.out.end(), events.begin(), events.end());
+            }
+        }
+    }
+
+    bool
+    NetDaemon::flush_client(Client& c)
+    {
+        while (c.out_sent < c.out.size()) {
+            auto n = ::send(c.fd, c.out.data() + c.out_sent, c.out.size() - c.out_sent, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (EINTR == errno) continue;
+                if (EAGAIN != errno && EWOULDBLOCK != errno) return false;
+                break;
+            }
+            c.out_sent += static_cast<std::size_t>(n);
+        }
+        if (c.out_sent == c.out.size()) {
+            c.out.clear();
+            c.out_sent = 0;
+        }
+        return c.out.size() - c.out_sent <= max_backlog;
+    }
+
+} // namespace mnn
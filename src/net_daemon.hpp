@@ -0,0 +1,79 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "ipc_protocol.hpp"
+#include "net_session.hpp"
+
+namespace mnn
+{
+    /* Serves a NetSession over a Unix stream socket (see ipc_protocol.hpp).
+     * Single threaded around poll(): each wakeup applies every complete
+     * request frame from every client, then encodes the resulting changes
+     * once and queues the same bytes to every subscriber. A subscriber that
+     * stops reading is dropped rather than allowed to hold memory. */
+    class NetDaemon
+    {
+    public:
+        NetDaemon(NetSession& session, std::string socket_path);
+        ~NetDaemon();
+        NetDaemon(const NetDaemon&) = delete;
+        NetDaemon& operator=(const NetDaemon&) = delete;
+
+        std::error_code listen();
+        // Returns once request_stop() has been called
+        void run();
+        // Async signal safe
+        void request_stop();
+
+    private:
+        struct Client
+        {
+            int fd;
+            FrameReader reader;
+            std::vector<std::byte> out;
+            std::size_t out_sent = 0;
+            bool subscribed = false;
+        };
+
+        void accept_clients();
+        bool read_client(Client&);
+        bool flush_client(Client&);
+        void handle(Client&, const Frame&);
+        void publish();
+        void append_state(const StationState&, std::vector<IpcUpdate>&) const;
+
+        NetSession& session;
+        std::string socket_path;
+        int listen_fd = -1;
+        // Written by request_stop(); with nothing to do, poll() sleeps until a client or this
+        int wake_fds[2] = { -1, -1 };
+        std::list<Client> clients;
+        std::vector<IpcUpdate> scratch;
+        std::vector<std::byte> events;
+        std::atomic<bool> stopping = false;
+    };
+
+} // namespace mnn
@@ -0,0 +1,354 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include "net_export.hpp"
+
+namespace
+{
+    using namespace std::literals;
+
+    constexpr std::size_t progress_interval = 4096;
+
+    std::string_view
+    status_nick(mnn::StationStatus status)
+    {
+        switch (status) {
+            case mnn::StationStatus::HEARD_DIRECT: return "heard-direct"sv;
+            case mnn::StationStatus::HEARD_RELAY:  return "heard-relay"sv;
+            case mnn::StationStatus::PENDING:      break;
+        }
+        return "pending"sv;
+    }
+
+    std::string_view
+    checkin_message(const mnn::ExportRecord& r)
+    {
+        if (mnn::StationStatus::HEARD_RELAY == r.status) {
+            return r.acknowledged ? "Checked in via relay, acknowledged"sv : "Checked in via relay"sv;
+        }
+        return r.acknowledged ? "Checked in direct, acknowledged"sv : "Checked in direct"sv;
+    }
+
+    std::chrono::sys_time<std::chrono::milliseconds>
+    to_time_point(std::int64_t unix_ms)
+    {
+        return std::chrono::sys_time<std::chrono::milliseconds>(std::chrono::milliseconds(unix_ms));
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    ExportWriter::ExportWriter(ExportFormat format, Sink sink, std::size_t buffer_size) :
+        format(format),
+        sink(std::move(sink)),
+        buffer(std::max<std::size_t>(buffer_size, 256))
+    {
+    }
+
+    void
+    ExportWriter::flush()
+    {
+        if (0 == used) return;
+        if (!failed && !sink(std::span<const char>(buffer.data(), used))) {
+            failed = true;
+        }
+        used = 0;
+    }
+
+    void
+    ExportWriter::put(std::string_view s)
+    {
+        if (s.size() > buffer.size() - used) {
+            flush();
+            if (s.size() > buffer.size()) {
+                // Bigger than the whole buffer; no point copying it
+                if (!failed && !sink(std::span<const char>(s.data(), s.size()))) {
+                    failed = true;
+                }
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + used, s.data(), s.size());
+        used += s.size();
+    }
+
+    void
+    ExportWriter::put(char c)
+    {
+        if (used == buffer.size()) flush();
+        buffer[used++] = c;
+    }
+
+    void
+    ExportWriter::put_uint(std::uint64_t value, int width)
+    {
+        char digits[24];
+        auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), value);
+        for (auto n = static_cast<int>(end - digits); n < width; ++n) {
+            put('0');
+        }
+        put(std::string_view(digits, end));
+    }
+
+    void
+    ExportWriter::put_degrees(std::int32_t udeg)
+    {
+        if (udeg < 0) put('-');
+        auto magnitude = static_cast<std::uint32_t>(std::abs(static_cast<std::int64_t>(udeg)));
+        put_uint(magnitude / 1000000);
+        put('.');
+        put_uint(magnitude % 1000000, 6);
+    }
+
+    void
+    ExportWriter::put_csv(std::string_view s)
+    {
+        if (std::string_view::npos == s.find_first_of(",\"\r\n")) {
+            put(s);
+            return;
+        }
+        put('"');
+        for (auto c : s) {
+            if ('"' == c) put('"');
+            put(c);
+        }
+        put('"');
+    }
+
+    void
+    ExportWriter::put_adif(std::string_view name, std::string_view value)
+    {
+        if (value.empty()) return;
+        put('<');
+        put(name);
+        put(':');
+        put_uint(value.size());
+        put('>');
+        put(value);
+        put(' ');
+    }
+
+    // ADIF location: XDDD MM.MMM, e.g. N037 24.221
+    void
+    ExportWriter::put_adif_location(std::string_view name, std::int32_t udeg, char positive, char negative)
+    {
+        auto magnitude = static_cast<std::uint64_t>(std::abs(static_cast<std::int64_t>(udeg)));
+        auto degrees = magnitude / 1000000;
+        // Thousandths of a minute
+        auto minutes = ((magnitude % 1000000) * 60 + 500) / 1000;
+        if (minutes >= 60000) {
+            ++degrees;
+            minutes -= 60000;
+        }
+        put('<');
+        put(name);
+        put(":11>");
+        put(udeg < 0 ? negative : positive);
+        put_uint(degrees, 3);
+        put(' ');
+        put_uint(minutes / 1000, 2);
+        put('.');
+        put_uint(minutes % 1000, 3);
+        put(' ');
+    }
+
+    void
+    ExportWriter::put_padded(std::string_view s, std::size_t width)
+    {
+        put(s);
+        for (auto n = s.size(); n < width; ++n) {
+            put(' ');
+        }
+    }
+
+    void
+    ExportWriter::put_date(std::int64_t unix_ms, char separator)
+    {
+        std::chrono::year_month_day ymd(std::chrono::floor<std::chrono::days>(to_time_point(unix_ms)));
+        put_uint(static_cast<std::uint64_t>(static_cast<int>(ymd.year())), 4);
+        if (separator) put(separator);
+        put_uint(static_cast<unsigned>(ymd.month()), 2);
+        if (separator) put(separator);
+        put_uint(static_cast<unsigned>(ymd.day()), 2);
+    }
+
+    void
+    ExportWriter::put_time(std::int64_t unix_ms, bool seconds, char separator)
+    {
+        auto tp = to_time_point(unix_ms);
+        std::chrono::hh_mm_ss hms(tp - std::chrono::floor<std::chrono::days>(tp));
+        put_uint(static_cast<std::uint64_t>(hms.hours().count()), 2);
+        if (separator) put(separator);
+        put_uint(static_cast<std::uint64_t>(hms.minutes().count()), 2);
+        if (!seconds) return;
+        if (separator) put(separator);
+        put_uint(static_cast<std::uint64_t>(hms.seconds().count()), 2);
+    }
+
+    void
+    ExportWriter::begin(const SessionInfo& session)
+    {
+        frequency = session.frequency;
+        control_callsign = session.control_callsign;
+        date_digits.clear();
+        std::ranges::copy_if(session.date, std::back_inserter(date_digits), [](char c) { return c >= '0' && c <= '9'; });
+        if (8 != date_digits.size()) date_digits.clear();
+
+        switch (format) {
+            case ExportFormat::CSV:
+                put("callsign,name,status,acknowledged,heard_utc,latitude,longitude\r\n"sv);
+                break;
+            case ExportFormat::ADIF:
+                put("Monday Night Net log\n<ADIF_VER:5>3.1.4 <PROGRAMID:16>monday-night-net <EOH>\n"sv);
+                break;
+            case ExportFormat::ICS309:
+                put("COMMUNICATIONS LOG (ICS 309)\n\nIncident Name: "sv);
+                put(session.net_id);
+                put("\nOperational Period: "sv);
+                put(session.date);
+                put("\nRadio Net Name or Position/Tactical Call: "sv);
+                put(session.frequency);
+                put("\nRadio Operator (Name, Call Sign): "sv);
+                put(session.control_name);
+                if (!session.control_name.empty() && !session.control_callsign.empty()) put(", "sv);
+                put(session.control_callsign);
+                put("\n\nTime (UTC)  From        To          Message\n"
+                    "----------  ----------  ----------  ----------------------------------------\n"sv);
+                break;
+        }
+    }
+
+    void
+    ExportWriter::record(const ExportRecord& r)
+    {
+        switch (format) {
+            case ExportFormat::CSV:
+                put_csv(r.callsign);
+                put(',');
+                put_csv(r.name);
+                put(',');
+                put(status_nick(r.status));
+                put(r.acknowledged ? ",true,"sv : ",false,"sv);
+                if (r.heard_unix_ms) {
+                    put_date(r.heard_unix_ms, '-');
+                    put('T');
+                    put_time(r.heard_unix_ms, true, ':');
+                    put('Z');
+                }
+                put(',');
+                if (r.has_location) {
+                    put_degrees(r.latitude_udeg);
+                    put(',');
+                    put_degrees(r.longitude_udeg);
+                } else {
+                    put(',');
+                }
+                put("\r\n"sv);
+                break;
+
+            case ExportFormat::ADIF:
+                put_adif("CALL"sv, r.callsign);
+                put_adif("NAME"sv, r.name);
+                if (r.heard_unix_ms) {
+                    put("<QSO_DATE:8>"sv);
+                    put_date(r.heard_unix_ms, '\0');
+                    put(" <TIME_ON:6>"sv);
+                    put_time(r.heard_unix_ms, true, '\0');
+                    put(' ');
+                } else {
+                    put_adif("QSO_DATE"sv, date_digits);
+                }
+                put_adif("FREQ"sv, frequency);
+                put_adif("MODE"sv, "FM"sv);
+                put_adif("STATION_CALLSIGN"sv, control_callsign);
+                put_adif("COMMENT"sv, checkin_message(r));
+                if (r.has_location) {
+                    put_adif_location("LAT"sv, r.latitude_udeg, 'N', 'S');
+                    put_adif_location("LON"sv, r.longitude_udeg, 'E', 'W');
+                }
+                put("<EOR>\n"sv);
+                break;
+
+            case ExportFormat::ICS309:
+                if (r.heard_unix_ms) {
+                    put_time(r.heard_unix_ms, false, ':');
+                    put("       "sv);
+                } else {
+                    put("            "sv);
+                }
+                put_padded(r.callsign, 10);
+                put("  "sv);
+                put_padded(control_callsign, 10);
+                put("  "sv);
+                put(checkin_message(r));
+                if (!r.name.empty()) {
+                    put(" ("sv);
+                    put(r.name);
+                    put(')');
+                }
+                put('\n');
+                break;
+        }
+    }
+
+    bool
+    ExportWriter::finish()
+    {
+        flush();
+        return !failed;
+    }
+
+    bool
+    write_export(ExportFormat format, const SessionInfo& session, std::span<const ExportRecord> records,
+                 ExportWriter::Sink sink, const std::function<void(std::size_t, std::size_t)>& progress)
+    {
+        // Sort indexes, not records; a log is the heard stations in the order they checked in
+        std::vector<std::uint32_t> order;
+        if (ExportFormat::CSV == format) {
+            order.resize(records.size());
+            std::iota(order.begin(), order.end(), 0U);
+        } else {
+            for (std::uint32_t i = 0; i < records.size(); ++i) {
+                if (StationStatus::PENDING != records[i].status) order.push_back(i);
+            }
+            std::ranges::stable_sort(order, {}, [records](std::uint32_t i) { return records[i].heard_unix_ms; });
+        }
+
+        ExportWriter writer(format, std::move(sink));
+        writer.begin(session);
+        for (std::size_t done = 0; done < order.size(); ++done) {
+            writer.record(records[order[done]]);
+            if (progress && 0 == (done + 1) % progress_interval) {
+                progress(done + 1, order.size());
+            }
+        }
+        auto ok = writer.finish();
+        if (progress) progress(order.size(), order.size());
+        return ok;
+    }
+
+} // namespace mnn
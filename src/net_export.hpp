@@ -0,0 +1,104 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "net_snapshot.hpp"
+#include "station_status.hpp"
+
+namespace mnn
+{
+    enum class ExportFormat
+    {
+        CSV,
+        ADIF,
+        // ICS 309 communications log, as plain text
+        ICS309,
+    };
+
+    // One station of the log; plain data so it can cross to a worker
+    struct ExportRecord
+    {
+        std::string callsign;
+        std::string name;
+        StationStatus status = StationStatus::PENDING;
+        bool acknowledged = false;
+        // Unix milliseconds of the latest check-in, 0 for none this session
+        std::int64_t heard_unix_ms = 0;
+        bool has_location = false;
+        std::int32_t latitude_udeg = 0;
+        std::int32_t longitude_udeg = 0;
+    };
+
+    /* Formats records straight into a fixed buffer that is handed to the
+     * sink whenever it fills, so output of any size needs one allocation
+     * and no string per row. */
+    class ExportWriter
+    {
+    public:
+        // Returns false to abandon the export, e.g. on a write error
+        using Sink = std::function<bool(std::span<const char>)>;
+
+        static constexpr std::size_t default_buffer_size = 64 * 1024;
+
+        ExportWriter(ExportFormat, Sink, std::size_t buffer_size = default_buffer_size);
+
+        void begin(const SessionInfo&);
+        void record(const ExportRecord&);
+        // Flushes; false when the sink gave up at any point
+        bool finish();
+
+    private:
+        void put(std::string_view);
+        void put(char);
+        void put_uint(std::uint64_t value, int width = 0);
+        void put_degrees(std::int32_t udeg);
+        void put_csv(std::string_view);
+        void put_adif(std::string_view name, std::string_view value);
+        void put_adif_location(std::string_view name, std::int32_t udeg, char positive, char negative);
+        void put_padded(std::string_view, std::size_t width);
+        void put_date(std::int64_t unix_ms, char separator);
+        void put_time(std::int64_t unix_ms, bool seconds, char separator);
+        void flush();
+
+        ExportFormat format;
+        Sink sink;
+        std::vector<char> buffer;
+        std::size_t used = 0;
+        bool failed = false;
+        // Copied by begin(): ADIF and ICS 309 repeat it per record
+        std::string frequency;
+        std::string control_callsign;
+        std::string date_digits;
+    };
+
+    /* Writes the whole log: every station for CSV, the stations heard
+     * this session in check-in order for ADIF and ICS 309. progress is
+     * called with (done, total) every few thousand records. */
+    bool write_export(ExportFormat, const SessionInfo&, std::span<const ExportRecord>, ExportWriter::Sink,
+                      const std::function<void(std::size_t, std::size_t)>& progress = {});
+
+} // namespace mnn
@@ -0,0 +1,245 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <ranges>
+#include <string_view>
+#include <unordered_set>
+#include <magic_enum/magic_enum.hpp>
+#include "callsign.hpp"
+#include "net_generator.hpp"
+
+namespace
+{
+    using namespace std::literals;
+
+    constexpr std::array us_stems = { "K"sv, "N"sv, "W"sv, "AA"sv, "AB"sv, "AC"sv, "AD"sv, "AE"sv, "AF"sv,
+                                      "AG"sv, "AI"sv, "AJ"sv, "AK"sv, "KA"sv, "KB"sv, "KC"sv, "KD"sv, "KE"sv,
+                                      "KF"sv, "KG"sv, "KI"sv, "KJ"sv, "KK"sv, "KM"sv, "KN"sv, "KO"sv, "KR"sv,
+                                      "KZ"sv, "NA"sv, "WA"sv, "WB"sv, "WQ"sv, "WU"sv };
+
+    constexpr std::array first_names = {
+        "Alex"sv, "Andrew"sv, "Avinash"sv, "Brad"sv, "Brian"sv, "Chris"sv, "Dave"sv, "David"sv,
+        "Donna"sv, "Ed"sv, "Greg"sv, "Herveline"sv, "Isaac"sv, "Jamil"sv, "Jeff"sv, "Jim"sv, "John"sv,
+        "Kathy"sv, "Keith"sv, "Kelly"sv, "Leslie"sv, "Mark"sv, "Martin"sv, "Matt"sv, "Michael"sv,
+        "Molly"sv, "Neil"sv, "Nigel"sv, "Paul"sv, "Phil"sv, "Rick"sv, "Robert"sv, "Sherril"sv,
+        "Stephanie"sv, "Tim"sv, "Wouter"sv };
+
+    constexpr std::string_view letters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    std::pair<std::size_t, std::size_t>
+    format_shape(mnn::CallsignFormat format)
+    {
+        switch (format) {
+            case mnn::CallsignFormat::ONE_BY_ONE:   return { 1, 1 };
+            case mnn::CallsignFormat::ONE_BY_TWO:   return { 1, 2 };
+            case mnn::CallsignFormat::ONE_BY_THREE: return { 1, 3 };
+            case mnn::CallsignFormat::TWO_BY_ONE:   return { 2, 1 };
+            case mnn::CallsignFormat::TWO_BY_TWO:   return { 2, 2 };
+            case mnn::CallsignFormat::TWO_BY_THREE: return { 2, 3 };
+        }
+        return { 2, 3 };
+    }
+
+    std::string_view
+    pick(std::span<const std::string_view> r, std::mt19937_64& rng)
+    {
+        std::uniform_int_distribution<std::size_t> dist(0, r.size() - 1);
+        return r[dist(rng)];
+    }
+
+    char
+    pick_char(char lo, char hi, std::mt19937_64& rng)
+    {
+        return static_cast<char>(std::uniform_int_distribution<int>(lo, hi)(rng));
+    }
+
+    // A stem from anywhere in the ITU series table, e.g. F, 9A, 3DA
+    std::string
+    make_itu_stem(std::size_t prefix_len, std::mt19937_64& rng)
+    {
+        auto single_letter = [](const mnn::ItuAllocation& a) { return '0' == a.lo[1]; };
+        std::uniform_int_distribution<std::size_t> dist(0, mnn::itu_table.size() - 1);
+        const mnn::ItuAllocation* alloc;
+        do {
+            alloc = &mnn::itu_table[dist(rng)];
+        } while (1 == prefix_len && (!single_letter(*alloc) || alloc->lo[0] < 'A'));
+
+        std::string stem(1, alloc->lo[0]);
+        if (1 == prefix_len) return stem;
+        stem.push_back(single_letter(*alloc) ? pick_char('A', 'Z', rng) : pick_char(alloc->lo[1], alloc->hi[1], rng));
+        if ('0' != alloc->lo[2]) {
+            // Three character series, such as 3DA-3DM
+            stem.push_back(pick_char(alloc->lo[2], alloc->hi[2], rng));
+        }
+        return stem;
+    }
+
+    std::string
+    make_callsign(mnn::CallsignFormat format, bool itu, std::mt19937_64& rng)
+    {
+        auto [prefix_len, suffix_len] = format_shape(format);
+        std::string callsign;
+        if (itu) {
+            callsign = make_itu_stem(prefix_len, rng);
+        } else if (1 == prefix_len) {
+            // us_stems begins with K, N and W
+            callsign = pick(std::span(us_stems).first(3), rng);
+        } else {
+            std::string_view stem;
+            do {
+                stem = pick(us_stems, rng);
+            } while (stem.size() != 2);
+            callsign = stem;
+        }
+
+        callsign.push_back(pick_char('0', '9', rng));
+        for (auto i = 0UZ; i < suffix_len; ++i) {
+            callsign.push_back(pick_char('A', 'Z', rng));
+        }
+        return callsign;
+    }
+
+    nlohmann::json
+    make_columns(std::size_t column_count)
+    {
+        auto json = nlohmann::json::array();
+        column_count = std::clamp(column_count, 1UZ, letters.size());
+        for (auto i = 0UZ; i < column_count; ++i) {
+            auto begin = letters.size() * i / column_count;
+            auto end   = letters.size() * (i + 1) / column_count - 1;
+            json.push_back({ { "begin", std::string(1, letters[begin]) },
+                             { "end",   std::string(1, letters[end]) } });
+        }
+        return json;
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    nlohmann::json
+    generate_net(const GeneratorOptions& opts)
+    {
+        std::mt19937_64 rng(opts.seed);
+        auto weights = opts.formats | std::views::values;
+        std::discrete_distribution<std::size_t> format_dist(weights.begin(), weights.end());
+        std::bernoulli_distribution aec_dist(opts.aec_ratio);
+        std::bernoulli_distribution location_dist(opts.location_ratio);
+        std::uniform_real_distribution<double> offset_dist(-opts.radius_degrees, opts.radius_degrees);
+
+        auto stations = nlohmann::json::array();
+        std::unordered_set<std::string> seen;
+        seen.reserve(opts.station_count);
+        // 1x1 and 2x1 spaces are small; don't spin forever on tiny weights
+        auto attempts_left = opts.station_count * 8 + 64;
+        while (stations.size() < opts.station_count && attempts_left-- > 0) {
+            auto format = opts.formats.empty() ? CallsignFormat::TWO_BY_THREE : opts.formats[format_dist(rng)].first;
+            auto callsign = make_callsign(format, opts.itu_prefixes, rng);
+            if (!seen.insert(callsign).second) {
+                continue;
+            }
+            nlohmann::json s = { { "callsign", std::move(callsign) },
+                                 { "name", std::string(pick(first_names, rng)) } };
+            if (aec_dist(rng)) {
+                s["assistant_emergency_coordinator"] = true;
+            }
+            if (location_dist(rng)) {
+                s["lat"] = opts.center_latitude + offset_dist(rng);
+                s["long"] = opts.center_longitude + offset_dist(rng);
+            }
+            stations.push_back(std::move(s));
+        }
+
+        return {
+            { "meta", { { "version", 1 },
+                        { "generated_date", "1970-01-01" },
+                        { "location", "Generated" },
+                        { "seed", opts.seed } } },
+            { "totals", opts.totals },
+            { "columns", make_columns(opts.column_count) },
+            { "stations", std::move(stations) },
+        };
+    }
+
+    std::vector<CheckinEvent>
+    generate_checkins(const nlohmann::json& net, const CheckinOptions& opts)
+    {
+        std::vector<CheckinEvent> events;
+        if (!net.contains("stations") || net["stations"].empty() || 0 == opts.checkin_count) {
+            return events;
+        }
+        const auto& stations = net["stations"];
+
+        std::mt19937_64 rng(opts.seed);
+        std::uniform_int_distribution<std::chrono::milliseconds::rep> offset_dist(0, opts.duration.count());
+        std::uniform_int_distribution<std::chrono::milliseconds::rep> ack_dist(1000, std::max<std::chrono::milliseconds::rep>(1000, opts.max_ack_delay.count()));
+        std::bernoulli_distribution relay_dist(opts.relay_ratio);
+        std::bernoulli_distribution ack_ratio_dist(opts.ack_ratio);
+
+        // Walk a shuffled roster so every station checks in before any repeats
+        std::vector<std::size_t> order(stations.size());
+        std::ranges::iota(order, 0UZ);
+        std::ranges::shuffle(order, rng);
+
+        events.reserve(opts.checkin_count * 2);
+        for (auto i = 0UZ; i < opts.checkin_count; ++i) {
+            const auto& callsign = stations[order[i % order.size()]]["callsign"].get_ref<const std::string&>();
+            auto offset = std::chrono::milliseconds(offset_dist(rng));
+            auto status = relay_dist(rng) ? StationStatus::HEARD_RELAY : StationStatus::HEARD_DIRECT;
+            events.emplace_back(offset, callsign, status, false);
+            if (ack_ratio_dist(rng)) {
+                events.emplace_back(offset + std::chrono::milliseconds(ack_dist(rng)), callsign, status, true);
+            }
+        }
+        std::ranges::stable_sort(events, {}, &CheckinEvent::offset);
+        return events;
+    }
+
+    nlohmann::json
+    checkins_to_json(std::span<const CheckinEvent> events)
+    {
+        auto json = nlohmann::json::array();
+        for (const auto& e : events) {
+            json.push_back({ { "offset_ms", e.offset.count() },
+                             { "callsign", e.callsign },
+                             { "status", magic_enum::enum_name(e.status) },
+                             { "acknowledged", e.acknowledged } });
+        }
+        return json;
+    }
+
+    std::vector<CheckinEvent>
+    checkins_from_json(const nlohmann::json& j)
+    {
+        std::vector<CheckinEvent> events;
+        events.reserve(j.size());
+        for (const auto& e : j) {
+            auto status = magic_enum::enum_cast<StationStatus>(e.value("status", ""s)).value_or(StationStatus::HEARD_DIRECT);
+            events.emplace_back(std::chrono::milliseconds(e.value("offset_ms", 0LL)),
+                                e.value("callsign", ""s),
+                                status,
+                                e.value("acknowledged", false));
+        }
+        std::ranges::stable_sort(events, {}, &CheckinEvent::offset);
+        return events;
+    }
+
+} // namespace mnn
@@ -0,0 +1,93 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "station_status.hpp"
+
+namespace mnn
+{
+    /* Callsign shapes, named the way the FCC does: prefix letters x suffix
+     * letters, e.g. 1x2 is K6AB and 2x3 is KI6KVZ. */
+    enum class CallsignFormat
+    {
+        ONE_BY_ONE,
+        ONE_BY_TWO,
+        ONE_BY_THREE,
+        TWO_BY_ONE,
+        TWO_BY_TWO,
+        TWO_BY_THREE,
+    };
+
+    struct GeneratorOptions
+    {
+        std::size_t station_count = 60;
+        std::size_t column_count = 4;
+        std::vector<std::pair<CallsignFormat, double>> formats = {
+            { CallsignFormat::ONE_BY_TWO, 1.0 },
+            { CallsignFormat::ONE_BY_THREE, 2.0 },
+            { CallsignFormat::TWO_BY_ONE, 0.5 },
+            { CallsignFormat::TWO_BY_TWO, 1.0 },
+            { CallsignFormat::TWO_BY_THREE, 6.0 },
+        };
+        // When false only US prefixes (K, N, W, AA-AL) are generated
+        bool itu_prefixes = false;
+        double aec_ratio = 0.1;
+        double location_ratio = 0.5;
+        double center_latitude = 37.39;
+        double center_longitude = -122.08;
+        double radius_degrees = 0.25;
+        std::vector<std::string> totals = { "North", "South", "East", "West", "Guests", "UHF", "Packet" };
+        std::uint64_t seed = 0;
+    };
+
+    struct CheckinOptions
+    {
+        std::chrono::milliseconds duration = std::chrono::hours(2);
+        std::size_t checkin_count = 3000;
+        double relay_ratio = 0.2;
+        double ack_ratio = 0.9;
+        std::chrono::milliseconds max_ack_delay = std::chrono::seconds(30);
+        std::uint64_t seed = 0;
+    };
+
+    struct CheckinEvent
+    {
+        std::chrono::milliseconds offset;
+        std::string callsign;
+        StationStatus status;
+        bool acknowledged;
+    };
+
+    [[nodiscard]] nlohmann::json generate_net(const GeneratorOptions&);
+
+    /* Check-ins against the stations of an already generated (or real) net
+     * definition, sorted by offset from the start of the net. */
+    [[nodiscard]] std::vector<CheckinEvent> generate_checkins(const nlohmann::json& net, const CheckinOptions&);
+
+    [[nodiscard]] nlohmann::json checkins_to_json(std::span<const CheckinEvent>);
+    [[nodiscard]] std::vector<CheckinEvent> checkins_from_json(const nlohmann::json&);
+
+} // namespace mnn
@@ -0,0 +1,313 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <ranges>
+#include "mnn.hpp"
+#include "metrics.hpp"
+#include "mnn_error.hpp"
+#include "net_library.hpp"
+
+namespace
+{
+    std::error_code
+    validate_net(const nlohmann::json& j)
+    {
+        if (!j.contains("meta") || !j["meta"].contains("version") || 1 != j["meta"]["version"]) {
+            return std::make_error_code(mnn::error::invalid_net_version);
+        }
+        if (!j.contains("columns") || !j["columns"].is_array()) {
+            return std::make_error_code(mnn::error::missing_columns);
+        }
+        return {};
+    }
+
+    const nlohmann::json&
+    stations_of(const nlohmann::json& j)
+    {
+        static const auto empty = nlohmann::json::array();
+        return j.contains("stations") ? j["stations"] : empty;
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    using namespace peel;
+
+    Station*
+    Net::find(std::string_view callsign) const
+    {
+        auto it = by_callsign.find(std::string(callsign));
+        return by_callsign.end() == it ? nullptr : static_cast<Station*>(it->second);
+    }
+
+    std::expected<std::shared_ptr<Net>, std::error_code>
+    parse_net(std::string id, const nlohmann::json& j)
+    {
+        if (auto ec = validate_net(j)) {
+            return std::unexpected(ec);
+        }
+
+        auto net = std::make_shared<Net>();
+        net->id = std::move(id);
+        net->meta = j["meta"];
+        for (const auto& col : j["columns"]) {
+            auto begin = col.find("begin");
+            auto end = col.find("end");
+            if (col.end() == begin || col.end() == end || !begin->is_string() || !end->is_string() ||
+                begin->get_ref<const std::string&>().empty() || end->get_ref<const std::string&>().empty()) {
+                continue;
+            }
+            net->columns.emplace_back(begin->get<std::string>(), end->get<std::string>());
+        }
+        if (net->columns.empty()) {
+            return std::unexpected(std::make_error_code(error::no_valid_columns));
+        }
+        if (auto totals = j.find("totals"); j.end() != totals && totals->is_array()) {
+            for (const auto& t : *totals) {
+                if (t.is_string()) net->totals.push_back(t.get<std::string>());
+            }
+        }
+
+        net->arena = std::make_shared<RosterArena>();
+        auto imported = import_stations(stations_of(j), net->arena);
+        net->stations = Gio::ListStore::create(Type::of<Station>());
+        net->by_callsign.reserve(imported.stations.size());
+        for (auto& station : imported.stations) {
+            net->stations->append(station);
+            net->by_callsign.emplace(station->get_callsign(), std::move(station));
+        }
+        net->diagnostics = std::move(imported.diagnostics);
+        net->updates = std::make_unique<UpdateDispatcher>(*net);
+        return net;
+    }
+
+    RosterPatch
+    patch_roster(Net& net, const nlohmann::json& stations)
+    {
+        // Plain records first; only new stations become Stations and touch the arena
+        auto roster = read_roster(stations);
+        RosterPatch patch{ .diagnostics = std::move(roster.diagnostics) };
+        const auto& records = roster.records;
+
+        std::unordered_map<std::string_view, std::size_t> incoming;
+        incoming.reserve(records.size());
+        for (auto [i, record] : std::views::enumerate(records)) {
+            incoming.emplace(record.callsign, i);
+        }
+
+        // Position after removals of each incoming station already in the store
+        constexpr auto absent = static_cast<std::size_t>(-1);
+        std::vector<std::size_t> position(records.size(), absent);
+        // (position, count) in the original store
+        std::vector<std::pair<unsigned, unsigned>> removals;
+        auto model = net.stations->cast<Gio::ListModel>();
+        auto n_items = model->get_n_items();
+        for (auto i = 0U; i < n_items; ++i) {
+            RefPtr<Object> item = model->get_item(i);
+            auto station = item->cast<Station>();
+            auto callsign = station->get_callsign();
+            auto it = incoming.find(callsign);
+            if (incoming.end() == it || absent != position[it->second]) {
+                if (!removals.empty() && removals.back().first + removals.back().second == i) {
+                    ++removals.back().second;
+                } else {
+                    removals.emplace_back(i, 1);
+                }
+                if (auto live = net.by_callsign.find(callsign); net.by_callsign.end() != live && static_cast<Station*>(live->second) == station) {
+                    net.by_callsign.erase(live);
+                }
+                ++patch.removed;
+                continue;
+            }
+            position[it->second] = i - patch.removed;
+            if (station->update_roster_fields(records[it->second])) {
+                ++patch.updated;
+            }
+        }
+
+        auto store = reinterpret_cast<GListStore*>(static_cast<Gio::ListStore*>(net.stations));
+        for (auto [pos, count] : removals | std::views::reverse) {
+            g_list_store_splice(store, pos, count, nullptr, 0);
+        }
+
+        // Runs of new stations, each anchored after the survivor preceding it
+        struct Run { std::size_t anchor; std::vector<gpointer> stations; };
+        std::vector<Run> runs;
+        std::size_t anchor = 0;
+        for (auto [i, record] : std::views::enumerate(records)) {
+            if (absent != position[i]) {
+                anchor = position[i] + 1;
+                continue;
+            }
+            if (runs.empty() || runs.back().anchor != anchor) {
+                runs.push_back({ anchor, {} });
+            }
+            auto station = Station::create(record, net.arena);
+            runs.back().stations.push_back(static_cast<Station*>(station));
+            net.by_callsign.insert_or_assign(std::string(record.callsign), std::move(station));
+        }
+        std::ranges::sort(runs, std::ranges::greater{}, &Run::anchor);
+        for (auto& run : runs) {
+            // by_callsign holds the new stations' references
+            g_list_store_splice(store, run.anchor, 0, run.stations.data(), run.stations.size());
+            patch.inserted += run.stations.size();
+        }
+        return patch;
+    }
+
+    std::expected<RosterPatch, std::error_code>
+    reload_net(Net& net)
+    {
+        std::ifstream file{net.id};
+        auto j = nlohmann::json::parse(file, nullptr, false);
+        if (!file || j.is_discarded()) {
+            return std::unexpected(std::make_error_code(error::unreadable_net));
+        }
+        if (auto ec = validate_net(j)) {
+            return std::unexpected(ec);
+        }
+        auto patch = patch_roster(net, stations_of(j));
+        net.meta = j["meta"];
+        net.diagnostics = patch.diagnostics;
+        return patch;
+    }
+
+    void
+    NetLibrary::watch(const std::shared_ptr<Net>& net)
+    {
+        auto file = Gio::File::new_for_path(net->id.c_str());
+        UniquePtr<GLib::Error> err;
+        net->monitor = file->monitor_file(Gio::FileMonitorFlags::NONE, nullptr, &err);
+        if (!net->monitor) {
+            g_warning("Unable to watch %s for changes: %s", net->id.c_str(), err ? err->message : "");
+            return;
+        }
+        net->monitor->connect_changed([weak = std::weak_ptr(net)](Gio::FileMonitor*, Gio::File*, Gio::File*, Gio::FileMonitorEvent event) {
+            // Editors that save by rename show up as CREATED
+            if (Gio::FileMonitorEvent::CHANGES_DONE_HINT != event && Gio::FileMonitorEvent::CREATED != event) {
+                return;
+            }
+            auto net = weak.lock();
+            if (!net) return;
+            auto patch = reload_net(*net);
+            if (!patch) {
+                g_warning("Not reloading %s: %s", net->id.c_str(), patch.error().message().c_str());
+                return;
+            }
+            g_message("Reloaded %s: %zu added, %zu removed, %zu updated, %zu invalid",
+                      net->id.c_str(), patch->inserted, patch->removed, patch->updated, patch->diagnostics.size());
+        });
+    }
+
+    NetLibrary::NetLibrary(std::size_t capacity) :
+        capacity(std::max(capacity, 1UZ))
+    {
+    }
+
+    void
+    NetLibrary::touch(const std::shared_ptr<Net>& net)
+    {
+        if (auto it = std::ranges::find(recent, net); recent.end() != it) {
+            recent.splice(recent.begin(), recent, it);
+        } else {
+            recent.push_front(net);
+        }
+        while (recent.size() > capacity) {
+            recent.pop_back();
+        }
+    }
+
+    void
+    NetLibrary::set_capacity(std::size_t new_capacity)
+    {
+        capacity = std::max(new_capacity, 1UZ);
+        while (recent.size() > capacity) {
+            recent.pop_back();
+        }
+    }
+
+    std::shared_ptr<Net>
+    NetLibrary::find(std::string_view id)
+    {
+        auto it = live.find(std::string(id));
+        if (live.end() == it) return nullptr;
+        auto net = it->second.lock();
+        if (!net) {
+            live.erase(it);
+            return nullptr;
+        }
+        touch(net);
+        return net;
+    }
+
+    std::expected<std::shared_ptr<Net>, std::error_code>
+    load_net(std::string_view id, std::optional<std::string_view> contents)
+    {
+        static auto& load_time = metrics().histogram("mnn_roster_load_seconds", "Time to read and parse a net definition and build its roster");
+        static auto& loaded = metrics().gauge("mnn_stations_loaded", "Stations in the most recently loaded roster");
+        ScopedTimer timer(load_time);
+        bool builtin = id.empty() || "default-net.json" == id;
+        nlohmann::json j;
+        if (contents) {
+            j = nlohmann::json::parse(*contents, nullptr, false);
+        } else if (builtin) {
+            j = get_default_net();
+        } else {
+            std::ifstream file{std::string(id)};
+            if (!file) {
+                return std::unexpected(std::make_error_code(error::unreadable_net));
+            }
+            j = nlohmann::json::parse(file, nullptr, false);
+        }
+        if (j.is_discarded()) {
+            return std::unexpected(std::make_error_code(error::unreadable_net));
+        }
+
+        auto net = parse_net(std::string(builtin ? "default-net.json" : id), j);
+        if (net) {
+            loaded.set(static_cast<std::int64_t>((*net)->by_callsign.size()));
+        }
+        return net;
+    }
+
+    std::shared_ptr<Net>
+    NetLibrary::adopt(std::shared_ptr<Net> net)
+    {
+        // Two loads of one file raced; the first one in wins
+        if (auto existing = find(net->id)) {
+            return existing;
+        }
+        if ("default-net.json" != net->id) watch(net);
+        live.insert_or_assign(net->id, net);
+        touch(net);
+        return net;
+    }
+
+    std::expected<std::shared_ptr<Net>, std::error_code>
+    NetLibrary::open(std::string_view id)
+    {
+        if (auto net = find(id)) {
+            return net;
+        }
+        return load_net(id).transform([this](auto net) { return adopt(std::move(net)); });
+    }
+
+} // namespace mnn
@@ -0,0 +1,132 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <expected>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+#include <peel/Gio/Gio.h>
+#include <nlohmann/json.hpp>
+#include "aprs_ingest.hpp"
+#include "daemon_link.hpp"
+#include "net_replicator.hpp"
+#include "roster_import.hpp"
+#include "station.hpp"
+#include "status_board_link.hpp"
+#include "update_dispatcher.hpp"
+
+namespace mnn
+{
+    struct NetColumn
+    {
+        std::string begin;
+        std::string end;
+    };
+
+    /* A parsed net definition and its live roster. Every window showing the
+     * net shares the one instance, so station state is shared too. */
+    struct Net
+    {
+        std::string id;
+        nlohmann::json meta;
+        std::vector<std::string> totals;
+        std::vector<NetColumn> columns;
+        peel::RefPtr<peel::Gio::ListStore> stations;
+        std::unordered_map<std::string, peel::RefPtr<Station>> by_callsign;
+        std::vector<ImportDiagnostic> diagnostics;
+        // Stations added by a reload come from the same arena
+        std::shared_ptr<RosterArena> arena;
+        // Set for nets loaded from a file
+        peel::RefPtr<peel::Gio::FileMonitor> monitor;
+        // Off-thread station changes; declared before its producers so it outlives them
+        std::unique_ptr<UpdateDispatcher> updates;
+        // Set while replication-enabled; declared last so it detaches first
+        std::unique_ptr<NetReplicator> replicator;
+        // Set when the daemon-socket setting names a running daemon
+        std::unique_ptr<DaemonLink> daemon_link;
+        // Set when the aprs-source setting is not empty
+        std::unique_ptr<AprsIngest> aprs;
+        // Set while status-board-enabled
+        std::unique_ptr<StatusBoardLink> status_board;
+
+        [[nodiscard]] Station* find(std::string_view callsign) const;
+    };
+
+    struct RosterPatch
+    {
+        std::size_t inserted = 0;
+        std::size_t removed = 0;
+        std::size_t updated = 0;
+        std::vector<ImportDiagnostic> diagnostics;
+    };
+
+    [[nodiscard]] std::expected<std::shared_ptr<Net>, std::error_code> parse_net(std::string id, const nlohmann::json&);
+
+    /* Brings the live roster in line with a new "stations" array, keyed by
+     * callsign. Existing stations keep their status and acknowledgement;
+     * only inserts, removals and changed roster fields touch the store,
+     * with one splice per contiguous run. Stations are inserted after
+     * the station preceding them in the new array. */
+    RosterPatch patch_roster(Net&, const nlohmann::json& stations);
+
+    /* Reads and parses a net without registering it anywhere, so it may run
+     * off the main thread; NetLibrary::adopt() it afterwards. contents is
+     * the already read file, otherwise the file (or built in net) is read
+     * here. */
+    [[nodiscard]] std::expected<std::shared_ptr<Net>, std::error_code> load_net(std::string_view id, std::optional<std::string_view> contents = {});
+
+    // Re-reads a file backed net and patches its roster
+    [[nodiscard]] std::expected<RosterPatch, std::error_code> reload_net(Net&);
+
+    /* Owned by the Application. Nets in use by any window stay live; the
+     * most recently opened ones are also kept parsed up to capacity, so
+     * switching back to them does not touch the disk.
+     *
+     * The id "default-net.json" names the built in net, anything else is a
+     * file path. */
+    class NetLibrary
+    {
+    public:
+        explicit NetLibrary(std::size_t capacity = 4);
+
+        // Loads on the calling thread when the net isn't live or cached
+        [[nodiscard]] std::expected<std::shared_ptr<Net>, std::error_code> open(std::string_view id);
+        // Registers a net from load_net(), or returns the live one with its id
+        [[nodiscard]] std::shared_ptr<Net> adopt(std::shared_ptr<Net>);
+        // Live or cached only, never loads
+        [[nodiscard]] std::shared_ptr<Net> find(std::string_view id);
+        void set_capacity(std::size_t capacity);
+
+    private:
+        void touch(const std::shared_ptr<Net>&);
+        static void watch(const std::shared_ptr<Net>&);
+
+        std::size_t capacity;
+        std::unordered_map<std::string, std::weak_ptr<Net>> live;
+        // Most recently used first
+        std::list<std::shared_ptr<Net>> recent;
+    };
+
+} // namespace mnn
@@ -0,0 +1,305 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include "mnn_error.hpp"
+#include "net_library.hpp"
+#include "net_replicator.hpp"
+
+namespace
+{
+    std::uint64_t
+    now_ms()
+    {
+        return static_cast<std::uint64_t>(g_get_real_time() / 1000);
+    }
+
+    // Instances with a different net open share the group; the tag keeps them apart
+    std::uint32_t
+    fnv1a(std::string_view s)
+    {
+        std::uint32_t h = 2166136261u;
+        for (auto c : s) {
+            h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+        }
+        return h;
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    using namespace peel;
+
+    NetReplicator::NetReplicator(Net& net, ReplicationOptions options) :
+        net(net),
+        options(std::move(options)),
+        state(g_random_int()),
+        net_tag(fnv1a(net.meta.dump()))
+    {
+    }
+
+    NetReplicator::~NetReplicator()
+    {
+        stop();
+    }
+
+    std::error_code
+    NetReplicator::start()
+    {
+        stop();
+        GError* err = nullptr;
+        auto fail = [this, &err](const char* what) {
+            g_warning("Replication disabled, %s: %s", what, err ? err->message : "");
+            g_clear_error(&err);
+            stop();
+            return std::make_error_code(error::replication_socket_failed);
+        };
+
+        auto group = g_inet_address_new_from_string(options.group.c_str());
+        if (!group) {
+            return fail("bad multicast group");
+        }
+        destination = g_inet_socket_address_new(group, options.port);
+        socket = g_socket_new(G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM, G_SOCKET_PROTOCOL_UDP, &err);
+        if (!socket) {
+            g_object_unref(group);
+            return fail("socket");
+        }
+        auto any = g_inet_address_new_any(G_SOCKET_FAMILY_IPV4);
+        auto local = g_inet_socket_address_new(any, options.port);
+        // allow_reuse so several instances on one host can share the port
+        auto bound = g_socket_bind(socket, local, TRUE, &err) &&
+                     g_socket_join_multicast_group(socket, group, FALSE, nullptr, &err);
+        g_object_unref(local);
+        g_object_unref(any);
+        g_object_unref(group);
+        if (!bound) {
+            return fail("bind");
+        }
+        g_socket_set_multicast_loopback(socket, TRUE);
+        g_socket_set_multicast_ttl(socket, 1);
+        g_socket_set_blocking(socket, FALSE);
+
+        source = g_socket_create_source(socket, G_IO_IN, nullptr);
+        g_source_set_callback(source, reinterpret_cast<GSourceFunc>(&NetReplicator::on_readable), this, nullptr);
+        g_source_attach(source, nullptr);
+
+        watch.start(net, { "notify::status", "notify::is-acknowledged", "notify::has-location" },
+                    G_CALLBACK(&NetReplicator::on_notify), this,
+                    [this](guint position, guint, guint added) {
+                        for (const auto& station : watch.stations().subspan(position, added)) {
+                            catch_up(static_cast<Station*>(station));
+                        }
+                    });
+        for (const auto& ref : watch.stations()) {
+            auto station = static_cast<Station*>(ref);
+            catch_up(station);
+            // Check-ins logged before replication was turned on
+            if (StationStatus::PENDING != station->get_status()) {
+                record(station, ReplicatedField::STATUS);
+            }
+            if (station->is_acknowledged()) {
+                record(station, ReplicatedField::ACKNOWLEDGED);
+            }
+        }
+        anti_entropy_id = g_timeout_add(static_cast<guint>(options.anti_entropy_interval.count()), &NetReplicator::on_anti_entropy, this);
+        return {};
+    }
+
+    void
+    NetReplicator::stop()
+    {
+        watch.stop();
+        if (0 != flush_id) {
+            g_source_remove(flush_id);
+            flush_id = 0;
+        }
+        if (0 != anti_entropy_id) {
+            g_source_remove(anti_entropy_id);
+            anti_entropy_id = 0;
+        }
+        if (source) {
+            g_source_destroy(source);
+            g_source_unref(source);
+            source = nullptr;
+        }
+        g_clear_object(&socket);
+        g_clear_object(&destination);
+        pending.clear();
+    }
+
+    void
+    NetReplicator::catch_up(Station* station)
+    {
+        // A station added by a reload may already have replicated state
+        if (auto callsign = station->get_callsign(); !callsign.empty()) {
+            for (auto field : { ReplicatedField::STATUS, ReplicatedField::ACKNOWLEDGED, ReplicatedField::LOCATION }) {
+                if (auto reg = state.find(callsign, field)) {
+                    apply({ callsign, field, *reg });
+                }
+            }
+        }
+    }
+
+    void
+    NetReplicator::on_notify(GObject* object, GParamSpec* pspec, gpointer data)
+    {
+        auto self = static_cast<NetReplicator*>(data);
+        if (self->applying) return;
+        auto field = ReplicatedField::LOCATION;
+        if (0 == std::strcmp(pspec->name, "status")) {
+            field = ReplicatedField::STATUS;
+        } else if (0 == std::strcmp(pspec->name, "is-acknowledged")) {
+            field = ReplicatedField::ACKNOWLEDGED;
+        }
+        self->record(reinterpret_cast<Station*>(object), field);
+    }
+
+    void
+    NetReplicator::record(Station* station, ReplicatedField field)
+    {
+        auto callsign = station->get_callsign();
+        switch (field) {
+            case ReplicatedField::STATUS:
+                state.record(callsign, field, static_cast<std::uint8_t>(station->get_status()), now_ms());
+                break;
+            case ReplicatedField::ACKNOWLEDGED:
+                state.record(callsign, field, station->is_acknowledged(), now_ms());
+                break;
+            case ReplicatedField::LOCATION:
+                state.record(callsign, field, station->has_location(), now_ms(),
+                             station->get_latitude(), station->get_longitude());
+                break;
+        }
+        pending.emplace_back(std::move(callsign), field);
+        schedule_flush();
+    }
+
+    void
+    NetReplicator::apply(const Delta& d)
+    {
+        auto station = net.find(d.callsign);
+        if (!station) return;
+        applying = true;
+        switch (d.field) {
+            case ReplicatedField::STATUS:
+                if (d.reg.value <= static_cast<std::uint8_t>(StationStatus::HEARD_RELAY) &&
+                    station->get_status() != static_cast<StationStatus>(d.reg.value)) {
+                    station->set_status(static_cast<StationStatus>(d.reg.value));
+                }
+                break;
+            case ReplicatedField::ACKNOWLEDGED:
+                if (station->is_acknowledged() != static_cast<bool>(d.reg.value)) {
+                    station->set_is_acknowledged(d.reg.value);
+                }
+                break;
+            case ReplicatedField::LOCATION:
+                if (d.reg.value) {
+                    station->set_location(from_microdegrees(d.reg.latitude_udeg), from_microdegrees(d.reg.longitude_udeg));
+                } else if (station->has_location()) {
+                    station->set_location(SHUMATE_MIN_LATITUDE, SHUMATE_MIN_LONGITUDE);
+                }
+                break;
+        }
+        applying = false;
+    }
+
+    void
+    NetReplicator::schedule_flush()
+    {
+        if (0 == flush_id && socket) {
+            flush_id = g_timeout_add(static_cast<guint>(options.flush_interval.count()), &NetReplicator::on_flush, this);
+        }
+    }
+
+    gboolean
+    NetReplicator::on_flush(gpointer data)
+    {
+        auto self = static_cast<NetReplicator*>(data);
+        self->flush_id = 0;
+        // A station edited several times since the last flush is sent once
+        std::ranges::sort(self->pending);
+        auto [first, last] = std::ranges::unique(self->pending);
+        self->pending.erase(first, last);
+
+        std::vector<Delta> deltas;
+        deltas.reserve(self->pending.size());
+        for (auto& [callsign, field] : self->pending) {
+            if (auto reg = self->state.find(callsign, field)) {
+                deltas.push_back({ std::move(callsign), field, *reg });
+            }
+        }
+        self->pending.clear();
+        self->send(deltas);
+        return G_SOURCE_REMOVE;
+    }
+
+    gboolean
+    NetReplicator::on_anti_entropy(gpointer data)
+    {
+        auto self = static_cast<NetReplicator*>(data);
+        self->send(self->state.snapshot());
+        return G_SOURCE_CONTINUE;
+    }
+
+    void
+    NetReplicator::send(std::span<const Delta> deltas)
+    {
+        while (!deltas.empty() && socket) {
+            auto consumed = encode_batch(deltas, net_tag, state.node(), buffer);
+            GError* err = nullptr;
+            if (g_socket_send_to(socket, destination, reinterpret_cast<const gchar*>(buffer.data()), buffer.size(), nullptr, &err) < 0) {
+                // Datagrams are best effort; anti-entropy resends
+                g_debug("Replication send failed: %s", err->message);
+                g_clear_error(&err);
+            }
+            deltas = deltas.subspan(consumed);
+        }
+    }
+
+    gboolean
+    NetReplicator::on_readable(GSocket* socket, GIOCondition, gpointer data)
+    {
+        auto self = static_cast<NetReplicator*>(data);
+        std::array<std::byte, 65536> datagram;
+        for (;;) {
+            GError* err = nullptr;
+            auto n = g_socket_receive(socket, reinterpret_cast<gchar*>(datagram.data()), datagram.size(), nullptr, &err);
+            if (n < 0) {
+                g_clear_error(&err);
+                break;
+            }
+            auto batch = decode_batch(std::span(datagram).first(static_cast<std::size_t>(n)));
+            if (!batch || batch->net_tag != self->net_tag || batch->sender == self->state.node()) {
+                continue;
+            }
+            auto now = now_ms();
+            for (const auto& d : batch->deltas) {
+                if (self->state.merge(d, now)) {
+                    self->apply(d);
+                }
+            }
+        }
+        return G_SOURCE_CONTINUE;
+    }
+
+} // namespace mnn
@@ -0,0 +1,97 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <gio/gio.h>
+#include "replica_state.hpp"
+#include "station.hpp"
+#include "station_watch.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    struct ReplicationOptions
+    {
+        // Administratively scoped, stays on the LAN
+        std::string group = "239.255.73.1";
+        std::uint16_t port = 7373;
+        // Local edits are held this long so bursts go out as one datagram
+        std::chrono::milliseconds flush_interval{10};
+        // Full state is re-sent this often to heal lost datagrams and catch up late joiners
+        std::chrono::milliseconds anti_entropy_interval{5000};
+    };
+
+    /* Keeps the status, acknowledgement and location of a net's Stations
+     * in sync with every other instance on the LAN that has the same net
+     * open. There is no server: each instance multicasts its own edits and
+     * merges everyone else's through a ReplicaState.
+     *
+     * Several instances on one host work too (multicast loopback with a
+     * shared port), which is how it is load tested. */
+    class NetReplicator
+    {
+    public:
+        NetReplicator(Net& net, ReplicationOptions options);
+        ~NetReplicator();
+        NetReplicator(const NetReplicator&) = delete;
+        NetReplicator& operator=(const NetReplicator&) = delete;
+
+        std::error_code start();
+        void stop();
+
+    private:
+        static void on_notify(GObject* station, GParamSpec* pspec, gpointer self);
+        static gboolean on_readable(GSocket* socket, GIOCondition condition, gpointer self);
+        static gboolean on_flush(gpointer self);
+        static gboolean on_anti_entropy(gpointer self);
+
+        // Applies state already replicated for a station that just joined the net
+        void catch_up(Station*);
+        void record(Station*, ReplicatedField);
+        void apply(const Delta&);
+        void send(std::span<const Delta>);
+        void schedule_flush();
+
+        Net& net;
+        ReplicationOptions options;
+        ReplicaState state;
+        std::uint32_t net_tag;
+        // Fields edited locally since the last flush
+        std::vector<std::pair<std::string, ReplicatedField>> pending;
+        StationWatch watch;
+        std::vector<std::byte> buffer;
+        // Set while applying a remote delta so the notify isn't echoed back
+        bool applying = false;
+        GSocket* socket = nullptr;
+        GSocketAddress* destination = nullptr;
+        GSource* source = nullptr;
+        guint flush_id = 0;
+        guint anti_entropy_id = 0;
+    };
+
+} // namespace mnn
@@ -0,0 +1,127 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "net_session.hpp"
+#include "replica_state.hpp"
+#include "station_record.hpp"
+#include <utility>
+
+namespace mnn
+{
+    NetSession::NetSession(const nlohmann::json& net)
+    {
+        auto stations = net.find("stations");
+        if (net.end() == stations) {
+            return;
+        }
+        // The same rules import_stations() applies for the GUI
+        auto records = read_roster(*stations);
+        skipped_records = records.diagnostics.size();
+        roster.reserve(records.records.size());
+        for (const auto& record : records.records) {
+            auto& st = roster.emplace_back(std::string(record.callsign), std::string(record.name));
+            if (record.location) {
+                st.has_location = true;
+                st.latitude_udeg = to_microdegrees(record.location->first);
+                st.longitude_udeg = to_microdegrees(record.location->second);
+            }
+        }
+        // Views into roster, which no longer reallocates; callsigns are unique
+        index.reserve(roster.size());
+        for (auto i = 0U; i < roster.size(); ++i) {
+            index.emplace(roster[i].callsign, i);
+        }
+        dirty.resize(roster.size());
+    }
+
+    StationState*
+    NetSession::lookup(std::string_view callsign)
+    {
+        auto it = index.find(callsign);
+        return index.end() == it ? nullptr : &roster[it->second];
+    }
+
+    const StationState*
+    NetSession::find(std::string_view callsign) const
+    {
+        auto it = index.find(callsign);
+        return index.end() == it ? nullptr : &roster[it->second];
+    }
+
+    void
+    NetSession::changed(const StationState& st)
+    {
+        auto i = static_cast<std::uint32_t>(&st - roster.data());
+        if (!dirty[i]) {
+            dirty[i] = true;
+            changes.push_back(i);
+        }
+    }
+
+    bool
+    NetSession::check_in(std::string_view callsign, StationStatus status)
+    {
+        auto st = lookup(callsign);
+        if (!st) return false;
+        if (st->status != status) {
+            st->status = status;
+            changed(*st);
+        }
+        return true;
+    }
+
+    bool
+    NetSession::acknowledge(std::string_view callsign, bool acknowledged)
+    {
+        auto st = lookup(callsign);
+        if (!st) return false;
+        auto status = status_after_acknowledge(st->status);
+        if (st->acknowledged != acknowledged || st->status != status) {
+            st->acknowledged = acknowledged;
+            st->status = status;
+            changed(*st);
+        }
+        return true;
+    }
+
+    bool
+    NetSession::set_location(std::string_view callsign, std::optional<std::pair<std::int32_t, std::int32_t>> udeg)
+    {
+        auto st = lookup(callsign);
+        if (!st) return false;
+        auto [lat, lon] = udeg.value_or(std::pair{ 0, 0 });
+        if (st->has_location != udeg.has_value() || st->latitude_udeg != lat || st->longitude_udeg != lon) {
+            st->has_location = udeg.has_value();
+            st->latitude_udeg = lat;
+            st->longitude_udeg = lon;
+            changed(*st);
+        }
+        return true;
+    }
+
+    std::vector<std::uint32_t>
+    NetSession::take_changes()
+    {
+        for (auto i : changes) {
+            dirty[i] = false;
+        }
+        return std::exchange(changes, {});
+    }
+
+} // namespace mnn
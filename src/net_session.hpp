@@ -0,0 +1,68 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "station_state.hpp"
+#include "station_status.hpp"
+
+namespace mnn
+{
+    /* The roster and check-in state of one net with no GTK or GObject in
+     * sight, for the daemon and anything else headless. Follows the same
+     * rules as Station. Every change is queued by index so callers can
+     * fan changes out in batches. */
+    class NetSession
+    {
+    public:
+        // Loads the valid records of a net definition; invalid ones are counted in skipped()
+        explicit NetSession(const nlohmann::json& net);
+
+        // Each returns false for unknown callsigns. Setting the current value is not a change.
+        bool check_in(std::string_view callsign, StationStatus);
+        bool acknowledge(std::string_view callsign, bool acknowledged);
+        bool set_location(std::string_view callsign, std::optional<std::pair<std::int32_t, std::int32_t>> udeg);
+
+        [[nodiscard]] const StationState* find(std::string_view callsign) const;
+        [[nodiscard]] std::span<const StationState> stations() const { return roster; }
+        [[nodiscard]] std::size_t skipped() const { return skipped_records; }
+
+        // Indexes into stations() changed since the last call, each once
+        [[nodiscard]] std::vector<std::uint32_t> take_changes();
+
+    private:
+        StationState* lookup(std::string_view callsign);
+        void changed(const StationState&);
+
+        std::vector<StationState> roster;
+        std::unordered_map<std::string_view, std::uint32_t> index;
+        std::vector<std::uint32_t> changes;
+        std::vector<bool> dirty;
+        std::size_t skipped_records = 0;
+    };
+
+} // namespace mnn
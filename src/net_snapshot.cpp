@@ -0,0 +1,175 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <magic_enum/magic_enum.hpp>
+#include <nlohmann/json.hpp>
+#include "mnn_error.hpp"
+#include "net_snapshot.hpp"
+
+namespace
+{
+    constexpr int snapshot_version = 1;
+
+    // Status in the low bits, acknowledgement above them
+    constexpr unsigned ack_bit = 4;
+
+} // anonymous namespace
+
+namespace mnn
+{
+    std::size_t
+    NetSnapshot::size() const
+    {
+        std::size_t n = 0;
+        for (const auto& chunk : chunks) {
+            n += chunk->size();
+        }
+        return n;
+    }
+
+    void
+    SnapshotTable::reset(std::size_t n)
+    {
+        count = n;
+        auto chunk_count = (n + chunk_size - 1) / chunk_size;
+        chunks.assign(chunk_count, nullptr);
+        is_dirty.assign(chunk_count, true);
+        dirty.resize(chunk_count);
+        for (std::size_t c = 0; c < chunk_count; ++c) {
+            dirty[c] = c;
+        }
+    }
+
+    void
+    SnapshotTable::append(std::size_t n)
+    {
+        if (0 == n) return;
+        auto first = count;
+        count += n;
+        auto chunk_count = (count + chunk_size - 1) / chunk_size;
+        chunks.resize(chunk_count);
+        is_dirty.resize(chunk_count, false);
+        // The old last chunk grows too, if it was short
+        for (auto c = first / chunk_size; c < chunk_count; ++c) {
+            if (!is_dirty[c]) {
+                is_dirty[c] = true;
+                dirty.push_back(c);
+            }
+        }
+    }
+
+    void
+    SnapshotTable::mark(std::size_t index)
+    {
+        if (index >= count) return;
+        auto c = index / chunk_size;
+        if (!is_dirty[c]) {
+            is_dirty[c] = true;
+            dirty.push_back(c);
+        }
+    }
+
+    std::vector<std::uint8_t>
+    serialize_snapshot(const NetSnapshot& snapshot)
+    {
+        auto callsigns = nlohmann::json::array();
+        auto states = nlohmann::json::array();
+        // Flat index, latitude, longitude triples for located stations only
+        auto locations = nlohmann::json::array();
+        std::size_t index = 0;
+        for (const auto& chunk : snapshot.chunks) {
+            for (const auto& s : *chunk) {
+                callsigns.push_back(s.callsign);
+                states.push_back(static_cast<unsigned>(s.status) | (s.acknowledged ? ack_bit : 0U));
+                if (s.has_location) {
+                    locations.push_back(index);
+                    locations.push_back(s.latitude_udeg);
+                    locations.push_back(s.longitude_udeg);
+                }
+                ++index;
+            }
+        }
+        const auto& session = snapshot.session;
+        nlohmann::json j = {
+            { "version", snapshot_version },
+            { "net", session.net_id },
+            { "date", session.date },
+            { "frequency", session.frequency },
+            { "control_callsign", session.control_callsign },
+            { "control_name", session.control_name },
+            { "taken", snapshot.taken_unix_ms },
+            { "callsigns", std::move(callsigns) },
+            { "states", std::move(states) },
+            { "locations", std::move(locations) },
+        };
+        return nlohmann::json::to_cbor(j);
+    }
+
+    std::expected<NetSnapshot, std::error_code>
+    parse_snapshot(std::span<const std::uint8_t> bytes)
+    {
+        auto fail = [] { return std::unexpected(std::make_error_code(error::malformed_snapshot)); };
+        auto j = nlohmann::json::from_cbor(bytes, true, false);
+        if (j.is_discarded() || !j.is_object() || snapshot_version != j.value("version", 0)) {
+            return fail();
+        }
+        auto callsigns = j.find("callsigns");
+        auto states = j.find("states");
+        auto locations = j.find("locations");
+        if (j.end() == callsigns || j.end() == states || j.end() == locations ||
+            !callsigns->is_array() || !states->is_array() || !locations->is_array() ||
+            callsigns->size() != states->size() || 0 != locations->size() % 3) {
+            return fail();
+        }
+
+        NetSnapshot snapshot;
+        try {
+            snapshot.session = { .net_id = j.value("net", ""),
+                                 .date = j.value("date", ""),
+                                 .frequency = j.value("frequency", ""),
+                                 .control_callsign = j.value("control_callsign", ""),
+                                 .control_name = j.value("control_name", "") };
+            snapshot.taken_unix_ms = j.value("taken", std::int64_t{ 0 });
+            auto stations = std::make_shared<NetSnapshot::Chunk>();
+            stations->reserve(callsigns->size());
+            for (std::size_t i = 0; i < callsigns->size(); ++i) {
+                auto state = (*states)[i].get<unsigned>();
+                auto status = magic_enum::enum_cast<StationStatus>(static_cast<int>(state & ~ack_bit));
+                if (!status) return fail();
+                stations->push_back({ .callsign = (*callsigns)[i].get<std::string>(),
+                                      .status = *status,
+                                      .acknowledged = 0 != (state & ack_bit) });
+            }
+            for (std::size_t i = 0; i < locations->size(); i += 3) {
+                auto index = (*locations)[i].get<std::size_t>();
+                if (index >= stations->size()) return fail();
+                auto& station = (*stations)[index];
+                station.has_location = true;
+                station.latitude_udeg = (*locations)[i + 1].get<std::int32_t>();
+                station.longitude_udeg = (*locations)[i + 2].get<std::int32_t>();
+            }
+            snapshot.chunks.push_back(std::move(stations));
+        } catch (const nlohmann::json::exception&) {
+            // A field of the wrong type
+            return fail();
+        }
+        return snapshot;
+    }
+
+} // namespace mnn
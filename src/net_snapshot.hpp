@@ -0,0 +1,114 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "station_state.hpp"
+
+namespace mnn
+{
+    // What the operator typed into the window for this session
+    struct SessionInfo
+    {
+        std::string net_id;
+        std::string date;
+        std::string frequency;
+        std::string control_callsign;
+        std::string control_name;
+
+        bool operator==(const SessionInfo&) const = default;
+    };
+
+    /* The whole session at one instant; station names are left out, the
+     * net definition has them. Chunks are immutable and shared
+     * with the SnapshotTable that made them and with older snapshots, so
+     * a snapshot can be read on any thread while the roster carries on. */
+    struct NetSnapshot
+    {
+        using Chunk = std::vector<StationState>;
+
+        SessionInfo session;
+        std::int64_t taken_unix_ms = 0;
+        std::vector<std::shared_ptr<const Chunk>> chunks;
+
+        [[nodiscard]] std::size_t size() const;
+    };
+
+    /* Copy on write capture of a roster of count stations. Writers mark
+     * the stations they change; capture() rebuilds only the chunks holding
+     * marked stations and shares every other chunk with the last capture,
+     * so it costs O(changed) rather than O(roster). */
+    class SnapshotTable
+    {
+    public:
+        static constexpr std::size_t chunk_size = 256;
+
+        // Resizes to count stations, every one of them marked
+        void reset(std::size_t count);
+        // Adds n stations at the end, marked; the chunks before them stay shared
+        void append(std::size_t n);
+        void mark(std::size_t index);
+        [[nodiscard]] std::size_t dirty_chunks() const { return dirty.size(); }
+
+        /* read(i) returns the StationState of station i; it is called only
+         * for stations in marked chunks. */
+        template<std::invocable<std::size_t> Read>
+        [[nodiscard]] std::vector<std::shared_ptr<const NetSnapshot::Chunk>>
+        capture(Read&& read)
+        {
+            for (auto c : dirty) {
+                auto chunk = std::make_shared<NetSnapshot::Chunk>();
+                auto begin = c * chunk_size;
+                auto end = std::min(count, begin + chunk_size);
+                chunk->reserve(end - begin);
+                for (auto i = begin; i < end; ++i) {
+                    chunk->push_back(read(i));
+                }
+                chunks[c] = std::move(chunk);
+                is_dirty[c] = false;
+            }
+            dirty.clear();
+            return chunks;
+        }
+
+    private:
+        std::size_t count = 0;
+        std::vector<std::shared_ptr<const NetSnapshot::Chunk>> chunks;
+        std::vector<std::size_t> dirty;
+        std::vector<bool> is_dirty;
+    };
+
+    /* CBOR, with stations as parallel arrays so repeated keys cost
+     * nothing; small enough before compression that zlib has little
+     * left to do. */
+    [[nodiscard]] std::vector<std::uint8_t> serialize_snapshot(const NetSnapshot&);
+    // The stations come back as a single chunk
+    [[nodiscard]] std::expected<NetSnapshot, std::error_code> parse_snapshot(std::span<const std::uint8_t>);
+
+} // namespace mnn
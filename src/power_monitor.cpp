@@ -0,0 +1,106 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <ctime>
+#include "metrics.hpp"
+#include "power_monitor.hpp"
+
+namespace
+{
+    mnn::Counter&
+    wakeup_counter()
+    {
+        static auto& c = mnn::metrics().counter("mnn_main_loop_wakeups", "Main loop polls that could have slept and returned");
+        return c;
+    }
+
+    mnn::Gauge&
+    cpu_gauge()
+    {
+        static auto& g = mnn::metrics().gauge("mnn_process_cpu_milliseconds", "CPU time used by the process, all threads");
+        return g;
+    }
+
+    GPollFunc default_poll = nullptr;
+
+} // anonymous namespace
+
+namespace mnn
+{
+    void
+    PowerMonitor::install()
+    {
+        if (default_poll) return;
+        auto context = g_main_context_default();
+        default_poll = g_main_context_get_poll_func(context);
+        // Registered up front, not on the first wakeup or in noexcept cpu_time_us()
+        (void) wakeup_counter();
+        (void) cpu_gauge();
+        g_main_context_set_poll_func(context, &PowerMonitor::counting_poll);
+    }
+
+    gint
+    PowerMonitor::counting_poll(GPollFD* fds, guint nfds, gint timeout)
+    {
+        auto result = default_poll(fds, nfds, timeout);
+        // A zero timeout is the loop checking in while busy, not waking up
+        if (0 != timeout) wakeup_counter().add();
+        return result;
+    }
+
+    std::uint64_t
+    PowerMonitor::wakeups() noexcept
+    {
+        return wakeup_counter().get();
+    }
+
+    std::int64_t
+    PowerMonitor::cpu_time_us() noexcept
+    {
+        timespec ts{};
+        ::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+        auto us = static_cast<std::int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+        cpu_gauge().set(us / 1000);
+        return us;
+    }
+
+    PowerMonitor::PowerMonitor() :
+        last_time_us(g_get_monotonic_time()),
+        last_wakeups(wakeups()),
+        last_cpu_us(cpu_time_us())
+    {
+    }
+
+    PowerMonitor::Rates
+    PowerMonitor::sample()
+    {
+        auto now = g_get_monotonic_time();
+        auto w = wakeups();
+        auto cpu = cpu_time_us();
+        auto elapsed = static_cast<double>(std::max<gint64>(now - last_time_us, 1));
+        Rates rates{ .wakeups_per_second = static_cast<double>(w - last_wakeups) * 1e6 / elapsed,
+                     .cpu_percent = static_cast<double>(cpu - last_cpu_us) * 100.0 / elapsed };
+        last_time_us = now;
+        last_wakeups = w;
+        last_cpu_us = cpu;
+        return rates;
+    }
+
+} // namespace mnn
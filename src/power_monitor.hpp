@@ -0,0 +1,64 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <glib.h>
+
+namespace mnn
+{
+    /* Main loop wakeups and process CPU time, the two numbers that decide
+     * how long a laptop lasts at a field site. install() wraps the default
+     * main context's poll so every return from a poll that could have slept
+     * counts as a wakeup, in the mnn_main_loop_wakeups counter; CPU time
+     * goes to the mnn_process_cpu_milliseconds gauge as it is read. The
+     * worker threads (status board, APRS ingest, CW ingest) sleep until
+     * they have work, so they add no timer wakeups of their own.
+     *
+     * sample() gives rates since the previous sample (or construction),
+     * for a view that refreshes on its own timer; nothing here adds a
+     * wakeup. */
+    class PowerMonitor
+    {
+    public:
+        struct Rates
+        {
+            double wakeups_per_second;
+            // Of one core
+            double cpu_percent;
+        };
+
+        // Main thread, once, before any of the rest
+        static void install();
+        [[nodiscard]] static std::uint64_t wakeups() noexcept;
+        [[nodiscard]] static std::int64_t cpu_time_us() noexcept;
+
+        PowerMonitor();
+        Rates sample();
+
+    private:
+        static gint counting_poll(GPollFD* fds, guint nfds, gint timeout);
+
+        gint64 last_time_us;
+        std::uint64_t last_wakeups;
+        std::int64_t last_cpu_us;
+    };
+
+} // namespace mnn
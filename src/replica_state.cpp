@@ -0,0 +1,303 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <ranges>
+#include <utility>
+#include "mnn_error.hpp"
+#include "replica_state.hpp"
+
+namespace
+{
+    constexpr std::array<std::byte, 4> magic = { std::byte{'M'}, std::byte{'N'}, std::byte{'R'}, std::byte{1} };
+    constexpr std::size_t max_batch = 255;
+
+    void
+    put_varint(std::vector<std::byte>& out, std::uint64_t v)
+    {
+        while (v >= 0x80) {
+            out.push_back(static_cast<std::byte>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<std::byte>(v));
+    }
+
+    void
+    put_u32(std::vector<std::byte>& out, std::uint32_t v)
+    {
+        for (auto i = 0; i < 4; ++i) {
+            out.push_back(static_cast<std::byte>(v >> (8 * i)));
+        }
+    }
+
+    class Reader
+    {
+    public:
+        explicit Reader(std::span<const std::byte> in) : in(in) {}
+
+        bool
+        varint(std::uint64_t& v)
+        {
+            v = 0;
+            for (auto shift = 0; shift < 64; shift += 7) {
+                if (pos >= in.size()) return false;
+                auto b = std::to_integer<std::uint64_t>(in[pos++]);
+                v |= (b & 0x7f) << shift;
+                if (0 == (b & 0x80)) return true;
+            }
+            return false;
+        }
+
+        bool
+        u32(std::uint32_t& v)
+        {
+            if (in.size() - pos < 4) return false;
+            v = 0;
+            for (auto i = 0; i < 4; ++i) {
+                v |= std::to_integer<std::uint32_t>(in[pos++]) << (8 * i);
+            }
+            return true;
+        }
+
+        bool
+        u8(std::uint8_t& v)
+        {
+            if (pos >= in.size()) return false;
+            v = std::to_integer<std::uint8_t>(in[pos++]);
+            return true;
+        }
+
+        bool
+        bytes(std::size_t n, std::string& s)
+        {
+            if (in.size() - pos < n) return false;
+            s.assign(reinterpret_cast<const char*>(in.data() + pos), n);
+            pos += n;
+            return true;
+        }
+
+    private:
+        std::span<const std::byte> in;
+        std::size_t pos = 0;
+    };
+
+} // anonymous namespace
+
+namespace mnn
+{
+    Hlc
+    HybridClock::tick(std::uint64_t now_ms)
+    {
+        if (now_ms > last.wall) {
+            last.wall = now_ms;
+            last.counter = 0;
+        } else {
+            ++last.counter;
+        }
+        return last;
+    }
+
+    void
+    HybridClock::observe(const Hlc& remote, std::uint64_t now_ms)
+    {
+        auto wall = std::max({ last.wall, remote.wall, now_ms });
+        if (wall == last.wall && wall == remote.wall) {
+            last.counter = std::max(last.counter, remote.counter) + 1;
+        } else if (wall == last.wall) {
+            ++last.counter;
+        } else if (wall == remote.wall) {
+            last.counter = remote.counter + 1;
+        } else {
+            last.counter = 0;
+        }
+        last.wall = wall;
+    }
+
+    std::int32_t
+    to_microdegrees(double degrees)
+    {
+        return static_cast<std::int32_t>(std::lround(std::clamp(degrees, -180.0, 180.0) * 1e6));
+    }
+
+    double
+    from_microdegrees(std::int32_t udeg)
+    {
+        return udeg / 1e6;
+    }
+
+    Delta
+    ReplicaState::record(std::string_view callsign, ReplicatedField field, std::uint8_t value, std::uint64_t now_ms,
+                         double latitude, double longitude)
+    {
+        Delta d{ .callsign = std::string(callsign), .field = field };
+        d.reg.stamp = clock.tick(now_ms);
+        d.reg.value = value;
+        if (ReplicatedField::LOCATION == field && value) {
+            d.reg.latitude_udeg = to_microdegrees(latitude);
+            d.reg.longitude_udeg = to_microdegrees(longitude);
+        }
+        auto& slot = registers[d.callsign][std::to_underlying(field)];
+        slot = { true, d.reg };
+        return d;
+    }
+
+    bool
+    ReplicaState::merge(const Delta& d, std::uint64_t now_ms)
+    {
+        auto index = std::to_underlying(d.field);
+        if (index >= replicated_field_count) {
+            return false;
+        }
+        clock.observe(d.reg.stamp, now_ms);
+        auto& slot = registers[d.callsign][index];
+        if (slot.set && slot.reg.stamp >= d.reg.stamp) {
+            return false;
+        }
+        slot = { true, d.reg };
+        return true;
+    }
+
+    const Register*
+    ReplicaState::find(std::string_view callsign, ReplicatedField field) const
+    {
+        auto it = registers.find(std::string(callsign));
+        if (registers.end() == it) return nullptr;
+        const auto& slot = it->second[std::to_underlying(field)];
+        return slot.set ? &slot.reg : nullptr;
+    }
+
+    std::vector<Delta>
+    ReplicaState::snapshot() const
+    {
+        std::vector<Delta> deltas;
+        deltas.reserve(registers.size());
+        for (const auto& [callsign, slots] : registers) {
+            for (auto i = 0UZ; i < slots.size(); ++i) {
+                if (slots[i].set) {
+                    deltas.push_back({ callsign, static_cast<ReplicatedField>(i), slots[i].reg });
+                }
+            }
+        }
+        return deltas;
+    }
+
+    std::size_t
+    encode_batch(std::span<const Delta> deltas, std::uint32_t net_tag, std::uint32_t sender,
+                 std::vector<std::byte>& out, std::size_t max_bytes)
+    {
+        deltas = deltas.first(std::min(deltas.size(), max_batch));
+        // An empty span still encodes, as a batch of none
+        auto base = deltas.empty() ? 0 : std::ranges::min(deltas | std::views::transform([](const Delta& d) { return d.reg.stamp.wall; }));
+
+        out.clear();
+        out.insert(out.end(), magic.begin(), magic.end());
+        put_u32(out, net_tag);
+        put_varint(out, sender);
+        put_varint(out, base);
+        auto count_pos = out.size();
+        out.push_back(std::byte{0});
+
+        std::unordered_map<std::string_view, std::size_t> seen;
+        auto consumed = 0UZ;
+        for (const auto& d : deltas) {
+            auto rollback = out.size();
+            auto callsign = std::string_view(d.callsign).substr(0, 255);
+            if (auto it = seen.find(callsign); seen.end() != it) {
+                put_varint(out, it->second << 1);
+            } else {
+                put_varint(out, seen.size() << 1 | 1);
+                out.push_back(static_cast<std::byte>(callsign.size()));
+                auto bytes = std::as_bytes(std::span(callsign));
+                out.insert(out.end(), bytes.begin(), bytes.end());
+            }
+            out.push_back(static_cast<std::byte>(std::to_underlying(d.field) | d.reg.value << 2));
+            put_varint(out, d.reg.stamp.wall - base);
+            put_varint(out, d.reg.stamp.counter);
+            put_varint(out, d.reg.stamp.node == sender ? 0 : std::uint64_t{d.reg.stamp.node} + 1);
+            if (ReplicatedField::LOCATION == d.field && d.reg.value) {
+                put_u32(out, std::bit_cast<std::uint32_t>(d.reg.latitude_udeg));
+                put_u32(out, std::bit_cast<std::uint32_t>(d.reg.longitude_udeg));
+            }
+            if (out.size() > max_bytes && consumed > 0) {
+                out.resize(rollback);
+                break;
+            }
+            seen.try_emplace(callsign, seen.size());
+            ++consumed;
+        }
+        out[count_pos] = static_cast<std::byte>(consumed);
+        return consumed;
+    }
+
+    std::expected<DecodedBatch, std::error_code>
+    decode_batch(std::span<const std::byte> in)
+    {
+        auto malformed = std::unexpected(std::make_error_code(error::malformed_replication_packet));
+        if (in.size() < magic.size() || !std::ranges::equal(in.first(magic.size()), magic)) {
+            return malformed;
+        }
+        Reader r(in.subspan(magic.size()));
+        DecodedBatch batch;
+        std::uint64_t sender, base;
+        std::uint8_t count;
+        if (!r.u32(batch.net_tag) || !r.varint(sender) || !r.varint(base) || !r.u8(count)) {
+            return malformed;
+        }
+        batch.sender = static_cast<std::uint32_t>(sender);
+
+        std::vector<std::string> callsigns;
+        batch.deltas.reserve(count);
+        for (auto i = 0U; i < count; ++i) {
+            Delta d;
+            std::uint64_t ref, wall, counter, node;
+            std::uint8_t field_value, length;
+            if (!r.varint(ref)) return malformed;
+            if (ref & 1) {
+                if (!r.u8(length) || !r.bytes(length, d.callsign)) return malformed;
+                callsigns.push_back(d.callsign);
+            } else if ((ref >> 1) < callsigns.size()) {
+                d.callsign = callsigns[ref >> 1];
+            } else {
+                return malformed;
+            }
+            if (!r.u8(field_value) || !r.varint(wall) || !r.varint(counter) || !r.varint(node)) {
+                return malformed;
+            }
+            d.field = static_cast<ReplicatedField>(field_value & 0x3);
+            if (std::to_underlying(d.field) >= replicated_field_count) {
+                return malformed;
+            }
+            d.reg.value = field_value >> 2;
+            d.reg.stamp = { .wall = base + wall,
+                            .counter = static_cast<std::uint32_t>(counter),
+                            .node = 0 == node ? batch.sender : static_cast<std::uint32_t>(node - 1) };
+            if (ReplicatedField::LOCATION == d.field && d.reg.value) {
+                std::uint32_t lat, lon;
+                if (!r.u32(lat) || !r.u32(lon)) return malformed;
+                d.reg.latitude_udeg = std::bit_cast<std::int32_t>(lat);
+                d.reg.longitude_udeg = std::bit_cast<std::int32_t>(lon);
+            }
+            batch.deltas.push_back(std::move(d));
+        }
+        return batch;
+    }
+
+} // namespace mnn
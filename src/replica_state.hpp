@@ -0,0 +1,149 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace mnn
+{
+    /* Hybrid logical clock timestamp: wall clock milliseconds, a counter for
+     * events within the same millisecond (or while behind a peer's clock),
+     * and the node id as the final tie break, so stamps are totally ordered. */
+    struct Hlc
+    {
+        std::uint64_t wall = 0;
+        std::uint32_t counter = 0;
+        std::uint32_t node = 0;
+
+        auto operator<=>(const Hlc&) const = default;
+    };
+
+    class HybridClock
+    {
+    public:
+        explicit HybridClock(std::uint32_t node) : last{ .node = node } {}
+
+        // Stamp for a local event
+        Hlc tick(std::uint64_t now_ms);
+        // Fold in a remote stamp so later local events order after it
+        void observe(const Hlc& remote, std::uint64_t now_ms);
+        [[nodiscard]] std::uint32_t node() const { return last.node; }
+
+    private:
+        Hlc last;
+    };
+
+    // The Station state that is replicated; the roster itself comes from the net file
+    enum class ReplicatedField : std::uint8_t
+    {
+        STATUS,
+        ACKNOWLEDGED,
+        LOCATION,
+    };
+
+    inline constexpr std::size_t replicated_field_count = 3;
+
+    /* Value of one last writer wins register. value is the status or the
+     * acknowledgement, or for LOCATION whether there is one. Locations are
+     * kept in whole microdegrees so every replica holds identical values. */
+    struct Register
+    {
+        Hlc stamp;
+        std::uint8_t value = 0;
+        std::int32_t latitude_udeg = 0;
+        std::int32_t longitude_udeg = 0;
+    };
+
+    struct Delta
+    {
+        std::string callsign;
+        ReplicatedField field;
+        Register reg;
+    };
+
+    /* Per station, per field LWW registers. Merging is commutative,
+     * associative and idempotent, so replicas converge whatever order
+     * deltas arrive in and however often they are repeated. */
+    class ReplicaState
+    {
+    public:
+        explicit ReplicaState(std::uint32_t node) : clock(node) {}
+
+        // A local edit; the returned delta is what to send to peers
+        Delta record(std::string_view callsign, ReplicatedField field, std::uint8_t value, std::uint64_t now_ms,
+                     double latitude = 0.0, double longitude = 0.0);
+        // True when the delta was newer than what we had, so it must be applied
+        bool merge(const Delta&, std::uint64_t now_ms);
+
+        [[nodiscard]] const Register* find(std::string_view callsign, ReplicatedField) const;
+        // Every register, for anti-entropy rounds and late joiners
+        [[nodiscard]] std::vector<Delta> snapshot() const;
+        [[nodiscard]] std::uint32_t node() const { return clock.node(); }
+
+    private:
+        struct Slot
+        {
+            bool set = false;
+            Register reg;
+        };
+        using Slots = std::array<Slot, replicated_field_count>;
+
+        HybridClock clock;
+        std::unordered_map<std::string, Slots> registers;
+    };
+
+    [[nodiscard]] std::int32_t to_microdegrees(double degrees);
+    [[nodiscard]] double from_microdegrees(std::int32_t udeg);
+
+    /* Wire format, one datagram per batch:
+     *   "MNR" version u8, net tag u32 le, sender varint, base wall varint, count u8
+     *   then per delta:
+     *     callsign: varint (index << 1 | fresh), fresh ones followed by u8 length + bytes
+     *     u8 field | value << 2
+     *     varint wall - base wall, varint counter, varint node (0 for the sender)
+     *     LOCATION with a value: i32 le latitude, i32 le longitude in microdegrees
+     * Callsigns repeated within a batch are sent once, and stamps are
+     * relative to the oldest in the batch, so a typical check-in is about
+     * 13 bytes. */
+    struct DecodedBatch
+    {
+        std::uint32_t net_tag = 0;
+        std::uint32_t sender = 0;
+        std::vector<Delta> deltas;
+    };
+
+    /* Encodes as many deltas as fit in max_bytes into out (replacing its
+     * contents). Returns how many were consumed; at least one always is
+     * unless deltas is empty, and never more than 255. */
+    std::size_t encode_batch(std::span<const Delta> deltas, std::uint32_t net_tag, std::uint32_t sender,
+                             std::vector<std::byte>& out, std::size_t max_bytes = 1200);
+    [[nodiscard]] std::expected<DecodedBatch, std::error_code> decode_batch(std::span<const std::byte>);
+
+} // namespace mnn
@@ -0,0 +1,93 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "roster_arena.hpp"
+
+namespace
+{
+    mnn::RosterArena::ReleaseHook&
+    release_hook()
+    {
+        static mnn::RosterArena::ReleaseHook hook;
+        return hook;
+    }
+}
+
+namespace mnn
+{
+    RosterArena::RosterArena(std::size_t initial_size) :
+        upstream(counters),
+        monotonic(initial_size, &upstream)
+    {
+    }
+
+    RosterArena::~RosterArena()
+    {
+        monotonic.release();
+        if (auto& hook = release_hook()) {
+            hook(counters);
+        }
+    }
+
+    void
+    RosterArena::set_release_hook(ReleaseHook hook)
+    {
+        release_hook() = std::move(hook);
+    }
+
+    void*
+    RosterArena::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        ++counters.allocations;
+        counters.bytes += bytes;
+        return monotonic.allocate(bytes, alignment);
+    }
+
+    void
+    RosterArena::do_deallocate(void*, std::size_t, std::size_t)
+    {
+        // Monotonic: everything goes back when the arena does
+    }
+
+    bool
+    RosterArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    void*
+    RosterArena::Upstream::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        ++counters.upstream_allocations;
+        counters.upstream_bytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void
+    RosterArena::Upstream::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool
+    RosterArena::Upstream::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+} // namespace mnn
@@ -0,0 +1,84 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+
+namespace mnn
+{
+    struct ArenaStats
+    {
+        // Requests served to Station members
+        std::size_t allocations = 0;
+        std::size_t bytes = 0;
+        // Blocks the arena itself took from the heap
+        std::size_t upstream_allocations = 0;
+        std::size_t upstream_bytes = 0;
+    };
+
+    /* Monotonic memory for the strings of one loaded net. Every Station
+     * created from the net holds a reference, so the blocks are returned to
+     * the heap together when the last Station of the roster is finalized.
+     *
+     * Not thread safe: one thread at a time owns a net's arena. load_net()
+     * fills it on whichever thread parses the net, usually the pool; once
+     * the net is handed to the main thread, walk-ins and roster reloads
+     * allocate from there only. */
+    class RosterArena final : public std::pmr::memory_resource
+    {
+    public:
+        using ReleaseHook = std::function<void(const ArenaStats&)>;
+
+        explicit RosterArena(std::size_t initial_size = 16 * 1024);
+        ~RosterArena() override;
+        RosterArena(const RosterArena&) = delete;
+        RosterArena& operator=(const RosterArena&) = delete;
+
+        [[nodiscard]] const ArenaStats& stats() const noexcept { return counters; }
+
+        /* Instrumentation: called with the final counts whenever an arena is
+         * destroyed, i.e. when a net is switched or closed. */
+        static void set_release_hook(ReleaseHook hook);
+
+    private:
+        class Upstream final : public std::pmr::memory_resource
+        {
+        public:
+            explicit Upstream(ArenaStats& counters) : counters(counters) {}
+
+        private:
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+            void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+            ArenaStats& counters;
+        };
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        ArenaStats counters;
+        Upstream upstream;
+        std::pmr::monotonic_buffer_resource monotonic;
+    };
+
+} // namespace mnn
@@ -0,0 +1,146 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <ranges>
+#include <gtk/gtk.h>
+#include "roster_grid_model.hpp"
+
+namespace mnn
+{
+using namespace peel;
+
+PEEL_CLASS_IMPL (RosterGridModel, "MNNRosterGridModel", Object)
+
+void
+RosterGridModel::init_type(Type tp)
+{
+    PEEL_IMPLEMENT_INTERFACE(tp, Gio::ListModel);
+}
+
+void
+RosterGridModel::init_interface(Gio::ListModel::Iface* iface)
+{
+    auto c_iface = reinterpret_cast<GListModelInterface*>(iface);
+    c_iface->get_item_type = &RosterGridModel::get_item_type;
+    c_iface->get_n_items = &RosterGridModel::get_n_items;
+    c_iface->get_item = &RosterGridModel::get_item;
+}
+
+void
+RosterGridModel::Class::init()
+{
+    override_vfunc_dispose<RosterGridModel>();
+    override_vfunc_finalize<RosterGridModel>();
+}
+
+void
+RosterGridModel::init(Class*)
+{
+    new (&m) Members;
+    m.blank = G_OBJECT(gtk_string_object_new(""));
+}
+
+void
+RosterGridModel::vfunc_dispose()
+{
+    for (auto [column, handler] : std::views::zip(m.columns, m.handlers)) {
+        g_signal_handler_disconnect(column, handler);
+    }
+    m.handlers.clear();
+    parent_vfunc_dispose<RosterGridModel>();
+}
+
+void
+RosterGridModel::vfunc_finalize()
+{
+    std::ranges::for_each(m.columns, g_object_unref);
+    std::ranges::for_each(m.headers, g_object_unref);
+    g_object_unref(m.blank);
+    m.~Members();
+    parent_vfunc_finalize<RosterGridModel>();
+}
+
+RefPtr<RosterGridModel>
+RosterGridModel::create(std::span<GListModel* const> columns, std::span<const std::string> titles)
+{
+    RefPtr<RosterGridModel> model = Object::create<RosterGridModel>();
+    auto& m = model->m;
+    std::vector<std::size_t> rows;
+    for (auto [column, title] : std::views::zip(columns, titles)) {
+        m.columns.push_back(G_LIST_MODEL(g_object_ref(column)));
+        m.headers.push_back(G_OBJECT(gtk_string_object_new(title.c_str())));
+        m.handlers.push_back(g_signal_connect(column, "items-changed", G_CALLBACK(&RosterGridModel::on_column_changed),
+                                              static_cast<RosterGridModel*>(model)));
+        rows.push_back(g_list_model_get_n_items(column));
+    }
+    m.layout.reset(rows, 1);
+    return model;
+}
+
+void
+RosterGridModel::set_lanes(std::size_t lanes)
+{
+    auto old_size = m.layout.size();
+    auto old_lanes = m.layout.get_lanes();
+    m.layout.set_lanes(lanes);
+    if (m.layout.get_lanes() == old_lanes) return;
+    g_list_model_items_changed(G_LIST_MODEL(this), 0, static_cast<guint>(old_size), static_cast<guint>(m.layout.size()));
+}
+
+GType
+RosterGridModel::get_item_type(GListModel*)
+{
+    return G_TYPE_OBJECT;
+}
+
+guint
+RosterGridModel::get_n_items(GListModel* list)
+{
+    return static_cast<guint>(reinterpret_cast<RosterGridModel*>(list)->m.layout.size());
+}
+
+gpointer
+RosterGridModel::get_item(GListModel* list, guint position)
+{
+    auto& m = reinterpret_cast<RosterGridModel*>(list)->m;
+    if (position >= m.layout.size()) return nullptr;
+    auto slot = m.layout.slot(position);
+    switch (slot.kind) {
+        case RosterSlot::Kind::STATION: return g_list_model_get_item(m.columns[slot.column], slot.row);
+        case RosterSlot::Kind::HEADER:  return g_object_ref(m.headers[slot.column]);
+        case RosterSlot::Kind::BLANK:   break;
+    }
+    return g_object_ref(m.blank);
+}
+
+void
+RosterGridModel::on_column_changed(GListModel* column, guint position, guint removed, guint added, gpointer data)
+{
+    auto self = static_cast<RosterGridModel*>(data);
+    auto& m = self->m;
+    if (0 == removed && 0 == added) return;
+    auto index = static_cast<std::size_t>(std::ranges::find(m.columns, column) - m.columns.begin());
+    auto change = m.layout.set_rows(index, g_list_model_get_n_items(column), position);
+    if (0 == change.removed && 0 == change.added) return;
+    g_list_model_items_changed(G_LIST_MODEL(self), static_cast<guint>(change.position),
+                               static_cast<guint>(change.removed), static_cast<guint>(change.added));
+}
+
+} // namespace mnn
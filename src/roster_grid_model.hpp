@@ -0,0 +1,72 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <gio/gio.h>
+#include <peel/Gio/Gio.h>
+#include <peel/class.h>
+#include "roster_layout.hpp"
+
+namespace mnn
+{
+    /* The list model behind RosterGrid: the net's column models flowed
+     * into lanes by a RosterLayout. Items are the columns' own Stations,
+     * with a GtkStringObject holding the title for header slots and a
+     * shared empty one for blanks. Column changes are passed on as the
+     * smallest slot range they touch; nothing is copied per station. */
+    class RosterGridModel final : public peel::Gio::ListModel
+    {
+        PEEL_SIMPLE_CLASS (RosterGridModel, Object)
+        friend class peel::Gio::ListModel;
+
+        static void init_type(peel::Type tp);
+        static void init_interface(peel::Gio::ListModel::Iface*);
+        void init(Class*);
+
+        struct Members {
+            // Strong refs, in display order
+            std::vector<GListModel*> columns;
+            std::vector<gulong> handlers;
+            std::vector<GObject*> headers;
+            GObject* blank;
+            RosterLayout layout;
+        } m;
+
+        static GType get_item_type(GListModel*);
+        static guint get_n_items(GListModel*);
+        static gpointer get_item(GListModel*, guint position);
+        static void on_column_changed(GListModel* column, guint position, guint removed, guint added, gpointer self);
+
+    public:
+        static peel::RefPtr<RosterGridModel> create(std::span<GListModel* const> columns, std::span<const std::string> titles);
+
+        // Reflows every slot; a no-op when the count doesn't change
+        void set_lanes(std::size_t lanes);
+        [[nodiscard]] std::size_t get_lanes() const { return m.layout.get_lanes(); }
+
+    protected:
+        void vfunc_dispose();
+        void vfunc_finalize();
+    };
+
+} // namespace mnn
@@ -0,0 +1,44 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "mnn_error.hpp"
+#include "roster_arena.hpp"
+#include "station.hpp"
+#include "station_record.hpp"
+
+namespace mnn
+{
+    struct ImportResult
+    {
+        std::vector<peel::RefPtr<Station>> stations;
+        std::vector<ImportDiagnostic> diagnostics;
+    };
+
+    /* Loads every valid record of a net definition's "stations" array in a
+     * single pass, by read_roster(). Bad records and repeated callsigns
+     * are skipped and described in diagnostics. */
+    [[nodiscard]] ImportResult import_stations(const nlohmann::json& stations, std::shared_ptr<RosterArena> arena);
+
+} // namespace mnn
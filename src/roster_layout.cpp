@@ -0,0 +1,95 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <utility>
+#include "roster_layout.hpp"
+
+namespace mnn
+{
+    void
+    RosterLayout::reset(std::span<const std::size_t> rows_per_column, std::size_t new_lanes)
+    {
+        rows.assign(rows_per_column.begin(), rows_per_column.end());
+        set_lanes(new_lanes);
+    }
+
+    void
+    RosterLayout::set_lanes(std::size_t new_lanes)
+    {
+        lanes = std::clamp(new_lanes, 1UZ, std::max(rows.size(), 1UZ));
+        rebuild_bands();
+    }
+
+    std::size_t
+    RosterLayout::band_height(std::size_t band) const noexcept
+    {
+        auto first = rows.begin() + band * lanes;
+        auto last = rows.begin() + std::min(rows.size(), (band + 1) * lanes);
+        return 1 + *std::max_element(first, last);
+    }
+
+    void
+    RosterLayout::rebuild_bands()
+    {
+        auto bands = (rows.size() + lanes - 1) / lanes;
+        band_begin.assign(bands + 1, 0);
+        for (std::size_t b = 0; b < bands; ++b) {
+            band_begin[b + 1] = band_begin[b] + band_height(b) * lanes;
+        }
+    }
+
+    RosterLayout::Change
+    RosterLayout::set_rows(std::size_t column, std::size_t new_rows, std::size_t first_row)
+    {
+        auto band = column / lanes;
+        auto old_rows = std::exchange(rows[column], new_rows);
+        auto begin = band_begin[band];
+        auto old_end = band_begin[band + 1];
+        auto first = begin + (1 + std::min(first_row, std::min(old_rows, new_rows))) * lanes;
+
+        auto height = band_height(band);
+        if (begin + height * lanes == old_end) {
+            // Band keeps its height: only the rows this column spans move
+            auto end = begin + (1 + std::max(old_rows, new_rows)) * lanes;
+            return { first, end - first, end - first };
+        }
+        auto new_end = begin + height * lanes;
+        auto delta = static_cast<std::ptrdiff_t>(new_end) - static_cast<std::ptrdiff_t>(old_end);
+        for (auto b = band + 1; b < band_begin.size(); ++b) {
+            band_begin[b] = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(band_begin[b]) + delta);
+        }
+        return { first, old_end - first, new_end - first };
+    }
+
+    RosterSlot
+    RosterLayout::slot(std::size_t index) const noexcept
+    {
+        auto it = std::upper_bound(band_begin.begin(), band_begin.end(), index);
+        auto band = static_cast<std::size_t>(it - band_begin.begin()) - 1;
+        auto local = index - band_begin[band];
+        auto column = band * lanes + local % lanes;
+        auto row = local / lanes;
+        if (column >= rows.size()) return { RosterSlot::Kind::BLANK, column, 0 };
+        if (0 == row) return { RosterSlot::Kind::HEADER, column, 0 };
+        if (row - 1 < rows[column]) return { RosterSlot::Kind::STATION, column, row - 1 };
+        return { RosterSlot::Kind::BLANK, column, 0 };
+    }
+
+} // namespace mnn
@@ -0,0 +1,93 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace mnn
+{
+    struct RosterSlot
+    {
+        enum class Kind : std::uint8_t
+        {
+            HEADER,
+            STATION,
+            BLANK,
+        };
+
+        Kind kind;
+        std::size_t column;
+        // Row within the column, for STATION
+        std::size_t row;
+    };
+
+    /* Where each net column's rows land when all columns share one grid of
+     * lanes, read row by row as a GtkGridView does. Columns sit side by
+     * side, lanes at a time; when there are more columns than lanes the
+     * rest wrap into further bands below. Each band is a header row then
+     * as many rows as its longest column, blanks filling the rest:
+     *
+     *     lanes 2, columns A-F (3 rows), G-L (1), M-R (2)
+     *
+     *     A-F  G-L      band 0
+     *     a0   g0
+     *     a1   .
+     *     a2   .
+     *     M-R  .        band 1
+     *     m0   .
+     *     m1   .
+     *
+     * Every lookup is a binary search over the bands, so nothing is
+     * materialized per slot. */
+    class RosterLayout
+    {
+    public:
+        // Slots whose contents changed, in GListModel::items-changed terms
+        struct Change
+        {
+            std::size_t position = 0;
+            std::size_t removed = 0;
+            std::size_t added = 0;
+        };
+
+        void reset(std::span<const std::size_t> rows_per_column, std::size_t lanes);
+        // Reflows for a new lane count; every slot may move
+        void set_lanes(std::size_t lanes);
+        // Column now has rows rows, and those from first_row on may differ
+        [[nodiscard]] Change set_rows(std::size_t column, std::size_t rows, std::size_t first_row);
+
+        [[nodiscard]] std::size_t get_lanes() const noexcept { return lanes; }
+        [[nodiscard]] std::size_t size() const noexcept { return band_begin.empty() ? 0 : band_begin.back(); }
+        [[nodiscard]] RosterSlot slot(std::size_t index) const noexcept;
+
+    private:
+        [[nodiscard]] std::size_t band_height(std::size_t band) const noexcept;
+        void rebuild_bands();
+
+        std::vector<std::size_t> rows;
+        std::size_t lanes = 1;
+        // One more than there are bands; the last is size()
+        std::vector<std::size_t> band_begin;
+    };
+
+} // namespace mnn
@@ -0,0 +1,91 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "metrics.hpp"
+#include "roster_search_filter.hpp"
+#include "search_query.hpp"
+#include "station.hpp"
+
+namespace mnn
+{
+using namespace peel;
+
+PEEL_CLASS_IMPL (RosterSearchFilter, "MNNRosterSearchFilter", Gtk::Filter);
+
+void
+RosterSearchFilter::Class::init()
+{
+    override_vfunc_finalize<RosterSearchFilter>();
+    auto filter_class = reinterpret_cast<GtkFilterClass*>(this);
+    filter_class->match = &RosterSearchFilter::match;
+    filter_class->get_strictness = &RosterSearchFilter::get_strictness;
+}
+
+void
+RosterSearchFilter::init(Class*)
+{
+    new (&m) Members;
+}
+
+void
+RosterSearchFilter::vfunc_finalize()
+{
+    m.~Members();
+    parent_vfunc_finalize<RosterSearchFilter>();
+}
+
+RefPtr<RosterSearchFilter>
+RosterSearchFilter::create()
+{
+    return Object::create<RosterSearchFilter>();
+}
+
+void
+RosterSearchFilter::set_search(std::string_view text)
+{
+    auto needle = Station::fold_for_search(text);
+    auto change = GTK_FILTER_CHANGE_DIFFERENT;
+    switch (compare_searches(m.needle, needle)) {
+        case SearchChange::SAME:        return;
+        case SearchChange::MORE_STRICT: change = GTK_FILTER_CHANGE_MORE_STRICT; break;
+        case SearchChange::LESS_STRICT: change = GTK_FILTER_CHANGE_LESS_STRICT; break;
+        case SearchChange::DIFFERENT:   break;
+    }
+    static auto& searches = metrics().counter("mnn_search_changes", "Roster search filter changes");
+    searches.add();
+    m.needle = std::move(needle);
+    gtk_filter_changed(GTK_FILTER(this), change);
+}
+
+gboolean
+RosterSearchFilter::match(GtkFilter* filter, gpointer item)
+{
+    auto& m = reinterpret_cast<RosterSearchFilter*>(filter)->m;
+    if (m.needle.empty()) return TRUE;
+    return search_matches(static_cast<Station*>(item)->get_search_key(), m.needle);
+}
+
+GtkFilterMatch
+RosterSearchFilter::get_strictness(GtkFilter* filter)
+{
+    // Lets the filter models skip match() entirely while nothing is typed
+    return reinterpret_cast<RosterSearchFilter*>(filter)->m.needle.empty() ? GTK_FILTER_MATCH_ALL : GTK_FILTER_MATCH_SOME;
+}
+
+} // namespace mnn
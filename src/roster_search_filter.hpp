@@ -0,0 +1,59 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <gtk/gtk.h>
+#include <peel/Gtk/Gtk.h>
+#include <peel/class.h>
+
+namespace mnn
+{
+    /* Matches stations whose callsign or name contains the search text,
+     * compared against each Station's cached search key. A new search is
+     * announced as MORE_STRICT or LESS_STRICT whenever it is, so the
+     * filter models downstream only recheck the stations that could
+     * change sides. One instance serves every column. */
+    class RosterSearchFilter final : public peel::Gtk::Filter
+    {
+        PEEL_SIMPLE_CLASS (RosterSearchFilter, peel::Gtk::Filter);
+
+        void init(Class*);
+
+        struct Members {
+            // Already folded
+            std::string needle;
+        } m;
+
+        static gboolean match(GtkFilter*, gpointer item);
+        static GtkFilterMatch get_strictness(GtkFilter*);
+
+    protected:
+        void vfunc_finalize();
+
+    public:
+        static peel::RefPtr<RosterSearchFilter> create();
+
+        // Takes the text as typed; a no-op when it folds to the current search
+        void set_search(std::string_view text);
+    };
+
+} // namespace mnn
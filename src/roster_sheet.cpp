@@ -0,0 +1,242 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <format>
+#include <tuple>
+#include <utility>
+#include <glib/gi18n.h>
+#include "net_library.hpp"
+#include "roster_sheet.hpp"
+#include "station.hpp"
+
+namespace
+{
+    constexpr double margin = 36.0;
+    constexpr double header_height = 44.0;
+    constexpr double heading_height = 18.0;
+    constexpr double row_height = 14.0;
+    constexpr double box_size = 9.0;
+    constexpr double callsign_width = 50.0;
+    constexpr std::size_t max_lanes = 4;
+    // Names repeat a lot; a new net's worth of them fits easily
+    constexpr std::size_t max_cached_layouts = 2048;
+
+    constexpr const char* font_names[] = { "Sans Bold 13", "Sans Bold 9", "Monospace Bold 8", "Sans 8", "Sans Bold 8" };
+
+    // Leaves room for the in and ack boxes, then the callsign
+    constexpr double name_offset = 2.0 + 2 * (box_size + 3.0) + callsign_width;
+
+} // anonymous namespace
+
+namespace mnn
+{
+    SheetData
+    collect_sheet(const Net& net, SessionInfo session)
+    {
+        SheetData data{ .title = net.meta.value("location", net.id), .session = std::move(session) };
+        std::vector<std::vector<std::pair<std::string, SheetEntry>>> keyed(net.columns.size());
+        auto store = G_LIST_MODEL(static_cast<peel::Gio::ListStore*>(net.stations));
+        auto n = g_list_model_get_n_items(store);
+        for (guint i = 0; i < n; ++i) {
+            auto station = static_cast<Station*>(g_list_model_get_item(store, i));
+            auto suffix = station->get_suffix();
+            // Same rule as the roster grid's column filters
+            for (std::size_t c = 0; c < net.columns.size() && !suffix.empty(); ++c) {
+                const auto& col = net.columns[c];
+                if (suffix.front() < col.begin.front() || suffix.front() > col.end.front()) continue;
+                keyed[c].emplace_back(std::string(suffix), SheetEntry{ .callsign = station->get_callsign(),
+                                                                       .name = station->get_name(),
+                                                                       .status = station->get_status(),
+                                                                       .acknowledged = station->is_acknowledged() });
+            }
+            g_object_unref(station);
+        }
+        for (std::size_t c = 0; c < net.columns.size(); ++c) {
+            const auto& col = net.columns[c];
+            auto& column = data.columns.emplace_back(SheetColumn{ .title = col.begin == col.end ? col.begin : std::format("{} – {}", col.begin, col.end) });
+            std::ranges::sort(keyed[c], [](const auto& a, const auto& b) {
+                return std::tie(a.first, a.second.callsign) < std::tie(b.first, b.second.callsign);
+            });
+            column.entries.reserve(keyed[c].size());
+            for (auto& [suffix, entry] : keyed[c]) {
+                column.entries.push_back(std::move(entry));
+            }
+        }
+        return data;
+    }
+
+    SheetRenderer::SheetRenderer(SheetData d, PangoContext* ctx, double w, double h) :
+        data(std::move(d)),
+        context(PANGO_CONTEXT(g_object_ref(ctx))),
+        width(w),
+        height(h),
+        lanes(std::clamp(data.columns.size(), 1UZ, max_lanes)),
+        lane_width((width - 2 * margin) / static_cast<double>(lanes)),
+        scratch(pango_layout_new(context)),
+        page_time(metrics().histogram("mnn_sheet_page_seconds", "Time to draw one check-in sheet page"))
+    {
+        for (std::size_t f = 0; f < FONT_COUNT; ++f) {
+            fonts[f] = pango_font_description_from_string(font_names[f]);
+        }
+        std::vector<std::size_t> rows;
+        rows.reserve(data.columns.size());
+        for (const auto& column : data.columns) {
+            rows.push_back(column.entries.size());
+        }
+        auto usable = height - 2 * margin - header_height - heading_height;
+        rows_per_page = static_cast<std::size_t>(std::max(usable / row_height, 1.0));
+        pages = paginate_sheet(rows, lanes, rows_per_page);
+    }
+
+    SheetRenderer::~SheetRenderer()
+    {
+        for (auto& [key, l] : layouts) {
+            g_object_unref(l);
+        }
+        g_object_unref(scratch);
+        for (auto f : fonts) {
+            pango_font_description_free(f);
+        }
+        g_object_unref(context);
+    }
+
+    std::size_t
+    SheetRenderer::station_count() const noexcept
+    {
+        std::size_t count = 0;
+        for (const auto& column : data.columns) {
+            count += column.entries.size();
+        }
+        return count;
+    }
+
+    PangoLayout*
+    SheetRenderer::layout(Font font, std::string_view text)
+    {
+        std::string key(1, static_cast<char>('0' + font));
+        key.append(text);
+        if (auto it = layouts.find(key); it != layouts.end()) {
+            return it->second;
+        }
+        if (layouts.size() >= max_cached_layouts) {
+            for (auto& [k, l] : layouts) {
+                g_object_unref(l);
+            }
+            layouts.clear();
+        }
+        auto l = pango_layout_new(context);
+        pango_layout_set_font_description(l, fonts[font]);
+        if (NAME == font) {
+            pango_layout_set_width(l, pango_units_from_double(lane_width - name_offset - 4.0));
+            pango_layout_set_ellipsize(l, PANGO_ELLIPSIZE_END);
+        }
+        pango_layout_set_text(l, text.data(), static_cast<int>(text.size()));
+        layouts.emplace(std::move(key), l);
+        return l;
+    }
+
+    // Vertically centred in a band of row_height starting at y
+    void
+    SheetRenderer::show(cairo_t* cr, PangoLayout* l, double x, double y, double band)
+    {
+        int h = 0;
+        pango_layout_get_size(l, nullptr, &h);
+        cairo_move_to(cr, x, y + (band - pango_units_to_double(h)) / 2);
+        pango_cairo_show_layout(cr, l);
+    }
+
+    void
+    SheetRenderer::draw_row(cairo_t* cr, const SheetEntry& entry, double x, double y)
+    {
+        auto box_y = y + (row_height - box_size) / 2;
+        auto in_x = x + 2.0;
+        auto ack_x = in_x + box_size + 3.0;
+        cairo_rectangle(cr, in_x, box_y, box_size, box_size);
+        cairo_rectangle(cr, ack_x, box_y, box_size, box_size);
+        cairo_stroke(cr);
+
+        auto mark = [&](const char* text, double bx) {
+            auto l = layout(MARK, text);
+            int w = 0;
+            pango_layout_get_size(l, &w, nullptr);
+            show(cr, l, bx + (box_size - pango_units_to_double(w)) / 2, y, row_height);
+        };
+        if (StationStatus::HEARD_DIRECT == entry.status) mark("✔", in_x);
+        else if (StationStatus::HEARD_RELAY == entry.status) mark("R", in_x);
+        if (entry.acknowledged) mark("✔", ack_x);
+
+        pango_layout_set_text(scratch, entry.callsign.data(), static_cast<int>(entry.callsign.size()));
+        show(cr, scratch, ack_x + box_size + 4.0, y, row_height);
+        if (!entry.name.empty()) {
+            show(cr, layout(NAME, entry.name), x + name_offset, y, row_height);
+        }
+    }
+
+    void
+    SheetRenderer::draw_page(cairo_t* cr, std::size_t index)
+    {
+        ScopedTimer timer(page_time);
+        const auto& page = pages.at(index);
+        cairo_save(cr);
+        cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+        cairo_set_line_width(cr, 0.5);
+
+        // Same on every page, so cached
+        show(cr, layout(TITLE, data.title), margin, margin, 20.0);
+        auto session = std::format("{}    {}    {} {}", data.session.date, data.session.frequency,
+                                   data.session.control_callsign, data.session.control_name);
+        show(cr, layout(HEADING, session), margin, margin + 22.0, 14.0);
+        auto page_number = index + 1, page_total = pages.size();
+        auto number = std::vformat(_("Page {} of {}"), std::make_format_args(page_number, page_total));
+        pango_layout_set_font_description(scratch, fonts[HEADING]);
+        pango_layout_set_text(scratch, number.data(), static_cast<int>(number.size()));
+        int w = 0;
+        pango_layout_get_size(scratch, &w, nullptr);
+        show(cr, scratch, width - margin - pango_units_to_double(w), margin, 20.0);
+        pango_layout_set_font_description(scratch, fonts[CALLSIGN]);
+
+        auto top = margin + header_height;
+        cairo_move_to(cr, margin, top - 4.0);
+        cairo_line_to(cr, width - margin, top - 4.0);
+        cairo_stroke(cr);
+
+        auto bottom = height - margin;
+        for (std::size_t lane = 0; lane < page.column_count; ++lane) {
+            const auto& column = data.columns[page.first_column + lane];
+            auto x = margin + lane_width * static_cast<double>(lane);
+            show(cr, layout(HEADING, column.title), x + 2.0, top, heading_height);
+            cairo_move_to(cr, x, top + heading_height);
+            cairo_line_to(cr, x + lane_width, top + heading_height);
+            if (lane > 0) {
+                cairo_move_to(cr, x, top);
+                cairo_line_to(cr, x, bottom);
+            }
+            cairo_stroke(cr);
+
+            auto y = top + heading_height;
+            auto end = std::min(page.first_row + rows_per_page, column.entries.size());
+            for (auto r = page.first_row; r < end; ++r, y += row_height) {
+                draw_row(cr, column.entries[r], x, y);
+            }
+        }
+        cairo_restore(cr);
+    }
+
+} // namespace mnn
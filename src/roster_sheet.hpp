@@ -0,0 +1,110 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <pango/pangocairo.h>
+#include "metrics.hpp"
+#include "net_snapshot.hpp"
+#include "sheet_layout.hpp"
+#include "station_status.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    struct SheetEntry
+    {
+        std::string callsign;
+        std::string name;
+        StationStatus status;
+        bool acknowledged;
+    };
+
+    struct SheetColumn
+    {
+        std::string title;
+        // By suffix, then callsign, like the paper sheets
+        std::vector<SheetEntry> entries;
+    };
+
+    struct SheetData
+    {
+        std::string title;
+        SessionInfo session;
+        std::vector<SheetColumn> columns;
+    };
+
+    // Main thread; plain copies so rendering never touches a Station
+    [[nodiscard]] SheetData collect_sheet(const Net&, SessionInfo);
+
+    /* Draws the check-in sheet one page at a time onto any cairo context,
+     * a PDF surface on the pool or a GtkPrintContext on the main loop.
+     * Only the page table is built up front; layouts for repeated text
+     * (names, titles, marks) are cached up to a fixed count and dropped
+     * wholesale past it, so memory stays flat however many pages are
+     * drawn. Sizes are in points and context must be set to 72 dpi.
+     *
+     * Not thread safe; use one renderer and one PangoContext per thread. */
+    class SheetRenderer
+    {
+    public:
+        // US Letter
+        static constexpr double letter_width = 612.0;
+        static constexpr double letter_height = 792.0;
+
+        SheetRenderer(SheetData data, PangoContext* context, double width = letter_width, double height = letter_height);
+        ~SheetRenderer();
+        SheetRenderer(const SheetRenderer&) = delete;
+        SheetRenderer& operator=(const SheetRenderer&) = delete;
+
+        [[nodiscard]] std::size_t page_count() const noexcept { return pages.size(); }
+        [[nodiscard]] std::size_t station_count() const noexcept;
+        void draw_page(cairo_t*, std::size_t page);
+
+    private:
+        enum Font { TITLE, HEADING, CALLSIGN, NAME, MARK, FONT_COUNT };
+
+        PangoLayout* layout(Font, std::string_view text);
+        void show(cairo_t*, PangoLayout*, double x, double y, double row_height);
+        void draw_row(cairo_t*, const SheetEntry&, double x, double y);
+
+        SheetData data;
+        PangoContext* context;
+        double width;
+        double height;
+        std::size_t lanes;
+        double lane_width;
+        std::size_t rows_per_page;
+        std::vector<SheetPage> pages;
+        std::array<PangoFontDescription*, FONT_COUNT> fonts;
+        // Keyed by font and text
+        std::unordered_map<std::string, PangoLayout*> layouts;
+        // For callsigns, which are drawn once each
+        PangoLayout* scratch;
+        Histogram& page_time;
+    };
+
+} // namespace mnn
@@ -0,0 +1,94 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include "roster_sort.hpp"
+
+namespace
+{
+    // Below every callsign character, so a shorter field sorts first
+    constexpr char separator = '\0';
+
+    char
+    status_rank(mnn::StationStatus status)
+    {
+        switch (status) {
+            case mnn::StationStatus::HEARD_DIRECT: return '0';
+            case mnn::StationStatus::HEARD_RELAY:  return '1';
+            case mnn::StationStatus::PENDING:      break;
+        }
+        return '2';
+    }
+
+    void
+    append_distance(std::optional<double> km, std::string& out)
+    {
+        // Non-negative doubles order like their bit patterns; big endian so bytes compare in order
+        auto bits = km && std::isfinite(*km) ? std::bit_cast<std::uint64_t>(std::max(*km, 0.0)) : ~0ULL;
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out.push_back(static_cast<char>((bits >> shift) & 0xff));
+        }
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    void
+    roster_sort_key(RosterSort sort, const SortFields& f, std::string& out)
+    {
+        out.clear();
+        switch (sort) {
+            case RosterSort::SUFFIX:
+                out.append(f.suffix);
+                out.push_back(separator);
+                break;
+            case RosterSort::CALLSIGN:
+                break;
+            case RosterSort::NAME:
+                out.append(f.name_key);
+                out.push_back(separator);
+                break;
+            case RosterSort::STATUS:
+                out.push_back(status_rank(f.status));
+                break;
+            case RosterSort::DISTANCE:
+                append_distance(f.distance_km, out);
+                break;
+        }
+        out.append(f.callsign);
+    }
+
+    double
+    great_circle_km(double lat1, double lon1, double lat2, double lon2) noexcept
+    {
+        constexpr double earth_radius_km = 6371.0;
+        constexpr double rad = std::numbers::pi / 180.0;
+        auto dlat = (lat2 - lat1) * rad;
+        auto dlon = (lon2 - lon1) * rad;
+        auto a = std::sin(dlat / 2) * std::sin(dlat / 2) +
+            std::cos(lat1 * rad) * std::cos(lat2 * rad) * std::sin(dlon / 2) * std::sin(dlon / 2);
+        return 2 * earth_radius_km * std::asin(std::min(1.0, std::sqrt(a)));
+    }
+
+} // namespace mnn
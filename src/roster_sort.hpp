@@ -0,0 +1,57 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include "station_status.hpp"
+
+namespace mnn
+{
+    enum class RosterSort
+    {
+        SUFFIX,
+        CALLSIGN,
+        NAME,
+        STATUS,
+        DISTANCE,
+    };
+
+    struct SortFields
+    {
+        std::string_view callsign;
+        std::string_view suffix;
+        // g_utf8_collate_key() of the name, or anything that orders the same
+        std::string_view name_key;
+        StationStatus status = StationStatus::PENDING;
+        std::optional<double> distance_km;
+    };
+
+    /* One byte string per station that orders the roster under sort by
+     * plain comparison, so sorting and binary searching never collate.
+     * Every key ends in the callsign, which makes keys within a net unique
+     * and ties stable. Heard stations sort ahead of pending ones; stations
+     * without a location sort after every distance. */
+    void roster_sort_key(RosterSort sort, const SortFields&, std::string& out);
+
+    [[nodiscard]] double great_circle_km(double lat1, double lon1, double lat2, double lon2) noexcept;
+
+} // namespace mnn
@@ -0,0 +1,40 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "search_query.hpp"
+
+namespace mnn
+{
+    bool
+    search_matches(std::string_view haystack, std::string_view needle) noexcept
+    {
+        return haystack.contains(needle);
+    }
+
+    SearchChange
+    compare_searches(std::string_view old_needle, std::string_view new_needle) noexcept
+    {
+        if (old_needle == new_needle) return SearchChange::SAME;
+        // Any haystack holding new_needle holds each substring of it too
+        if (new_needle.contains(old_needle)) return SearchChange::MORE_STRICT;
+        if (old_needle.contains(new_needle)) return SearchChange::LESS_STRICT;
+        return SearchChange::DIFFERENT;
+    }
+
+} // namespace mnn
@@ -0,0 +1,46 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <string_view>
+
+namespace mnn
+{
+    // How a new search relates to the previous one, for Gtk::FilterChange
+    enum class SearchChange
+    {
+        SAME,
+        // Matches a subset of what the old one did
+        MORE_STRICT,
+        // Matches a superset of what the old one did
+        LESS_STRICT,
+        DIFFERENT,
+    };
+
+    /* Both strings are already folded (see Station::get_search_key()), so
+     * a match is a plain substring test. The empty needle matches all. */
+    [[nodiscard]] bool search_matches(std::string_view haystack, std::string_view needle) noexcept;
+
+    /* Typing onto the end of a search, or anywhere inside it, can only
+     * drop matches; deleting can only add them. Anything else is a new
+     * search. */
+    [[nodiscard]] SearchChange compare_searches(std::string_view old_needle, std::string_view new_needle) noexcept;
+
+} // namespace mnn
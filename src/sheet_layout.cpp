@@ -0,0 +1,42 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include "sheet_layout.hpp"
+
+namespace mnn
+{
+    std::vector<SheetPage>
+    paginate_sheet(std::span<const std::size_t> rows_per_column, std::size_t lanes, std::size_t rows_per_page)
+    {
+        lanes = std::max<std::size_t>(lanes, 1);
+        rows_per_page = std::max<std::size_t>(rows_per_page, 1);
+        std::vector<SheetPage> pages;
+        for (std::size_t first = 0; first < rows_per_column.size(); first += lanes) {
+            auto band = rows_per_column.subspan(first, std::min(lanes, rows_per_column.size() - first));
+            auto longest = std::ranges::max(band);
+            auto page_count = std::max<std::size_t>((longest + rows_per_page - 1) / rows_per_page, 1);
+            for (std::size_t p = 0; p < page_count; ++p) {
+                pages.push_back({ .first_column = first, .column_count = band.size(), .first_row = p * rows_per_page });
+            }
+        }
+        return pages;
+    }
+
+} // namespace mnn
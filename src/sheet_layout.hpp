@@ -0,0 +1,52 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace mnn
+{
+    struct SheetPage
+    {
+        std::size_t first_column;
+        std::size_t column_count;
+        // The same row range is shown for each of the page's columns
+        std::size_t first_row;
+    };
+
+    /* Pages of a paper check-in sheet. Net columns sit side by side, lanes
+     * at a time, and each page holds the next rows_per_page rows of each
+     * of them. A band of columns takes as many pages as its longest column
+     * needs, and at least one so an empty column still gets a page to
+     * write on, before the next band starts:
+     *
+     *     lanes 2, rows_per_page 2, columns A-F (3 rows), G-L (1), M-R (2)
+     *
+     *     page 0  A-F rows 0-1, G-L row 0
+     *     page 1  A-F row 2
+     *     page 2  M-R rows 0-1
+     *
+     * Only pages are materialized, so a statewide roster costs a few
+     * hundred entries. */
+    [[nodiscard]] std::vector<SheetPage> paginate_sheet(std::span<const std::size_t> rows_per_column, std::size_t lanes, std::size_t rows_per_page);
+
+} // namespace mnn
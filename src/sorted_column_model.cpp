@@ -0,0 +1,307 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <unordered_set>
+#include "metrics.hpp"
+#include "sorted_column_model.hpp"
+#include "station.hpp"
+
+namespace
+{
+    using namespace std::literals;
+
+    // Past this many changed rows one reset beats moving them one by one
+    constexpr std::size_t min_rebuild_rows = 64;
+
+    bool
+    affects_key(mnn::RosterSort sort, std::string_view property)
+    {
+        if ("callsign"sv == property) return true;
+        switch (sort) {
+            case mnn::RosterSort::SUFFIX:   return "suffix"sv == property;
+            case mnn::RosterSort::CALLSIGN: return false;
+            case mnn::RosterSort::NAME:     return "name"sv == property;
+            case mnn::RosterSort::STATUS:   return "status"sv == property;
+            case mnn::RosterSort::DISTANCE: return "has-location"sv == property || "latitude"sv == property || "longitude"sv == property;
+        }
+        return false;
+    }
+
+    mnn::Counter&
+    moves_counter()
+    {
+        static auto& counter = mnn::metrics().counter("mnn_sort_moves", "Stations moved within a sorted column");
+        return counter;
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+using namespace peel;
+
+PEEL_CLASS_IMPL (SortedColumnModel, "MNNSortedColumnModel", Object)
+
+void
+SortedColumnModel::init_type(Type tp)
+{
+    PEEL_IMPLEMENT_INTERFACE(tp, Gio::ListModel);
+}
+
+void
+SortedColumnModel::init_interface(Gio::ListModel::Iface* iface)
+{
+    auto c_iface = reinterpret_cast<GListModelInterface*>(iface);
+    c_iface->get_item_type = &SortedColumnModel::get_item_type;
+    c_iface->get_n_items = &SortedColumnModel::get_n_items;
+    c_iface->get_item = &SortedColumnModel::get_item;
+}
+
+void
+SortedColumnModel::Class::init()
+{
+    override_vfunc_dispose<SortedColumnModel>();
+    override_vfunc_finalize<SortedColumnModel>();
+}
+
+void
+SortedColumnModel::init(Class*)
+{
+    new (&m) Members;
+    m.sort = RosterSort::SUFFIX;
+}
+
+void
+SortedColumnModel::vfunc_dispose()
+{
+    if (m.child) {
+        g_signal_handler_disconnect(m.child, m.items_changed_id);
+        g_clear_object(&m.child);
+    }
+    for (auto& entry : m.entries) {
+        release(*entry);
+    }
+    m.entries.clear();
+    m.sorted.clear();
+    parent_vfunc_dispose<SortedColumnModel>();
+}
+
+void
+SortedColumnModel::vfunc_finalize()
+{
+    m.~Members();
+    parent_vfunc_finalize<SortedColumnModel>();
+}
+
+RefPtr<SortedColumnModel>
+SortedColumnModel::create(GListModel* child, RosterSort sort, std::optional<std::pair<double, double>> origin)
+{
+    RefPtr<SortedColumnModel> model = Object::create<SortedColumnModel>();
+    auto& m = model->m;
+    m.sort = sort;
+    m.origin = origin;
+    m.child = G_LIST_MODEL(g_object_ref(child));
+    m.items_changed_id = g_signal_connect(child, "items-changed", G_CALLBACK(&SortedColumnModel::on_items_changed),
+                                          static_cast<SortedColumnModel*>(model));
+    model->rebuild();
+    return model;
+}
+
+void
+SortedColumnModel::set_sort(RosterSort sort, std::optional<std::pair<double, double>> origin)
+{
+    m.sort = sort;
+    m.origin = origin;
+    for (auto& entry : m.entries) {
+        update_key(*entry);
+    }
+    std::ranges::sort(m.sorted, {}, &Entry::key);
+    auto n = static_cast<guint>(m.sorted.size());
+    g_list_model_items_changed(G_LIST_MODEL(this), 0, n, n);
+}
+
+std::unique_ptr<SortedColumnModel::Entry>
+SortedColumnModel::make_entry(guint child_position)
+{
+    auto station = static_cast<Station*>(g_list_model_get_item(m.child, child_position));
+    auto entry = std::make_unique<Entry>(this, station, std::string(), 0UL);
+    update_key(*entry);
+    // One handler for every property, so a new sort order needs no reconnecting
+    entry->notify_id = g_signal_connect(station, "notify", G_CALLBACK(&SortedColumnModel::on_station_notify), entry.get());
+    return entry;
+}
+
+void
+SortedColumnModel::release(Entry& entry)
+{
+    g_signal_handler_disconnect(entry.station, entry.notify_id);
+    g_object_unref(entry.station);
+}
+
+void
+SortedColumnModel::update_key(Entry& entry)
+{
+    auto& s = *entry.station;
+    // Short enough to stay in the small string buffer
+    auto callsign = s.get_callsign();
+    SortFields fields{ .callsign = callsign,
+                       .suffix = s.get_suffix(),
+                       .status = s.get_status() };
+    if (RosterSort::NAME == m.sort) {
+        fields.name_key = s.get_name_collation_key();
+    }
+    if (RosterSort::DISTANCE == m.sort && m.origin) {
+        fields.distance_km = s.get_location().transform([this](auto l) {
+            return great_circle_km(m.origin->first, m.origin->second, l.first, l.second);
+        });
+    }
+    roster_sort_key(m.sort, fields, entry.key);
+}
+
+std::size_t
+SortedColumnModel::sorted_index(const Entry& entry) const
+{
+    // Keys end in the callsign, so this is almost always the first candidate
+    auto it = std::ranges::lower_bound(m.sorted, entry.key, {}, &Entry::key);
+    while (it != m.sorted.end() && *it != &entry && (*it)->key == entry.key) ++it;
+    return static_cast<std::size_t>(it - m.sorted.begin());
+}
+
+void
+SortedColumnModel::rebuild()
+{
+    auto old_size = static_cast<guint>(m.sorted.size());
+    for (auto& entry : m.entries) {
+        release(*entry);
+    }
+    m.entries.clear();
+    m.sorted.clear();
+    auto n = g_list_model_get_n_items(m.child);
+    m.entries.reserve(n);
+    for (guint i = 0; i < n; ++i) {
+        m.entries.push_back(make_entry(i));
+    }
+    m.sorted.reserve(n);
+    for (auto& entry : m.entries) {
+        m.sorted.push_back(entry.get());
+    }
+    std::ranges::sort(m.sorted, {}, &Entry::key);
+    if (0 != old_size || 0 != n) {
+        g_list_model_items_changed(G_LIST_MODEL(this), 0, old_size, n);
+    }
+}
+
+GType
+SortedColumnModel::get_item_type(GListModel* list)
+{
+    return g_list_model_get_item_type(reinterpret_cast<SortedColumnModel*>(list)->m.child);
+}
+
+guint
+SortedColumnModel::get_n_items(GListModel* list)
+{
+    return static_cast<guint>(reinterpret_cast<SortedColumnModel*>(list)->m.sorted.size());
+}
+
+gpointer
+SortedColumnModel::get_item(GListModel* list, guint position)
+{
+    auto& m = reinterpret_cast<SortedColumnModel*>(list)->m;
+    if (position >= m.sorted.size()) return nullptr;
+    return g_object_ref(m.sorted[position]->station);
+}
+
+void
+SortedColumnModel::on_items_changed(GListModel*, guint position, guint removed, guint added, gpointer data)
+{
+    auto self = static_cast<SortedColumnModel*>(data);
+    auto& m = self->m;
+    if (removed + added > std::max(min_rebuild_rows, m.entries.size() / 8)) {
+        self->rebuild();
+        return;
+    }
+
+    if (0 == removed && 0 == added) return;
+
+    auto first = m.entries.begin() + position;
+    std::unordered_set<const Entry*> gone;
+    for (auto& entry : std::ranges::subrange(first, first + removed)) {
+        gone.insert(entry.get());
+    }
+    std::vector<std::unique_ptr<Entry>> fresh;
+    std::vector<Entry*> incoming;
+    for (guint i = 0; i < added; ++i) {
+        fresh.push_back(self->make_entry(position + i));
+        incoming.push_back(fresh.back().get());
+    }
+    std::ranges::sort(incoming, {}, &Entry::key);
+
+    // The whole batch in one pass, rather than an O(N) erase or insert per row
+    std::vector<Entry*> sorted;
+    sorted.reserve(m.sorted.size() - removed + added);
+    std::ranges::merge(m.sorted | std::views::filter([&gone](const Entry* e) { return !gone.contains(e); }), incoming,
+                       std::back_inserter(sorted), {}, &Entry::key, &Entry::key);
+
+    // Reported as one change between the untouched head and tail
+    auto head = static_cast<std::size_t>(std::ranges::mismatch(m.sorted, sorted).in1 - m.sorted.begin());
+    auto limit = std::min(m.sorted.size(), sorted.size()) - head;
+    auto tail = 0UZ;
+    while (tail < limit && m.sorted[m.sorted.size() - 1 - tail] == sorted[sorted.size() - 1 - tail]) ++tail;
+    auto old_size = m.sorted.size();
+
+    for (auto& entry : std::ranges::subrange(first, first + removed)) {
+        self->release(*entry);
+    }
+    m.entries.erase(first, first + removed);
+    m.entries.insert(m.entries.begin() + position, std::make_move_iterator(fresh.begin()), std::make_move_iterator(fresh.end()));
+    m.sorted = std::move(sorted);
+    g_list_model_items_changed(G_LIST_MODEL(self), static_cast<guint>(head),
+                               static_cast<guint>(old_size - head - tail), static_cast<guint>(m.sorted.size() - head - tail));
+}
+
+void
+SortedColumnModel::on_station_notify(::GObject*, GParamSpec* pspec, gpointer data)
+{
+    auto& entry = *static_cast<Entry*>(data);
+    auto self = entry.model;
+    auto& m = self->m;
+    if (!affects_key(m.sort, g_param_spec_get_name(pspec))) return;
+
+    auto old_index = self->sorted_index(entry);
+    auto old_key = entry.key;
+    self->update_key(entry);
+    if (entry.key == old_key) return;
+
+    // Search without the entry, whose new key may be out of place
+    m.sorted.erase(m.sorted.begin() + static_cast<std::ptrdiff_t>(old_index));
+    auto it = std::ranges::upper_bound(m.sorted, entry.key, {}, &Entry::key);
+    auto new_index = static_cast<std::size_t>(it - m.sorted.begin());
+    m.sorted.insert(it, &entry);
+    if (new_index == old_index) return;
+
+    moves_counter().add();
+    g_list_model_items_changed(G_LIST_MODEL(self), static_cast<guint>(old_index), 1, 0);
+    g_list_model_items_changed(G_LIST_MODEL(self), static_cast<guint>(new_index), 0, 1);
+}
+
+} // namespace mnn
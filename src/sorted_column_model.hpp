@@ -0,0 +1,98 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gio/gio.h>
+#include <peel/Gio/Gio.h>
+#include <peel/class.h>
+#include "roster_sort.hpp"
+
+namespace mnn
+{
+    class Station;
+
+    /* A column's stations in RosterSort order. Each station's sort key is
+     * built once and compared bytewise; a station whose key changes (say,
+     * on check-in under STATUS) is moved by binary search, so one update
+     * costs O(log N) and a single pair of items-changed. A child change is
+     * merged in with one pass over the list and reported as one
+     * items-changed; only a new sort order or a large child change
+     * rebuilds the whole list. */
+    class SortedColumnModel final : public peel::Gio::ListModel
+    {
+        PEEL_SIMPLE_CLASS (SortedColumnModel, Object)
+        friend class peel::Gio::ListModel;
+
+        static void init_type(peel::Type tp);
+        static void init_interface(peel::Gio::ListModel::Iface*);
+        void init(Class*);
+
+        struct Entry {
+            SortedColumnModel* model;
+            // Strong ref
+            Station* station;
+            std::string key;
+            gulong notify_id;
+        };
+
+        struct Members {
+            GListModel* child;
+            gulong items_changed_id;
+            RosterSort sort;
+            // Reference point for DISTANCE
+            std::optional<std::pair<double, double>> origin;
+            // In child order, so removals can be found by position
+            std::vector<std::unique_ptr<Entry>> entries;
+            // Ascending key order
+            std::vector<Entry*> sorted;
+        } m;
+
+        static GType get_item_type(GListModel*);
+        static guint get_n_items(GListModel*);
+        static gpointer get_item(GListModel*, guint position);
+        static void on_items_changed(GListModel* child, guint position, guint removed, guint added, gpointer self);
+        static void on_station_notify(::GObject* station, GParamSpec*, gpointer entry);
+
+        std::unique_ptr<Entry> make_entry(guint child_position);
+        void release(Entry&);
+        void update_key(Entry&);
+        std::size_t sorted_index(const Entry&) const;
+        void rebuild();
+
+    public:
+        /* origin is the (latitude, longitude) DISTANCE measures from;
+         * without one every station sorts as unlocated. */
+        static peel::RefPtr<SortedColumnModel> create(GListModel* child, RosterSort sort, std::optional<std::pair<double, double>> origin = {});
+
+        [[nodiscard]] RosterSort get_sort() const { return m.sort; }
+        // Rekeys and re-sorts every station
+        void set_sort(RosterSort sort, std::optional<std::pair<double, double>> origin = {});
+
+    protected:
+        void vfunc_dispose();
+        void vfunc_finalize();
+    };
+
+} // namespace mnn
@@ -16,7 +16,10 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <cmath>
 #include <functional>
+#include <unordered_map>
+#include "metrics.hpp"
 #include "station.hpp"
 #include "mnn_error.hpp"
 
@@ -25,6 +28,28 @@ PEEL_ENUM_IMPL(mnn::StationStatus, "StationStatus",
                PEEL_ENUM_VALUE(mnn::StationStatus::HEARD_DIRECT, "heard-direct"),
                PEEL_ENUM_VALUE(mnn::StationStatus::HEARD_RELAY, "heard-relay"))
 
+namespace
+{
+    void (*parent_dispatch_properties_changed)(GObject*, guint, GParamSpec**) = nullptr;
+
+    // Counts what listeners actually see, after freeze_notify() coalescing
+    void
+    dispatch_properties_changed_counted(GObject* object, guint n_pspecs, GParamSpec** pspecs)
+    {
+        // Rosters are built on pool threads too; the registry hands every thread the same counters
+        static thread_local std::unordered_map<const GParamSpec*, mnn::Counter*> counters;
+        for (guint i = 0; i < n_pspecs; ++i) {
+            auto& counter = counters[pspecs[i]];
+            if (!counter) {
+                counter = &mnn::metrics().counter("mnn_notify", "Station property change notifications", { { "property", pspecs[i]->name } });
+            }
+            counter->add();
+        }
+        parent_dispatch_properties_changed(object, n_pspecs, pspecs);
+    }
+
+} // anonymous namespace
+
 namespace mnn
 {
 using namespace peel;
@@ -48,7 +73,10 @@ Station::init_interface(Shumate::Location::Iface* iface)
 void
 Station::Class::init()
 {
-
+    override_vfunc_finalize<Station>();
+    auto object_class = reinterpret_cast<GObjectClass*>(this);
+    parent_dispatch_properties_changed = object_class->dispatch_properties_changed;
+    object_class->dispatch_properties_changed = &dispatch_properties_changed_counted;
 }
 
 void
@@ -58,16 +86,23 @@ Station::init(Class*)
     m.status = StationStatus::PENDING;
 }
 
+void
+Station::vfunc_finalize()
+{
+    m.~Members();
+    parent_vfunc_finalize<Station>();
+}
+
 std::string
 Station::get_name() const
 {
-    return m.name;
+    return std::string(m.name);
 }
 
 std::string
 Station::get_callsign() const
 {
-    return m.callsign;
+    return std::string(m.callsign);
 }
 
 StationStatus
@@ -76,10 +111,70 @@ Station::get_status() const
     return m.status;
 }
 
+std::int64_t
+Station::get_heard_time() const
+{
+    return m.heard_time;
+}
+
+std::string_view
+Station::get_suffix() const
+{
+    return m.suffix;
+}
+
+std::optional<std::pair<double, double>>
+Station::get_location() const
+{
+    return m.location.transform([](const auto& l) { return std::pair(l.latitude, l.longitude); });
+}
+
+std::string_view
+Station::get_name_collation_key() const
+{
+    if (m.name_key.empty() && !m.name.empty()) {
+        auto key = g_utf8_collate_key(m.name.data(), static_cast<gssize>(m.name.size()));
+        m.name_key.assign(key);
+        g_free(key);
+    }
+    return m.name_key;
+}
+
+std::string_view
+Station::get_search_key() const
+{
+    if (m.search_key.empty()) {
+        m.search_key.assign(fold_for_search(m.callsign));
+        m.search_key.push_back('\n');
+        m.search_key.append(fold_for_search(m.name));
+    }
+    return m.search_key;
+}
+
+std::string
+Station::fold_for_search(std::string_view text)
+{
+    auto normalized = g_utf8_normalize(text.data(), static_cast<gssize>(text.size()), G_NORMALIZE_ALL);
+    if (!normalized) return {};
+    auto folded = g_utf8_casefold(normalized, -1);
+    g_free(normalized);
+    // Decomposed above, so dropping the marks leaves the base letters
+    std::string res;
+    for (auto p = folded; *p; p = g_utf8_next_char(p)) {
+        if (!g_unichar_ismark(g_utf8_get_char(p))) {
+            res.append(p, g_utf8_next_char(p));
+        }
+    }
+    g_free(folded);
+    return res;
+}
+
 void
 Station::set_name(std::string_view str)
 {
     m.name.assign(str);
+    m.name_key.clear();
+    m.search_key.clear();
     notify(prop_name());
 }
 
@@ -87,6 +182,7 @@ void
 Station::set_callsign(std::string_view str)
 {
     m.callsign.assign(str);
+    m.search_key.clear();
     freeze_notify();
     update_prefix_suffix();
     notify(prop_callsign());
@@ -96,10 +192,28 @@ Station::set_callsign(std::string_view str)
 void
 Station::set_status(StationStatus s)
 {
+    if (StationStatus::PENDING != s && s != m.status) {
+        m.heard_time = g_get_real_time() / 1000;
+    }
     m.status = s;
     notify(prop_status());
 }
 
+void
+Station::restore_check_in(StationStatus s, bool is_ack)
+{
+    freeze_notify();
+    if (s != m.status) {
+        m.status = s;
+        notify(prop_status());
+    }
+    if (is_ack != m.is_acknowledged) {
+        m.is_acknowledged = is_ack;
+        notify(prop_is_acknowledged());
+    }
+    thaw_notify();
+}
+
 bool
 Station::is_assistant_emergency_coordinator() const
 {
@@ -123,27 +237,65 @@ void
 Station::set_is_acknowledged(bool is_ack)
 {
     freeze_notify();
-    if (StationStatus::PENDING == m.status) {
-        set_status(StationStatus::HEARD_RELAY);
+    if (auto status = status_after_acknowledge(m.status); status != m.status) {
+        set_status(status);
     }
     m.is_acknowledged = is_ack;
     notify(prop_is_acknowledged());
     thaw_notify();
 }
 
+bool
+Station::update_roster_fields(const StationRecord& record)
+{
+    bool changed = false;
+    freeze_notify();
+    if (m.name != record.name) {
+        set_name(record.name);
+        changed = true;
+    }
+    if (m.is_assistant_emergency_coordinator != record.is_assistant_emergency_coordinator) {
+        set_is_assistant_emergency_coordinator(record.is_assistant_emergency_coordinator);
+        changed = true;
+    }
+    auto same_location = m.location.has_value() == record.location.has_value() &&
+        (!m.location || (m.location->latitude == record.location->first &&
+                         m.location->longitude == record.location->second));
+    if (!same_location) {
+        auto [latitude, longitude] = record.location.value_or(std::pair{ SHUMATE_MIN_LATITUDE, SHUMATE_MIN_LONGITUDE });
+        vfunc_set_location(latitude, longitude);
+        changed = true;
+    }
+    thaw_notify();
+    return changed;
+}
+
 void
 Station::update_prefix_suffix()
 {
-    auto pos = m.callsign.find_first_of("0123456789");
-    if (std::string::npos == pos) {
+    update_prefix_suffix(split_callsign(m.callsign));
+}
+
+void
+Station::update_prefix_suffix(const CallsignSplit& split)
+{
+    if (split.valid) {
+        m.prefix.assign(m.callsign, 0, split.suffix_begin);
+        m.suffix.assign(m.callsign, split.suffix_begin);
+        m.entity = callsign_entity(m.callsign, split);
+    } else if (auto pos = m.callsign.find_first_of("0123456789"); std::string::npos != pos) {
+        // Not a callsign we understand, but keep something in the columns
+        m.prefix.assign(m.callsign, 0, pos + 1);
+        m.suffix.assign(m.callsign, pos + 1);
+        m.entity = {};
+    } else {
         m.prefix.clear();
         m.suffix.clear();
-    } else {
-        m.prefix = m.callsign.substr(0, pos + 1);
-        m.suffix = m.callsign.substr(pos + 1);
+        m.entity = {};
     }
     notify(prop_prefix());
     notify(prop_suffix());
+    notify(prop_entity());
 }
 
 double
@@ -208,6 +360,14 @@ Station::get_suffix_cstr()
     return m.suffix.c_str();
 }
 
+const char*
+Station::get_entity_cstr()
+{
+    // Entities are string literals, so the view is NUL terminated
+    if (m.entity.empty()) return nullptr;
+    return m.entity.data();
+}
+
 void
 Station::set_callsign_cstr(const char* str)
 {
@@ -216,6 +376,7 @@ Station::set_callsign_cstr(const char* str)
     } else {
         m.callsign.clear();
     }
+    m.search_key.clear();
 
     freeze_notify();
     update_prefix_suffix();
@@ -231,31 +392,71 @@ Station::set_name_cstr(const char* str)
     } else {
         m.name.clear();
     }
+    m.name_key.clear();
+    m.search_key.clear();
 
     notify(prop_name());
 }
 
-RefPtr<Station>
-Station::create(const nlohmann::json& j)
+std::expected<RefPtr<Station>, field_error>
+Station::try_create(const nlohmann::json& j, std::shared_ptr<RosterArena> arena) noexcept
 {
-    if (!j.contains("name")) {
-        throw std::system_error(std::make_error_code(mnn::error::missing_name), std::format("Station record missing 'name' field: {}", j.dump()));
+    CallsignSplit split;
+    if (j.is_object()) {
+        if (auto it = j.find("callsign"); j.end() != it && it->is_string()) {
+            split = split_callsign(it->get_ref<const std::string&>());
+        }
     }
-    if (!j.contains("callsign")) {
-        throw std::system_error(std::make_error_code(mnn::error::missing_callsign), std::format("Station record missing 'callsign' field: {}", j.dump()));
+    return try_create(j, std::move(arena), split);
+}
+
+std::expected<RefPtr<Station>, field_error>
+Station::try_create(const nlohmann::json& j, std::shared_ptr<RosterArena> arena, const CallsignSplit& split) noexcept
+{
+    auto record = read_station_record(j, split);
+    if (!record) {
+        return std::unexpected(record.error());
     }
+    return create(*record, std::move(arena));
+}
 
-    auto name = j["name"].get<std::string>();
-    auto callsign = j["callsign"].get<std::string>();
-    auto is_aem = j.contains("assistant_emergency_coordinator") && true == j["assistant_emergency_coordinator"].get<bool>();
-    auto res = Object::create<mnn::Station>(mnn::Station::prop_name(), name.c_str(),
-                                            mnn::Station::prop_callsign(), callsign.c_str(),
-                                            mnn::Station::prop_is_assistant_emergency_coordinator(), is_aem);
-    if (j.contains("lat") && j.contains("long"))
-    {
-        res->set_location(j["lat"].get<double>(), j["long"].get<double>());
+RefPtr<Station>
+Station::create(const StationRecord& record, std::shared_ptr<RosterArena> arena)
+{
+    auto res = Object::create<mnn::Station>();
+    auto& m = res->m;
+    if (arena) {
+        // Nothing has been allocated yet, so rebuild the members on the arena
+        auto resource = arena.get();
+        m.~Members();
+        new (&m) Members { .arena = std::move(arena),
+                           .name = std::pmr::string(resource),
+                           .callsign = std::pmr::string(resource),
+                           .prefix = std::pmr::string(resource),
+                           .suffix = std::pmr::string(resource),
+                           .name_key = std::pmr::string(resource),
+                           .search_key = std::pmr::string(resource),
+                           .status = StationStatus::PENDING };
     }
+    // Copy straight out of the DOM; nobody can be listening for notify yet
+    m.name.assign(record.name);
+    m.callsign.assign(record.callsign);
+    m.is_assistant_emergency_coordinator = record.is_assistant_emergency_coordinator;
+    if (record.location) {
+        m.location.emplace(record.location->first, record.location->second);
+    }
+    res->update_prefix_suffix(record.split);
     return res;
 }
 
+RefPtr<Station>
+Station::create(const nlohmann::json& j, std::shared_ptr<RosterArena> arena)
+{
+    auto res = try_create(j, std::move(arena));
+    if (!res) {
+        throw std::system_error(res.error().code, std::format("Station record has bad '{}' field: {}", res.error().field, j.dump()));
+    }
+    return std::move(*res);
+}
+
 } // namespace mnn
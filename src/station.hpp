@@ -18,6 +18,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <optional>
@@ -28,16 +32,12 @@
 #include <peel/GLib/GLib.h>
 #include <peel/Shumate/Location.h>
 #include <nlohmann/json.hpp>
+#include "callsign.hpp"
+#include "mnn_error.hpp"
+#include "roster_arena.hpp"
+#include "station_record.hpp"
+#include "station_status.hpp"
 
-namespace mnn
-{
-    enum class StationStatus
-    {
-        PENDING,
-        HEARD_DIRECT,
-        HEARD_RELAY
-    };
-}
 PEEL_ENUM(mnn::StationStatus)
 
 namespace mnn
@@ -57,14 +57,24 @@ namespace mnn
         };
 
         struct Members {
-            std::string name;
-            std::string callsign;
-            std::string prefix;
-            std::string suffix;
+            // Declared first so it outlives the strings allocated from it
+            std::shared_ptr<RosterArena> arena;
+            std::pmr::string name;
+            std::pmr::string callsign;
+            std::pmr::string prefix;
+            std::pmr::string suffix;
+            // g_utf8_collate_key() of name, built on first use for sorting
+            mutable std::pmr::string name_key;
+            // fold_for_search() of callsign and name, built on first search
+            mutable std::pmr::string search_key;
+            // Points into the static ITU table
+            std::string_view entity;
             bool is_assistant_emergency_coordinator;
             bool is_acknowledged;
             StationStatus status;
             std::optional<Location> location;
+            // Unix milliseconds of the latest check-in, 0 for none
+            std::int64_t heard_time;
         } m;
 
     public:
@@ -72,6 +82,7 @@ namespace mnn
         PEEL_PROPERTY(const char *, callsign, "callsign");
         PEEL_PROPERTY(const char *, prefix, "prefix");
         PEEL_PROPERTY(const char *, suffix, "suffix");
+        PEEL_PROPERTY(const char *, entity, "entity");
         PEEL_PROPERTY(bool, is_acknowledged, "is-acknowledged");
         PEEL_PROPERTY(bool, is_assistant_emergency_coordinator, "is-assistant-emergency-coordinator");
         PEEL_PROPERTY(StationStatus, status, "status");
@@ -88,20 +99,54 @@ namespace mnn
         bool has_location() const;
         StationStatus get_status() const;
         void set_status(StationStatus status);
-
-        static peel::RefPtr<Station> create(const nlohmann::json&);
+        std::string_view get_suffix() const;
+        // Unix milliseconds when the status last became a heard one, 0 if never this session
+        std::int64_t get_heard_time() const;
+        /* Puts back a status and acknowledgement recorded earlier, as undo
+         * does. Unlike the setters it leaves the heard time alone, since
+         * nobody was heard just now. */
+        void restore_check_in(StationStatus status, bool acknowledged);
+        std::optional<std::pair<double, double>> get_location() const;
+        /* Locale aware sort key for the name; compare keys bytewise instead
+         * of collating names. Valid until the name changes. */
+        std::string_view get_name_collation_key() const;
+        /* Callsign and name, folded for search_matches() and separated by a
+         * newline so no match spans both. Valid until either changes. */
+        std::string_view get_search_key() const;
+
+        // Compatibility normalized, casefolded and stripped of accents
+        static std::string fold_for_search(std::string_view text);
+
+        /* Takes the roster fields (name, AEC, location) of record, leaving
+         * session state alone. Only changed properties are notified, and
+         * only changed strings are copied. Returns whether anything changed. */
+        bool update_roster_fields(const StationRecord& record);
+
+        /* Strings are allocated from arena when given, so a whole roster can
+         * share a few blocks that are freed with its last Station. */
+        static peel::RefPtr<Station> create(const nlohmann::json&, std::shared_ptr<RosterArena> arena = nullptr);
+        static peel::RefPtr<Station> create(const StationRecord&, std::shared_ptr<RosterArena> arena = nullptr);
+        /* As create(), but reports the first bad field instead of throwing.
+         * Nothing is formatted on failure, so dirty rosters stay cheap. */
+        static std::expected<peel::RefPtr<Station>, field_error> try_create(const nlohmann::json&, std::shared_ptr<RosterArena> arena = nullptr) noexcept;
+        /* For bulk import: split is the already validated split_callsign()
+         * of the record's callsign. */
+        static std::expected<peel::RefPtr<Station>, field_error> try_create(const nlohmann::json&, std::shared_ptr<RosterArena> arena, const CallsignSplit& split) noexcept;
 
     protected:
+        void vfunc_finalize();
         double vfunc_get_latitude() const noexcept;
         double vfunc_get_longitude() const noexcept;
         void vfunc_set_location(double, double) noexcept;
 
     private:
         void update_prefix_suffix();
+        void update_prefix_suffix(const CallsignSplit&);
         const char* get_name_cstr();
         const char* get_callsign_cstr();
         const char* get_prefix_cstr();
         const char* get_suffix_cstr();
+        const char* get_entity_cstr();
         void set_name_cstr(const char* str);
         void set_callsign_cstr(const char* str);
 
@@ -119,6 +164,8 @@ namespace mnn
                 .get(&Station::get_prefix_cstr);
             f.prop(prop_suffix(), nullptr)
                 .get(&Station::get_suffix_cstr);
+            f.prop(prop_entity(), nullptr)
+                .get(&Station::get_entity_cstr);
             f.prop(prop_is_acknowledged(), false)
                 .get(&Station::is_acknowledged)
                 .set(&Station::set_is_acknowledged);
@@ -0,0 +1,170 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include "net_library.hpp"
+#include "station_history.hpp"
+
+namespace mnn
+{
+    using namespace peel;
+
+    StationHistory::StationHistory(Net& n, std::size_t capacity) :
+        net(n),
+        log(capacity),
+        held(metrics().gauge("mnn_undo_deltas", "Station changes held for undo"))
+    {
+        auto store = G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations));
+        items_changed_id = g_signal_connect(store, "items-changed", G_CALLBACK(&StationHistory::on_items_changed), this);
+    }
+
+    StationHistory::~StationHistory()
+    {
+        g_signal_handler_disconnect(G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations)), items_changed_id);
+        held.add(-static_cast<std::int64_t>(reported));
+    }
+
+    void
+    StationHistory::on_items_changed(GListModel* model, guint position, guint removed, guint added, gpointer data)
+    {
+        auto self = static_cast<StationHistory*>(data);
+        // Walk-ins are appended and leave every recorded row where it was
+        if (0 == removed && position + added == g_list_model_get_n_items(model)) return;
+        self->log.clear();
+        self->changed();
+    }
+
+    template <typename F>
+    void
+    StationHistory::change(guint row, Station* station, F&& apply)
+    {
+        auto status = station->get_status();
+        bool acknowledged = station->is_acknowledged();
+        apply();
+        // set_is_acknowledged() may move status too; both belong to one step
+        Group step(log);
+        log.record(row, StationDelta::STATUS, static_cast<std::uint8_t>(status), static_cast<std::uint8_t>(station->get_status()));
+        log.record(row, StationDelta::ACKNOWLEDGED, acknowledged, station->is_acknowledged());
+    }
+
+    void
+    StationHistory::set_status(Station* station, StationStatus status)
+    {
+        guint row = 0;
+        if (!g_list_store_find(G_LIST_STORE(static_cast<Gio::ListStore*>(net.stations)), station, &row)) {
+            station->set_status(status);
+            return;
+        }
+        change(row, station, [station, status] { station->set_status(status); });
+        changed();
+    }
+
+    void
+    StationHistory::reset_all()
+    {
+        auto store = G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations));
+        auto n = g_list_model_get_n_items(store);
+        std::vector<Station*> frozen;
+        Group step(log);
+        for (guint i = 0; i < n; ++i) {
+            auto station = static_cast<Station*>(g_list_model_get_item(store, i));
+            if (StationStatus::PENDING == station->get_status() && !station->is_acknowledged()) {
+                g_object_unref(station);
+                continue;
+            }
+            station->freeze_notify();
+            frozen.push_back(station);
+            change(i, station, [station] {
+                if (station->is_acknowledged()) station->set_is_acknowledged(false);
+                station->set_status(StationStatus::PENDING);
+            });
+        }
+        for (auto station : frozen) {
+            station->thaw_notify();
+            g_object_unref(station);
+        }
+        changed();
+    }
+
+    std::size_t
+    StationHistory::undo()
+    {
+        return replay(log.undo(), false);
+    }
+
+    std::size_t
+    StationHistory::redo()
+    {
+        return replay(log.redo(), true);
+    }
+
+    std::size_t
+    StationHistory::replay(std::vector<StationDelta> step, bool forward)
+    {
+        /* Per row, the last delta of each field wins: undo steps come newest
+         * first, so that's the earliest before, and redo steps oldest first,
+         * so the latest after. */
+        std::ranges::stable_sort(step, {}, &StationDelta::row);
+        auto store = G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations));
+        auto n = g_list_model_get_n_items(store);
+        std::vector<Station*> frozen;
+        for (auto it = step.begin(); it != step.end();) {
+            auto row = it->row;
+            std::optional<StationStatus> status;
+            std::optional<bool> acknowledged;
+            for (; it != step.end() && it->row == row; ++it) {
+                auto value = forward ? it->after : it->before;
+                if (StationDelta::STATUS == it->field) {
+                    status = static_cast<StationStatus>(value);
+                } else {
+                    acknowledged = 0 != value;
+                }
+            }
+            if (row >= n) continue;
+            auto station = static_cast<Station*>(g_list_model_get_item(store, row));
+            station->freeze_notify();
+            frozen.push_back(station);
+            // Recorded values, so the heard time stays when it really was
+            station->restore_check_in(status.value_or(station->get_status()), acknowledged.value_or(station->is_acknowledged()));
+        }
+        for (auto station : frozen) {
+            station->thaw_notify();
+            g_object_unref(station);
+        }
+        changed();
+        return frozen.size();
+    }
+
+    void
+    StationHistory::set_changed_callback(std::function<void()> callback)
+    {
+        on_changed = std::move(callback);
+    }
+
+    void
+    StationHistory::changed()
+    {
+        held.add(static_cast<std::int64_t>(log.size()) - static_cast<std::int64_t>(reported));
+        reported = log.size();
+        if (on_changed) on_changed();
+    }
+
+} // namespace mnn
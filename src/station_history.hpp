@@ -0,0 +1,92 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <gio/gio.h>
+#include "metrics.hpp"
+#include "station.hpp"
+#include "undo_log.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    /* Undo and redo of check-ins made from this window. Changes go through
+     * here rather than straight to the Station so they are recorded; what
+     * arrives from the daemon, replication or replay isn't.
+     *
+     * Rows are positions in the net's store, so any store change other than
+     * an append (a walk-in) clears the history. Undo and redo apply a whole
+     * step at once with every touched station's notifications frozen, the
+     * way UpdateDispatcher batches, and keep each station's heard time. */
+    class StationHistory
+    {
+    public:
+        explicit StationHistory(Net& net, std::size_t capacity = UndoLog::default_capacity);
+        ~StationHistory();
+        StationHistory(const StationHistory&) = delete;
+        StationHistory& operator=(const StationHistory&) = delete;
+
+        void set_status(Station*, StationStatus);
+        // Every station back to pending and unacknowledged, as one step
+        void reset_all();
+
+        // Return how many stations changed
+        std::size_t undo();
+        std::size_t redo();
+        [[nodiscard]] bool can_undo() const noexcept { return log.can_undo(); }
+        [[nodiscard]] bool can_redo() const noexcept { return log.can_redo(); }
+
+        // Whenever can_undo() or can_redo() may have changed
+        void set_changed_callback(std::function<void()>);
+
+    private:
+        // RAII begin_group()/end_group()
+        class Group
+        {
+        public:
+            explicit Group(UndoLog& log) : log(log) { log.begin_group(); }
+            ~Group() { log.end_group(); }
+            Group(const Group&) = delete;
+            Group& operator=(const Group&) = delete;
+
+        private:
+            UndoLog& log;
+        };
+
+        static void on_items_changed(GListModel*, guint position, guint removed, guint added, gpointer self);
+
+        template <typename F> void change(guint row, Station*, F&& apply);
+        std::size_t replay(std::vector<StationDelta> step, bool forward);
+        void changed();
+
+        Net& net;
+        UndoLog log;
+        gulong items_changed_id = 0;
+        std::function<void()> on_changed;
+        Gauge& held;
+        // This history's share of held
+        std::size_t reported = 0;
+    };
+
+} // namespace mnn
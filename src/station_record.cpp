@@ -0,0 +1,125 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <format>
+#include <unordered_set>
+#include "station_record.hpp"
+
+namespace mnn
+{
+    std::expected<StationRecord, field_error>
+    read_station_record(const nlohmann::json& j, const CallsignSplit& split) noexcept
+    {
+        auto fail = [](const char* field, mnn::error e) {
+            return std::unexpected(field_error{ field, std::make_error_code(e) });
+        };
+
+        if (!j.is_object()) {
+            return fail("", mnn::error::invalid_field_type);
+        }
+        auto name_it = j.find("name");
+        if (j.end() == name_it) {
+            return fail("name", mnn::error::missing_name);
+        }
+        if (!name_it->is_string()) {
+            return fail("name", mnn::error::invalid_field_type);
+        }
+        auto callsign_it = j.find("callsign");
+        if (j.end() == callsign_it) {
+            return fail("callsign", mnn::error::missing_callsign);
+        }
+        if (!callsign_it->is_string()) {
+            return fail("callsign", mnn::error::invalid_field_type);
+        }
+        if (!split.valid) {
+            return fail("callsign", mnn::error::invalid_callsign);
+        }
+        StationRecord record{ .callsign = callsign_it->get_ref<const std::string&>(),
+                              .name = name_it->get_ref<const std::string&>(),
+                              .split = split };
+        if (auto it = j.find("assistant_emergency_coordinator"); j.end() != it) {
+            if (!it->is_boolean()) {
+                return fail("assistant_emergency_coordinator", mnn::error::invalid_field_type);
+            }
+            record.is_assistant_emergency_coordinator = it->get<bool>();
+        }
+        auto lat_it = j.find("lat");
+        auto long_it = j.find("long");
+        if (j.end() != lat_it && j.end() != long_it) {
+            if (!lat_it->is_number() || !long_it->is_number()) {
+                return fail("lat", mnn::error::invalid_location);
+            }
+            auto latitude = lat_it->get<double>();
+            auto longitude = long_it->get<double>();
+            if (!std::isfinite(latitude) || !std::isfinite(longitude) ||
+                std::abs(latitude) > 90.0 || std::abs(longitude) > 180.0) {
+                return fail("lat", mnn::error::invalid_location);
+            }
+            record.location.emplace(latitude, longitude);
+        }
+        return record;
+    }
+
+    RosterRecords
+    read_roster(const nlohmann::json& stations)
+    {
+        RosterRecords result;
+        if (!stations.is_array()) {
+            result.diagnostics.emplace_back(0UZ, "stations", std::make_error_code(error::invalid_field_type));
+            return result;
+        }
+
+        // Split and validate every callsign in one vectorized pass up front
+        std::vector<PackedCallsign> packed(stations.size());
+        for (auto index = 0UZ; const auto& record : stations) {
+            if (record.is_object()) {
+                if (auto it = record.find("callsign"); record.end() != it && it->is_string()) {
+                    packed[index] = PackedCallsign(it->get_ref<const std::string&>());
+                }
+            }
+            ++index;
+        }
+        std::vector<CallsignSplit> splits(packed.size());
+        split_callsigns(packed, splits);
+
+        result.records.reserve(stations.size());
+        std::unordered_set<std::string_view> seen;
+        seen.reserve(stations.size());
+        for (auto index = 0UZ; const auto& j : stations) {
+            if (auto record = read_station_record(j, splits[index])) {
+                if (seen.insert(record->callsign).second) {
+                    result.records.push_back(*record);
+                } else {
+                    result.diagnostics.emplace_back(index, "callsign", std::make_error_code(error::duplicate_callsign));
+                }
+            } else {
+                result.diagnostics.emplace_back(index, record.error().field, record.error().code);
+            }
+            ++index;
+        }
+        return result;
+    }
+
+    std::string
+    format_diagnostic(const ImportDiagnostic& d)
+    {
+        return std::format("record {}: {}: {}", d.index, d.field, d.code.message());
+    }
+
+} // namespace mnn
@@ -0,0 +1,71 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "callsign.hpp"
+#include "mnn_error.hpp"
+
+namespace mnn
+{
+    /* One validated record of a net definition's "stations" array. The
+     * strings point into the JSON it was read from. */
+    struct StationRecord
+    {
+        std::string_view callsign;
+        std::string_view name;
+        CallsignSplit split;
+        bool is_assistant_emergency_coordinator = false;
+        // Latitude and longitude in degrees
+        std::optional<std::pair<double, double>> location;
+    };
+
+    struct ImportDiagnostic
+    {
+        std::size_t index;
+        const char* field;
+        std::error_code code;
+    };
+
+    struct RosterRecords
+    {
+        std::vector<StationRecord> records;
+        std::vector<ImportDiagnostic> diagnostics;
+    };
+
+    /* The rules every roster follows, for Station and the headless
+     * NetSession alike. split is split_callsign() of the record's callsign. */
+    [[nodiscard]] std::expected<StationRecord, field_error> read_station_record(const nlohmann::json&, const CallsignSplit& split) noexcept;
+
+    /* Every valid record of a "stations" array, in order, with callsigns
+     * split in one vectorized pass. A callsign seen before is a duplicate
+     * and skipped. stations must outlive the result. */
+    [[nodiscard]] RosterRecords read_roster(const nlohmann::json& stations);
+
+    // One line per diagnostic, e.g. "record 12: callsign: Invalid callsign..."
+    [[nodiscard]] std::string format_diagnostic(const ImportDiagnostic&);
+
+} // namespace mnn
@@ -0,0 +1,42 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "station_status.hpp"
+
+namespace mnn
+{
+    /* One station's roster and check-in fields as plain data, locations in
+     * microdegrees. Used by the headless NetSession and by autosave
+     * snapshots. */
+    struct StationState
+    {
+        std::string callsign;
+        std::string name;
+        StationStatus status = StationStatus::PENDING;
+        bool acknowledged = false;
+        bool has_location = false;
+        std::int32_t latitude_udeg = 0;
+        std::int32_t longitude_udeg = 0;
+    };
+
+} // namespace mnn
@@ -0,0 +1,40 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+namespace mnn
+{
+    enum class StationStatus
+    {
+        PENDING,
+        HEARD_DIRECT,
+        HEARD_RELAY
+    };
+
+    /* Acknowledging a station nobody logged as heard means net control
+     * heard it through a relay. Shared by Station and the headless
+     * NetSession so the GUI and the daemon agree. */
+    constexpr StationStatus
+    status_after_acknowledge(StationStatus status)
+    {
+        return StationStatus::PENDING == status ? StationStatus::HEARD_RELAY : status;
+    }
+
+} // namespace mnn
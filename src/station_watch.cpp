@@ -0,0 +1,89 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <iterator>
+#include "net_library.hpp"
+#include "station_watch.hpp"
+
+namespace mnn
+{
+    using namespace peel;
+
+    StationWatch::~StationWatch()
+    {
+        stop();
+    }
+
+    void
+    StationWatch::start(Net& net, std::initializer_list<const char*> s, GCallback notify, gpointer d, Changed c)
+    {
+        stop();
+        model = G_LIST_MODEL(static_cast<Gio::ListStore*>(net.stations));
+        signals.assign(s);
+        on_notify = notify;
+        data = d;
+        changed = std::move(c);
+        track(0, 0, g_list_model_get_n_items(model));
+        items_changed_id = g_signal_connect(model, "items-changed", G_CALLBACK(&StationWatch::on_items_changed), this);
+    }
+
+    void
+    StationWatch::stop()
+    {
+        if (!model) return;
+        g_signal_handler_disconnect(model, items_changed_id);
+        items_changed_id = 0;
+        track(0, static_cast<guint>(watched.size()), 0);
+        model = nullptr;
+        changed = {};
+    }
+
+    void
+    StationWatch::track(guint position, guint removed, guint added)
+    {
+        auto first = watched.begin() + position;
+        for (auto it = first; it != first + removed; ++it) {
+            g_signal_handlers_disconnect_by_func(static_cast<Station*>(*it), reinterpret_cast<gpointer>(on_notify), data);
+        }
+        first = watched.erase(first, first + removed);
+
+        std::vector<RefPtr<Station>> inserted;
+        inserted.reserve(added);
+        for (auto i = position; i < position + added; ++i) {
+            auto item = g_list_model_get_item(model, i);
+            for (auto signal : signals) {
+                g_signal_connect(item, signal, on_notify, data);
+            }
+            inserted.emplace_back(reinterpret_cast<Station*>(item));
+            g_object_unref(item);
+        }
+        watched.insert(first, std::make_move_iterator(inserted.begin()), std::make_move_iterator(inserted.end()));
+    }
+
+    void
+    StationWatch::on_items_changed(GListModel*, guint position, guint removed, guint added, gpointer self)
+    {
+        auto watch = static_cast<StationWatch*>(self);
+        watch->track(position, removed, added);
+        if (watch->changed) {
+            watch->changed(position, removed, added);
+        }
+    }
+
+} // namespace mnn
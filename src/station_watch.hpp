@@ -0,0 +1,69 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <vector>
+#include <gio/gio.h>
+#include "station.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    /* Connects one notify handler to every Station in a net and keeps it
+     * connected as the store changes: stations inserted are watched and
+     * stations removed are disconnected and released, following each
+     * items-changed (position, removed, added). stations() stays in store
+     * order, so owners can look at what was just added. */
+    class StationWatch
+    {
+    public:
+        // Called after the watch has caught up with an items-changed
+        using Changed = std::function<void(guint position, guint removed, guint added)>;
+
+        StationWatch() = default;
+        ~StationWatch();
+        StationWatch(const StationWatch&) = delete;
+        StationWatch& operator=(const StationWatch&) = delete;
+
+        // signals are notify details with static storage, e.g. "notify::status"
+        void start(Net&, std::initializer_list<const char*> signals, GCallback on_notify, gpointer data, Changed = {});
+        void stop();
+
+        [[nodiscard]] std::span<const peel::RefPtr<Station>> stations() const { return watched; }
+
+    private:
+        static void on_items_changed(GListModel*, guint position, guint removed, guint added, gpointer self);
+
+        void track(guint position, guint removed, guint added);
+
+        GListModel* model = nullptr;
+        std::vector<const char*> signals;
+        GCallback on_notify = nullptr;
+        gpointer data = nullptr;
+        Changed changed;
+        std::vector<peel::RefPtr<Station>> watched;
+        gulong items_changed_id = 0;
+    };
+
+} // namespace mnn
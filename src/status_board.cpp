@@ -0,0 +1,679 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <magic_enum/magic_enum.hpp>
+#include <nlohmann/json.hpp>
+#include "status_board.hpp"
+
+namespace
+{
+    using namespace std::literals;
+
+    // A few seconds of a busy net plus a snapshot; a viewer further behind is dropped
+    constexpr std::size_t max_backlog = 4 * 1024 * 1024;
+    constexpr std::size_t max_request = 16 * 1024;
+    constexpr std::size_t max_client_frame = 64 * 1024;
+
+    constexpr std::string_view page = R"html(<!DOCTYPE html>
+<html lang="en">
+<head>
+<meta charset="utf-8">
+<meta name="viewport" content="width=device-width, initial-scale=1">
+<title>Monday Night Net</title>
+<style>
+body { font-family: sans-serif; margin: 1em; background: #fafafa; }
+#totals { margin-bottom: 1em; font-weight: bold; }
+#board { display: grid; grid-template-columns: repeat(auto-fill, minmax(9em, 1fr)); gap: 4px; }
+.station { padding: 4px 6px; border-radius: 4px; background: #e0e0e0; font-family: monospace; }
+.station small { display: block; font-family: sans-serif; color: #555; }
+.HEARD_DIRECT { background: #8ff0a4; }
+.HEARD_RELAY { background: #f9f06b; }
+.ack { outline: 2px solid #1c71d8; }
+#state { color: #c01c28; }
+</style>
+</head>
+<body>
+<div id="totals"></div><div id="state"></div>
+<div id="board"></div>
+<script>
+const cells = new Map();
+const board = document.getElementById('board');
+function render(s) {
+  let cell = cells.get(s.c);
+  if (!cell) {
+    cell = document.createElement('div');
+    cell.innerHTML = '<span></span><small></small>';
+    cell.firstChild.textContent = s.c;
+    cell.lastChild.textContent = s.n || '';
+    cells.set(s.c, cell);
+    board.appendChild(cell);
+  }
+  cell.className = 'station ' + s.s + (s.a ? ' ack' : '');
+  cell.dataset.status = s.s;
+}
+function count() {
+  let heard = 0;
+  for (const cell of cells.values()) if (cell.dataset.status !== 'PENDING') ++heard;
+  document.getElementById('totals').textContent = heard + ' of ' + cells.size + ' heard';
+}
+function connect() {
+  const ws = new WebSocket((location.protocol === 'https:' ? 'wss://' : 'ws://') + location.host + '/ws');
+  ws.onopen = () => { document.getElementById('state').textContent = ''; };
+  ws.onmessage = (e) => {
+    const m = JSON.parse(e.data);
+    if (m.type === 'snapshot') { cells.clear(); board.replaceChildren(); }
+    m.stations.forEach(render);
+    count();
+  };
+  ws.onclose = () => {
+    document.getElementById('state').textContent = 'Disconnected, retrying';
+    setTimeout(connect, 2000);
+  };
+}
+connect();
+</script>
+</body>
+</html>
+)html";
+
+    class Sha1
+    {
+    public:
+        void
+        update(std::string_view data)
+        {
+            for (auto c : data) {
+                block[used++] = static_cast<std::uint8_t>(c);
+                if (64 == used) compress();
+            }
+            length += data.size() * 8;
+        }
+
+        std::array<std::uint8_t, 20>
+        finish()
+        {
+            auto bits = length;
+            block[used++] = 0x80;
+            if (used > 56) {
+                std::fill(block.begin() + used, block.end(), 0);
+                compress();
+            }
+            std::fill(block.begin() + used, block.begin() + 56, 0);
+            for (auto i = 0; i < 8; ++i) {
+                block[63 - i] = static_cast<std::uint8_t>(bits >> (8 * i));
+            }
+            compress();
+            std::array<std::uint8_t, 20> out;
+            for (auto i = 0UZ; i < 20; ++i) {
+                out[i] = static_cast<std::uint8_t>(h[i / 4] >> (24 - 8 * (i % 4)));
+            }
+            return out;
+        }
+
+    private:
+        void
+        compress()
+        {
+            std::array<std::uint32_t, 80> w;
+            for (auto i = 0; i < 16; ++i) {
+                w[i] = static_cast<std::uint32_t>(block[4 * i]) << 24 | static_cast<std::uint32_t>(block[4 * i + 1]) << 16 |
+                       static_cast<std::uint32_t>(block[4 * i + 2]) << 8 | block[4 * i + 3];
+            }
+            for (auto i = 16; i < 80; ++i) {
+                w[i] = std::rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+            }
+            auto [a, b, c, d, e] = h;
+            for (auto i = 0; i < 80; ++i) {
+                std::uint32_t f, k;
+                if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+                else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+                else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+                else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+                auto t = std::rotl(a, 5) + f + e + k + w[i];
+                e = d;
+                d = c;
+                c = std::rotl(b, 30);
+                b = a;
+                a = t;
+            }
+            h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+            used = 0;
+        }
+
+        std::array<std::uint32_t, 5> h = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+        std::array<std::uint8_t, 64> block{};
+        std::size_t used = 0;
+        std::uint64_t length = 0;
+    };
+
+    std::string
+    base64(std::span<const std::uint8_t> in)
+    {
+        constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        for (auto i = 0UZ; i < in.size(); i += 3) {
+            std::uint32_t v = static_cast<std::uint32_t>(in[i]) << 16;
+            if (i + 1 < in.size()) v |= static_cast<std::uint32_t>(in[i + 1]) << 8;
+            if (i + 2 < in.size()) v |= in[i + 2];
+            out += alphabet[(v >> 18) & 63];
+            out += alphabet[(v >> 12) & 63];
+            out += i + 1 < in.size() ? alphabet[(v >> 6) & 63] : '=';
+            out += i + 2 < in.size() ? alphabet[v & 63] : '=';
+        }
+        return out;
+    }
+
+    // Server frames are never masked or fragmented
+    std::string
+    ws_frame(std::uint8_t opcode, std::string_view payload)
+    {
+        std::string out;
+        out.reserve(payload.size() + 10);
+        out += static_cast<char>(0x80 | opcode);
+        if (payload.size() < 126) {
+            out += static_cast<char>(payload.size());
+        } else if (payload.size() <= 0xFFFF) {
+            out += static_cast<char>(126);
+            out += static_cast<char>(payload.size() >> 8);
+            out += static_cast<char>(payload.size() & 0xFF);
+        } else {
+            out += static_cast<char>(127);
+            for (auto i = 7; i >= 0; --i) {
+                out += static_cast<char>((static_cast<std::uint64_t>(payload.size()) >> (8 * i)) & 0xFF);
+            }
+        }
+        out += payload;
+        return out;
+    }
+
+    std::string
+    http_response(std::string_view status, std::string_view type, std::string_view body)
+    {
+        return std::string("HTTP/1.1 ").append(status)
+            .append("\r\nContent-Type: ").append(type)
+            .append("\r\nContent-Length: ").append(std::to_string(body.size()))
+            .append("\r\nCache-Control: no-store\r\nConnection: close\r\n\r\n")
+            .append(body);
+    }
+
+    bool
+    iequals(std::string_view a, std::string_view b)
+    {
+        return std::ranges::equal(a, b, [](char x, char y) {
+            return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+        });
+    }
+
+    std::string_view
+    trim(std::string_view s)
+    {
+        while (!s.empty() && (' ' == s.front() || '\t' == s.front())) s.remove_prefix(1);
+        while (!s.empty() && (' ' == s.back() || '\t' == s.back())) s.remove_suffix(1);
+        return s;
+    }
+
+    nlohmann::json
+    station_json(const mnn::BoardStation& s, bool with_name)
+    {
+        nlohmann::json j = { { "c", s.callsign },
+                             { "s", magic_enum::enum_name(s.status) },
+                             { "a", s.acknowledged } };
+        if (with_name) j["n"] = s.name;
+        return j;
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    std::string
+    websocket_accept_key(std::string_view key)
+    {
+        Sha1 sha;
+        sha.update(key);
+        sha.update("258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+        auto digest = sha.finish();
+        return base64(digest);
+    }
+
+    StatusBoardServer::StatusBoardServer(StatusBoardOptions options) :
+        options(std::move(options))
+    {
+    }
+
+    StatusBoardServer::~StatusBoardServer()
+    {
+        stop();
+    }
+
+    std::error_code
+    StatusBoardServer::start()
+    {
+        auto fail = [this] {
+            std::error_code ec{ errno, std::system_category() };
+            stop();
+            return ec;
+        };
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(options.port);
+        if (1 != ::inet_pton(AF_INET, options.address.c_str(), &addr.sin_addr)) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listen_fd < 0) return fail();
+        int one = 1;
+        ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            ::listen(listen_fd, 64) < 0 ||
+            ::pipe2(wake_fds, O_NONBLOCK | O_CLOEXEC) < 0) {
+            return fail();
+        }
+        socklen_t len = sizeof(addr);
+        ::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        bound_port = ntohs(addr.sin_port);
+        thread = std::jthread([this](std::stop_token token) { run(token); });
+        return {};
+    }
+
+    void
+    StatusBoardServer::stop()
+    {
+        if (thread.joinable()) {
+            thread.request_stop();
+            [[maybe_unused]] auto n = ::write(wake_fds[1], "x", 1);
+            thread.join();
+        }
+        for (auto& c : clients) {
+            ::close(c.fd);
+        }
+        clients.clear();
+        viewers = 0;
+        for (auto& fd : { &listen_fd, &wake_fds[0], &wake_fds[1] }) {
+            if (*fd >= 0) ::close(*fd);
+            *fd = -1;
+        }
+    }
+
+    void
+    StatusBoardServer::set_roster(std::vector<BoardStation> roster, std::vector<std::string> totals)
+    {
+        {
+            std::lock_guard lock(mutex);
+            next_roster = std::move(roster);
+            next_totals = std::move(totals);
+            roster_changed = true;
+            // Already part of the new roster
+            added.clear();
+        }
+        if (wake_fds[1] >= 0) {
+            [[maybe_unused]] auto n = ::write(wake_fds[1], "r", 1);
+        }
+    }
+
+    void
+    StatusBoardServer::add(BoardStation station)
+    {
+        bool first;
+        {
+            std::lock_guard lock(mutex);
+            first = added.empty() && pending.empty();
+            added.push_back(std::move(station));
+        }
+        if (first && wake_fds[1] >= 0) {
+            [[maybe_unused]] auto n = ::write(wake_fds[1], "a", 1);
+        }
+    }
+
+    void
+    StatusBoardServer::update(std::string_view callsign, StationStatus status, bool acknowledged)
+    {
+        bool first;
+        {
+            std::lock_guard lock(mutex);
+            first = added.empty() && pending.empty();
+            pending.insert_or_assign(std::string(callsign), Change{ status, acknowledged });
+        }
+        // Only the first change of a batch wakes the server, to start its flush timer
+        if (first && wake_fds[1] >= 0) {
+            [[maybe_unused]] auto n = ::write(wake_fds[1], "u", 1);
+        }
+    }
+
+    void
+    StatusBoardServer::run(std::stop_token token)
+    {
+        std::vector<pollfd> fds;
+        // Armed by the first pending change; idle, the loop sleeps until a client or update() wakes it
+        std::optional<std::chrono::steady_clock::time_point> next_flush;
+        while (!token.stop_requested()) {
+            fds.clear();
+            fds.push_back({ wake_fds[0], POLLIN, 0 });
+            fds.push_back({ listen_fd, POLLIN, 0 });
+            for (const auto& c : clients) {
+                short events = POLLIN;
+                if (!c.out.empty()) events |= POLLOUT;
+                fds.push_back({ c.fd, events, 0 });
+            }
+            int timeout = -1;
+            if (next_flush) {
+                auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(*next_flush - std::chrono::steady_clock::now());
+                timeout = static_cast<int>(std::max(0LL, static_cast<long long>(wait.count())) + 1);
+            }
+            if (::poll(fds.data(), fds.size(), timeout) < 0) {
+                if (EINTR == errno) continue;
+                break;
+            }
+            bool new_roster = false;
+            if (fds[0].revents & POLLIN) {
+                char drain[64];
+                while (::read(wake_fds[0], drain, sizeof(drain)) > 0) {}
+                std::lock_guard lock(mutex);
+                new_roster = roster_changed;
+                if (!next_flush && (!added.empty() || !pending.empty())) {
+                    next_flush = std::chrono::steady_clock::now() + options.min_interval;
+                }
+            }
+
+            auto it = clients.begin();
+            for (auto i = 2UZ; i < fds.size(); ++i) {
+                bool alive = true;
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    alive = read_client(*it);
+                }
+                if (!alive) {
+                    ::close(it->fd);
+                    it = clients.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            if (fds[1].revents & POLLIN) {
+                accept_clients();
+            }
+
+            // A new roster doesn't wait for the timer
+            if (new_roster || (next_flush && std::chrono::steady_clock::now() >= *next_flush)) {
+                apply_pending();
+                next_flush.reset();
+            }
+
+            std::size_t websockets = 0;
+            for (auto c = clients.begin(); clients.end() != c; ) {
+                if (!flush_client(*c) || (c->closing && c->out.empty())) {
+                    ::close(c->fd);
+                    c = clients.erase(c);
+                } else {
+                    websockets += c->websocket;
+                    ++c;
+                }
+            }
+            viewers.store(websockets, std::memory_order_relaxed);
+        }
+    }
+
+    void
+    StatusBoardServer::accept_clients()
+    {
+        for (;;) {
+            auto fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;
+            clients.push_back({ .fd = fd });
+        }
+    }
+
+    bool
+    StatusBoardServer::read_client(Client& c)
+    {
+        std::array<char, 16 * 1024> chunk;
+        for (;;) {
+            auto n = ::recv(c.fd, chunk.data(), chunk.size(), 0);
+            if (n > 0) {
+                c.in.append(chunk.data(), static_cast<std::size_t>(n));
+                if (!(c.websocket ? handle_frames(c) : handle_request(c))) return false;
+                continue;
+            }
+            if (0 == n) return false;
+            if (EINTR == errno) continue;
+            return EAGAIN == errno || EWOULDBLOCK == errno;
+        }
+    }
+
+    bool
+    StatusBoardServer::handle_request(Client& c)
+    {
+        if (c.closing) {
+            // One request per connection; ignore anything pipelined
+            c.in.clear();
+            return true;
+        }
+        auto end = c.in.find("\r\n\r\n");
+        if (std::string::npos == end) {
+            return c.in.size() <= max_request;
+        }
+        std::string_view request(c.in.data(), end);
+        auto line_end = request.find("\r\n");
+        auto line = request.substr(0, line_end);
+        std::string_view method = line.substr(0, line.find(' '));
+        auto target = line.substr(std::min(line.size(), method.size() + 1));
+        target = target.substr(0, target.find(' '));
+        target = target.substr(0, target.find('?'));
+
+        std::string_view upgrade, key;
+        auto headers = std::string_view::npos == line_end ? std::string_view{} : request.substr(line_end + 2);
+        while (!headers.empty()) {
+            auto eol = headers.find("\r\n");
+            auto header = headers.substr(0, eol);
+            headers = std::string_view::npos == eol ? std::string_view{} : headers.substr(eol + 2);
+            auto colon = header.find(':');
+            if (std::string_view::npos == colon) continue;
+            auto name = header.substr(0, colon);
+            auto value = trim(header.substr(colon + 1));
+            if (iequals(name, "upgrade")) upgrade = value;
+            else if (iequals(name, "sec-websocket-key")) key = value;
+        }
+
+        if ("GET"sv != method) {
+            queue(c, std::make_shared<const std::string>(http_response("405 Method Not Allowed", "text/plain", "GET only\n")));
+            c.closing = true;
+        } else if ("/ws"sv == target && iequals(upgrade, "websocket") && !key.empty()) {
+            auto response = std::string("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: ")
+                .append(websocket_accept_key(key)).append("\r\n\r\n");
+            queue(c, std::make_shared<const std::string>(std::move(response)));
+            queue(c, snapshot_frame());
+            c.websocket = true;
+        } else if ("/"sv == target) {
+            static const auto response = std::make_shared<const std::string>(http_response("200 OK", "text/html; charset=utf-8", page));
+            queue(c, response);
+            c.closing = true;
+        } else if ("/snapshot"sv == target) {
+            queue(c, std::make_shared<const std::string>(http_response("200 OK", "application/json", snapshot_json())));
+            c.closing = true;
+        } else {
+            queue(c, std::make_shared<const std::string>(http_response("404 Not Found", "text/plain", "Not found\n")));
+            c.closing = true;
+        }
+        c.in.erase(0, end + 4);
+        return c.websocket ? handle_frames(c) : true;
+    }
+
+    bool
+    StatusBoardServer::handle_frames(Client& c)
+    {
+        // Viewers are read only; all that matters is ping and close
+        while (c.in.size() >= 2) {
+            auto byte = [&c](std::size_t i) { return static_cast<std::uint8_t>(c.in[i]); };
+            auto opcode = byte(0) & 0x0F;
+            bool masked = byte(1) & 0x80;
+            std::uint64_t length = byte(1) & 0x7F;
+            std::size_t header = 2;
+            if (126 == length) {
+                if (c.in.size() < 4) return true;
+                length = static_cast<std::uint64_t>(byte(2)) << 8 | byte(3);
+                header = 4;
+            } else if (127 == length) {
+                if (c.in.size() < 10) return true;
+                length = 0;
+                for (auto i = 2UZ; i < 10; ++i) length = length << 8 | byte(i);
+                header = 10;
+            }
+            if (length > max_client_frame) return false;
+            auto mask_at = header;
+            if (masked) header += 4;
+            if (c.in.size() < header + length) return true;
+
+            std::string payload = c.in.substr(header, static_cast<std::size_t>(length));
+            if (masked) {
+                for (auto i = 0UZ; i < payload.size(); ++i) {
+                    payload[i] = static_cast<char>(payload[i] ^ c.in[mask_at + i % 4]);
+                }
+            }
+            c.in.erase(0, header + static_cast<std::size_t>(length));
+            if (0x8 == opcode) {
+                queue(c, std::make_shared<const std::string>(ws_frame(0x8, payload.substr(0, 2))));
+                c.closing = true;
+                return true;
+            }
+            if (0x9 == opcode) {
+                queue(c, std::make_shared<const std::string>(ws_frame(0xA, payload)));
+            }
+        }
+        return true;
+    }
+
+    void
+    StatusBoardServer::queue(Client& c, Buffer buffer)
+    {
+        c.queued += buffer->size();
+        c.out.push_back(std::move(buffer));
+    }
+
+    bool
+    StatusBoardServer::flush_client(Client& c)
+    {
+        while (!c.out.empty()) {
+            const auto& front = *c.out.front();
+            auto n = ::send(c.fd, front.data() + c.out_offset, front.size() - c.out_offset, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (EINTR == errno) continue;
+                if (EAGAIN != errno && EWOULDBLOCK != errno) return false;
+                break;
+            }
+            c.out_offset += static_cast<std::size_t>(n);
+            c.queued -= static_cast<std::size_t>(n);
+            if (c.out_offset == front.size()) {
+                c.out.pop_front();
+                c.out_offset = 0;
+            }
+        }
+        return c.queued <= max_backlog;
+    }
+
+    void
+    StatusBoardServer::apply_pending()
+    {
+        std::vector<BoardStation> appended;
+        std::unordered_map<std::string, Change> changes;
+        bool new_roster = false;
+        {
+            std::lock_guard lock(mutex);
+            if (roster_changed) {
+                roster = std::move(next_roster);
+                totals = std::move(next_totals);
+                next_roster.clear();
+                next_totals.clear();
+                roster_changed = false;
+                new_roster = true;
+            }
+            appended.swap(added);
+            changes.swap(pending);
+        }
+
+        if (new_roster) {
+            index.clear();
+            for (auto i = 0UZ; i < roster.size(); ++i) {
+                index.emplace(roster[i].callsign, i);
+            }
+        }
+        auto delta = nlohmann::json::array();
+        // The page adds a cell for any callsign it hasn't seen, so new stations ride along in the delta
+        for (auto& station : appended) {
+            if (!index.emplace(station.callsign, roster.size()).second) continue;
+            if (!new_roster) delta.push_back(station_json(station, true));
+            roster.push_back(std::move(station));
+        }
+        for (auto& [callsign, change] : changes) {
+            auto it = index.find(callsign);
+            if (index.end() == it) continue;
+            auto& s = roster[it->second];
+            if (s.status == change.status && s.acknowledged == change.acknowledged) continue;
+            s.status = change.status;
+            s.acknowledged = change.acknowledged;
+            if (!new_roster) delta.push_back(station_json(s, false));
+        }
+        if (!new_roster && delta.empty()) return;
+
+        ++seq;
+        snapshot.reset();
+        Buffer frame = new_roster
+            ? snapshot_frame()
+            : std::make_shared<const std::string>(ws_frame(0x1, nlohmann::json{ { "type", "delta" }, { "seq", seq }, { "stations", std::move(delta) } }.dump()));
+        // Serialized once; every viewer's queue shares the bytes
+        for (auto& c : clients) {
+            if (c.websocket && !c.closing) queue(c, frame);
+        }
+    }
+
+    StatusBoardServer::Buffer
+    StatusBoardServer::snapshot_frame()
+    {
+        if (!snapshot) {
+            snapshot = std::make_shared<const std::string>(ws_frame(0x1, snapshot_json()));
+        }
+        return snapshot;
+    }
+
+    std::string
+    StatusBoardServer::snapshot_json() const
+    {
+        auto stations = nlohmann::json::array();
+        for (const auto& s : roster) {
+            stations.push_back(station_json(s, true));
+        }
+        return nlohmann::json{ { "type", "snapshot" },
+                               { "seq", seq },
+                               { "totals", totals },
+                               { "stations", std::move(stations) } }.dump();
+    }
+
+} // namespace mnn
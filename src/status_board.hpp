@@ -0,0 +1,147 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "station_status.hpp"
+
+namespace mnn
+{
+    struct BoardStation
+    {
+        std::string callsign;
+        std::string name;
+        StationStatus status = StationStatus::PENDING;
+        bool acknowledged = false;
+    };
+
+    struct StatusBoardOptions
+    {
+        // Bind to a LAN address (or 0.0.0.0) to let served agencies watch
+        std::string address = "127.0.0.1";
+        // 0 picks a free port; see StatusBoardServer::port()
+        std::uint16_t port = 8073;
+        // Changes are coalesced per station and pushed this long after the first of a batch
+        std::chrono::milliseconds min_interval{250};
+    };
+
+    // Sec-WebSocket-Accept for a client's Sec-WebSocket-Key (RFC 6455)
+    [[nodiscard]] std::string websocket_accept_key(std::string_view key);
+
+    /* A read only status board for spectators, served over plain HTTP.
+     *
+     *   GET /          a page that renders the board
+     *   GET /snapshot  the board as JSON
+     *   GET /ws        WebSocket: a snapshot, then deltas
+     *
+     * Runs on its own thread around poll(), like NetDaemon. Callers hand it
+     * the roster once and then individual changes, from any thread. Each
+     * push is serialized once into a WebSocket frame that every viewer's
+     * queue shares, so viewers cost a send() each and nothing more. A
+     * viewer that stops reading is dropped. */
+    class StatusBoardServer
+    {
+    public:
+        explicit StatusBoardServer(StatusBoardOptions);
+        ~StatusBoardServer();
+        StatusBoardServer(const StatusBoardServer&) = delete;
+        StatusBoardServer& operator=(const StatusBoardServer&) = delete;
+
+        std::error_code start();
+        void stop();
+
+        // Replaces the roster; viewers get a fresh snapshot
+        void set_roster(std::vector<BoardStation> roster, std::vector<std::string> totals);
+        // Appends a station; viewers get it in the next delta
+        void add(BoardStation station);
+        void update(std::string_view callsign, StationStatus status, bool acknowledged);
+
+        [[nodiscard]] std::uint16_t port() const { return bound_port; }
+        [[nodiscard]] std::size_t viewer_count() const { return viewers.load(std::memory_order_relaxed); }
+
+    private:
+        using Buffer = std::shared_ptr<const std::string>;
+
+        struct Client
+        {
+            int fd;
+            std::string in;
+            std::deque<Buffer> out;
+            std::size_t out_offset = 0;
+            std::size_t queued = 0;
+            bool websocket = false;
+            bool closing = false;
+        };
+
+        struct Change
+        {
+            StationStatus status;
+            bool acknowledged;
+        };
+
+        void run(std::stop_token);
+        void accept_clients();
+        bool read_client(Client&);
+        bool handle_request(Client&);
+        bool handle_frames(Client&);
+        bool flush_client(Client&);
+        void queue(Client&, Buffer);
+        void apply_pending();
+        Buffer snapshot_frame();
+        std::string snapshot_json() const;
+
+        StatusBoardOptions options;
+        int listen_fd = -1;
+        // Written to wake the poll loop for stop(), set_roster() and the first add() or update() of a batch
+        int wake_fds[2] = { -1, -1 };
+        std::uint16_t bound_port = 0;
+        std::atomic<std::size_t> viewers = 0;
+        std::jthread thread;
+
+        std::mutex mutex;
+        // Guarded by mutex
+        std::vector<BoardStation> next_roster;
+        std::vector<std::string> next_totals;
+        bool roster_changed = false;
+        std::vector<BoardStation> added;
+        std::unordered_map<std::string, Change> pending;
+
+        // Server thread only
+        std::vector<BoardStation> roster;
+        std::vector<std::string> totals;
+        std::unordered_map<std::string, std::size_t> index;
+        std::list<Client> clients;
+        std::uint64_t seq = 0;
+        Buffer snapshot;
+    };
+
+} // namespace mnn
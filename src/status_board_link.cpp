@@ -0,0 +1,92 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "net_library.hpp"
+#include "status_board_link.hpp"
+
+namespace mnn
+{
+    using namespace peel;
+
+    StatusBoardLink::StatusBoardLink(Net& net, StatusBoardOptions options) :
+        net(net),
+        server(std::move(options))
+    {
+    }
+
+    StatusBoardLink::~StatusBoardLink()
+    {
+        stop();
+    }
+
+    std::error_code
+    StatusBoardLink::start()
+    {
+        stop();
+        if (auto ec = server.start()) {
+            return ec;
+        }
+        watch.start(net, { "notify::status", "notify::is-acknowledged" }, G_CALLBACK(&StatusBoardLink::on_notify), this,
+                    [this](guint position, guint removed, guint added) { on_roster_changed(position, removed, added); });
+        send_roster();
+        return {};
+    }
+
+    void
+    StatusBoardLink::stop()
+    {
+        watch.stop();
+        server.stop();
+    }
+
+    void
+    StatusBoardLink::send_roster()
+    {
+        std::vector<BoardStation> roster;
+        roster.reserve(watch.stations().size());
+        for (const auto& ref : watch.stations()) {
+            auto station = static_cast<Station*>(ref);
+            roster.push_back({ station->get_callsign(), station->get_name(), station->get_status(), station->is_acknowledged() });
+        }
+        server.set_roster(std::move(roster), net.totals);
+    }
+
+    void
+    StatusBoardLink::on_roster_changed(guint position, guint removed, guint added)
+    {
+        // Check-ins append and go out as deltas; reloads and removals are rare, so viewers just get a new snapshot
+        if (0 != removed || position + added != watch.stations().size()) {
+            send_roster();
+            return;
+        }
+        for (const auto& ref : watch.stations().subspan(position, added)) {
+            auto station = static_cast<Station*>(ref);
+            server.add({ station->get_callsign(), station->get_name(), station->get_status(), station->is_acknowledged() });
+        }
+    }
+
+    void
+    StatusBoardLink::on_notify(GObject* object, GParamSpec*, gpointer data)
+    {
+        auto self = static_cast<StatusBoardLink*>(data);
+        auto station = reinterpret_cast<Station*>(object);
+        self->server.update(station->get_callsign(), station->get_status(), station->is_acknowledged());
+    }
+
+} // namespace mnn
@@ -0,0 +1,58 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <system_error>
+#include <gio/gio.h>
+#include "station.hpp"
+#include "station_watch.hpp"
+#include "status_board.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    /* Feeds a net's roster and check-ins to a StatusBoardServer so served
+     * agencies can follow along in a browser. Notifies are forwarded as
+     * they happen; the server coalesces them and bounds the push rate, so
+     * nothing here waits on the network. */
+    class StatusBoardLink
+    {
+    public:
+        StatusBoardLink(Net& net, StatusBoardOptions options);
+        ~StatusBoardLink();
+        StatusBoardLink(const StatusBoardLink&) = delete;
+        StatusBoardLink& operator=(const StatusBoardLink&) = delete;
+
+        std::error_code start();
+        void stop();
+
+    private:
+        static void on_notify(GObject* station, GParamSpec* pspec, gpointer self);
+
+        void on_roster_changed(guint position, guint removed, guint added);
+        void send_roster();
+
+        Net& net;
+        StatusBoardServer server;
+        StationWatch watch;
+    };
+
+} // namespace mnn
@@ -0,0 +1,239 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mnn
+{
+    template<typename T = void>
+    class Task;
+
+    namespace detail
+    {
+        struct PromiseBase
+        {
+            // Resumed when the task finishes; empty for spawned tasks
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+            bool detached = false;
+
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+
+                template<typename Promise>
+                std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<Promise> h) noexcept
+                {
+                    auto& p = h.promise();
+                    if (p.continuation) return p.continuation;
+                    if (p.detached) h.destroy();
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+
+            void
+            unhandled_exception() noexcept
+            {
+                // Nobody is left to rethrow to, same as an exception escaping a thread
+                if (detached) std::terminate();
+                exception = std::current_exception();
+            }
+        };
+
+        template<typename T>
+        struct Promise : PromiseBase
+        {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            template<typename U = T>
+            void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+
+            T
+            result()
+            {
+                if (exception) std::rethrow_exception(exception);
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct Promise<void> : PromiseBase
+        {
+            Task<void> get_return_object() noexcept;
+            void return_void() const noexcept {}
+
+            void
+            result()
+            {
+                if (exception) std::rethrow_exception(exception);
+            }
+        };
+
+    } // namespace detail
+
+    /* A lazily started coroutine. Nothing runs until the task is awaited,
+     * which resumes the awaiter on whichever thread the task finishes on;
+     * spawn() starts one with nobody waiting. Where a task runs is up to
+     * what it awaits: ThreadPool::schedule() moves it to a worker and
+     * resume_on_main() back to the GLib main context.
+     *
+     * Exceptions propagate to the awaiter. A spawned task has none, so it
+     * must handle its own or the process terminates. */
+    template<typename T>
+    class [[nodiscard]] Task
+    {
+    public:
+        using promise_type = detail::Promise<T>;
+
+        Task() noexcept = default;
+        explicit Task(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+        Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+        Task&
+        operator=(Task&& other) noexcept
+        {
+            if (this != &other) {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+
+        ~Task()
+        {
+            if (handle) handle.destroy();
+        }
+
+        auto
+        operator co_await() && noexcept
+        {
+            struct Awaiter
+            {
+                std::coroutine_handle<promise_type> handle;
+
+                bool await_ready() const noexcept { return !handle || handle.done(); }
+
+                std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume() { return handle.promise().result(); }
+            };
+            return Awaiter{ handle };
+        }
+
+        // Runs the task to its first suspension with nobody waiting; it frees itself when done
+        friend void
+        spawn(Task task)
+        {
+            auto h = std::exchange(task.handle, {});
+            h.promise().detached = true;
+            h.resume();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    namespace detail
+    {
+        template<typename T>
+        Task<T>
+        Promise<T>::get_return_object() noexcept
+        {
+            return Task<T>{ std::coroutine_handle<Promise<T>>::from_promise(*this) };
+        }
+
+        inline Task<void>
+        Promise<void>::get_return_object() noexcept
+        {
+            return Task<void>{ std::coroutine_handle<Promise<void>>::from_promise(*this) };
+        }
+
+        struct SyncWaitState
+        {
+            std::mutex mutex;
+            std::condition_variable done_cv;
+            bool done = false;
+
+            void
+            finish()
+            {
+                // Notify under the lock: the waiter may free us as soon as it can lock
+                std::lock_guard lock(mutex);
+                done = true;
+                done_cv.notify_one();
+            }
+        };
+
+    } // namespace detail
+
+    /* Blocks the calling thread until the task finishes, for tools and
+     * tests. Never call it on the main loop with a task that resumes there. */
+    template<typename T>
+    T
+    sync_wait(Task<T> task)
+    {
+        detail::SyncWaitState state;
+        std::exception_ptr exception;
+        using Slot = std::conditional_t<std::is_void_v<T>, bool, std::optional<T>>;
+        Slot slot{};
+
+        auto waiter = [](Task<T> t, detail::SyncWaitState& s, std::exception_ptr& e, Slot& out) -> Task<void> {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    co_await std::move(t);
+                } else {
+                    out.emplace(co_await std::move(t));
+                }
+            } catch (...) {
+                e = std::current_exception();
+            }
+            s.finish();
+        };
+        spawn(waiter(std::move(task), state, exception, slot));
+
+        std::unique_lock lock(state.mutex);
+        state.done_cv.wait(lock, [&state] { return state.done; });
+        if (exception) std::rethrow_exception(exception);
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*slot);
+        }
+    }
+
+} // namespace mnn
@@ -0,0 +1,122 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include "thread_pool.hpp"
+
+namespace
+{
+    // Which pool and worker the current thread is, so nested work stays local
+    thread_local const mnn::ThreadPool* current_pool = nullptr;
+    thread_local std::size_t current_index = 0;
+
+} // anonymous namespace
+
+namespace mnn
+{
+    ThreadPool::ThreadPool(std::size_t count)
+    {
+        if (0 == count) {
+            count = std::max(1U, std::thread::hardware_concurrency());
+        }
+        workers.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        threads.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            threads.emplace_back([this, i](std::stop_token stop) { run(stop, i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        for (auto& t : threads) {
+            t.request_stop();
+        }
+        wake.notify_all();
+        threads.clear();
+    }
+
+    void
+    ThreadPool::post(std::coroutine_handle<> h)
+    {
+        auto index = this == current_pool ? current_index : next.fetch_add(1, std::memory_order_relaxed) % workers.size();
+        {
+            auto& w = *workers[index];
+            std::lock_guard lock(w.mutex);
+            w.jobs.push_back(h);
+        }
+        pending.fetch_add(1, std::memory_order_release);
+        // A worker between checking pending and sleeping holds sleep_mutex; don't notify into that gap
+        { std::lock_guard lock(sleep_mutex); }
+        wake.notify_one();
+    }
+
+    std::coroutine_handle<>
+    ThreadPool::take(std::size_t index)
+    {
+        {
+            auto& own = *workers[index];
+            std::lock_guard lock(own.mutex);
+            if (!own.jobs.empty()) {
+                auto h = own.jobs.back();
+                own.jobs.pop_back();
+                return h;
+            }
+        }
+        for (std::size_t i = 1; i < workers.size(); ++i) {
+            auto& victim = *workers[(index + i) % workers.size()];
+            std::unique_lock lock(victim.mutex, std::try_to_lock);
+            if (!lock || victim.jobs.empty()) continue;
+            auto h = victim.jobs.front();
+            victim.jobs.pop_front();
+            stolen.fetch_add(1, std::memory_order_relaxed);
+            return h;
+        }
+        return {};
+    }
+
+    void
+    ThreadPool::run(std::stop_token stop, std::size_t index)
+    {
+        current_pool = this;
+        current_index = index;
+        while (!stop.stop_requested()) {
+            if (0 != pending.load(std::memory_order_acquire)) {
+                if (auto h = take(index)) {
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    h.resume();
+                }
+                // Either ran something or lost a race for it; look again
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex);
+            wake.wait(lock, stop, [this] { return 0 != pending.load(std::memory_order_acquire); });
+        }
+    }
+
+    ThreadPool&
+    thread_pool()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+} // namespace mnn
@@ -0,0 +1,95 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace mnn
+{
+    /* CPU work for Tasks. Each worker has its own deque: work a worker
+     * schedules goes on its own back and is taken LIFO while it is still
+     * warm in cache, and idle workers steal from the front of the others.
+     * Work scheduled from outside the pool (the main loop) is dealt round
+     * robin. Workers sleep when there is nothing to steal.
+     *
+     *     co_await thread_pool().schedule();
+     *     // now on a worker
+     *
+     * Work still queued when the pool is destroyed is never resumed. */
+    class ThreadPool
+    {
+    public:
+        // 0 is one per hardware thread
+        explicit ThreadPool(std::size_t threads = 0);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]] auto
+        schedule() noexcept
+        {
+            struct Awaiter
+            {
+                ThreadPool& pool;
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> h) { pool.post(h); }
+                void await_resume() const noexcept {}
+            };
+            return Awaiter{ *this };
+        }
+
+        void post(std::coroutine_handle<>);
+        [[nodiscard]] std::size_t size() const noexcept { return workers.size(); }
+        // Number of jobs run by a worker other than the one they were queued on
+        [[nodiscard]] std::size_t steals() const noexcept { return stolen.load(std::memory_order_relaxed); }
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<std::coroutine_handle<>> jobs;
+        };
+
+        void run(std::stop_token, std::size_t index);
+        std::coroutine_handle<> take(std::size_t index);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::atomic<std::size_t> next = 0;
+        std::atomic<std::size_t> pending = 0;
+        std::atomic<std::size_t> stolen = 0;
+        std::mutex sleep_mutex;
+        std::condition_variable_any wake;
+        // Last, so the workers stop before anything they use goes away
+        std::vector<std::jthread> threads;
+    };
+
+    // Process wide pool, created on first use
+    [[nodiscard]] ThreadPool& thread_pool();
+
+} // namespace mnn
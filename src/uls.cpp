@@ -0,0 +1,403 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "uls.hpp"
+
+namespace
+{
+    std::error_code
+    last_error()
+    {
+        return { errno, std::system_category() };
+    }
+
+    class MappedFile
+    {
+    public:
+        static std::expected<MappedFile, std::error_code>
+        open(const std::filesystem::path& path)
+        {
+            auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return std::unexpected(last_error());
+            struct stat st;
+            if (::fstat(fd, &st) < 0) {
+                auto ec = last_error();
+                ::close(fd);
+                return std::unexpected(ec);
+            }
+            MappedFile f;
+            f.size = static_cast<std::size_t>(st.st_size);
+            if (f.size > 0) {
+                f.data = ::mmap(nullptr, f.size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd);
+            if (MAP_FAILED == f.data) {
+                f.data = nullptr;
+                return std::unexpected(last_error());
+            }
+            ::madvise(f.data, f.size, MADV_SEQUENTIAL);
+            return f;
+        }
+
+        MappedFile() = default;
+        MappedFile(MappedFile&& o) noexcept : data(std::exchange(o.data, nullptr)), size(std::exchange(o.size, 0)) {}
+        ~MappedFile() { if (data) ::munmap(data, size); }
+
+        [[nodiscard]] std::string_view text() const { return { static_cast<const char*>(data), size }; }
+
+    private:
+        void* data = nullptr;
+        std::size_t size = 0;
+    };
+
+    // Splits on '|' into out; returns the number of fields found
+    std::size_t
+    split_fields(std::string_view line, std::span<std::string_view> out)
+    {
+        std::size_t n = 0;
+        while (n < out.size()) {
+            auto bar = line.find('|');
+            out[n++] = line.substr(0, bar);
+            if (std::string_view::npos == bar) break;
+            line.remove_prefix(bar + 1);
+        }
+        return n;
+    }
+
+    std::uint64_t
+    to_u64(std::string_view s)
+    {
+        std::uint64_t v = 0;
+        for (auto c : s) {
+            if (c < '0' || c > '9') break;
+            v = v * 10 + static_cast<std::uint64_t>(c - '0');
+        }
+        return v;
+    }
+
+    /* Runs parse(chunk) over roughly equal, line aligned chunks of text on
+     * threads workers and concatenates what they return. */
+    template<typename T, typename F>
+    std::vector<T>
+    parallel_parse(std::string_view text, unsigned threads, F parse)
+    {
+        std::vector<std::string_view> chunks;
+        auto target = text.size() / threads + 1;
+        while (!text.empty()) {
+            auto end = text.find('\n', std::min(target, text.size() - 1));
+            auto len = std::string_view::npos == end ? text.size() : end + 1;
+            chunks.push_back(text.substr(0, len));
+            text.remove_prefix(len);
+        }
+        std::vector<std::vector<T>> parts(chunks.size());
+        {
+            std::vector<std::jthread> workers;
+            for (auto i = 0UZ; i < chunks.size(); ++i) {
+                workers.emplace_back([&, i] { parts[i] = parse(chunks[i]); });
+            }
+        }
+        std::vector<T> all;
+        std::size_t total = 0;
+        for (const auto& p : parts) total += p.size();
+        all.reserve(total);
+        for (auto& p : parts) {
+            all.insert(all.end(), std::make_move_iterator(p.begin()), std::make_move_iterator(p.end()));
+        }
+        return all;
+    }
+
+    template<typename F>
+    void
+    for_each_line(std::string_view chunk, F f)
+    {
+        while (!chunk.empty()) {
+            auto nl = chunk.find('\n');
+            auto line = chunk.substr(0, nl);
+            if (!line.empty() && '\r' == line.back()) line.remove_suffix(1);
+            f(line);
+            if (std::string_view::npos == nl) break;
+            chunk.remove_prefix(nl + 1);
+        }
+    }
+
+    struct Entity
+    {
+        std::uint64_t usi;
+        std::string_view callsign;
+        std::array<std::string_view, 5> name;   // entity, first, mi, last, suffix
+        std::array<std::string_view, 4> address; // street, city, state, zip
+    };
+
+    void
+    join(std::string& out, std::initializer_list<std::string_view> parts, std::string_view sep)
+    {
+        bool first = true;
+        for (auto p : parts) {
+            if (p.empty()) continue;
+            if (!first) out += sep;
+            out += p;
+            first = false;
+        }
+    }
+
+} // anonymous namespace
+
+namespace mnn
+{
+    std::filesystem::path
+    default_uls_index_path()
+    {
+        std::filesystem::path base;
+        if (auto data = std::getenv("XDG_DATA_HOME"); data && *data) {
+            base = data;
+        } else if (auto home = std::getenv("HOME"); home && *home) {
+            base = std::filesystem::path(home) / ".local/share";
+        } else {
+            base = std::filesystem::temp_directory_path();
+        }
+        return base / "monday-night-net" / "uls.idx";
+    }
+
+    std::expected<std::size_t, std::error_code>
+    build_uls_index(const std::filesystem::path& dir, const std::filesystem::path& out, unsigned threads)
+    {
+        if (0 == threads) {
+            threads = std::max(1U, std::thread::hardware_concurrency());
+        }
+        auto en_file = MappedFile::open(dir / "EN.dat");
+        auto hd_file = MappedFile::open(dir / "HD.dat");
+        auto am_file = MappedFile::open(dir / "AM.dat");
+        if (!en_file) return std::unexpected(en_file.error());
+        if (!hd_file) return std::unexpected(hd_file.error());
+        if (!am_file) return std::unexpected(am_file.error());
+
+        std::vector<Entity> entities;
+        std::vector<std::uint64_t> active;
+        std::vector<std::pair<std::uint64_t, char>> classes;
+        {
+            // The three files are independent; parse them at once
+            std::jthread en([&] {
+                entities = parallel_parse<Entity>(en_file->text(), threads, [](std::string_view chunk) {
+                    std::vector<Entity> v;
+                    std::array<std::string_view, 20> f;
+                    for_each_line(chunk, [&](std::string_view line) {
+                        if (split_fields(line, f) < 19 || "EN" != f[0]) return;
+                        v.push_back({ to_u64(f[1]), f[4], { f[7], f[8], f[9], f[10], f[11] }, { f[15], f[16], f[17], f[18].substr(0, 5) } });
+                    });
+                    std::ranges::sort(v, {}, &Entity::usi);
+                    return v;
+                });
+                std::ranges::sort(entities, {}, &Entity::usi);
+            });
+            std::jthread hd([&] {
+                active = parallel_parse<std::uint64_t>(hd_file->text(), threads, [](std::string_view chunk) {
+                    std::vector<std::uint64_t> v;
+                    std::array<std::string_view, 8> f;
+                    for_each_line(chunk, [&](std::string_view line) {
+                        if (split_fields(line, f) >= 7 && "HD" == f[0] && "A" == f[5]) {
+                            v.push_back(to_u64(f[1]));
+                        }
+                    });
+                    return v;
+                });
+                std::ranges::sort(active);
+            });
+            classes = parallel_parse<std::pair<std::uint64_t, char>>(am_file->text(), threads, [](std::string_view chunk) {
+                std::vector<std::pair<std::uint64_t, char>> v;
+                std::array<std::string_view, 7> f;
+                for_each_line(chunk, [&](std::string_view line) {
+                    if (split_fields(line, f) >= 6 && "AM" == f[0]) {
+                        v.emplace_back(to_u64(f[1]), f[5].empty() ? ' ' : f[5].front());
+                    }
+                });
+                return v;
+            });
+            std::ranges::sort(classes);
+        }
+
+        std::vector<std::pair<UlsIndex::Record, std::uint64_t>> records;
+        records.reserve(active.size());
+        std::string pool;
+        pool.reserve(active.size() * 64);
+        for (const auto& e : entities) {
+            if (e.callsign.empty() || e.callsign.size() > sizeof(UlsIndex::Record::callsign) ||
+                !std::ranges::binary_search(active, e.usi)) {
+                continue;
+            }
+            UlsIndex::Record r{};
+            std::ranges::transform(e.callsign, r.callsign, [](char c) { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+            auto cls = std::ranges::lower_bound(classes, e.usi, {}, &std::pair<std::uint64_t, char>::first);
+            r.operator_class = classes.end() != cls && cls->first == e.usi ? cls->second : ' ';
+
+            auto& [entity, first, mi, last, suffix] = e.name;
+            r.name_offset = static_cast<std::uint32_t>(pool.size());
+            if (first.empty() && last.empty()) {
+                pool += entity;
+            } else {
+                join(pool, { first, mi, last, suffix }, " ");
+                r.first_name_length = static_cast<std::uint8_t>(std::min<std::size_t>(first.size(), 255));
+            }
+            r.name_length = static_cast<std::uint16_t>(std::min<std::size_t>(pool.size() - r.name_offset, 0xffff));
+
+            auto& [street, city, state, zip] = e.address;
+            r.address_offset = static_cast<std::uint32_t>(pool.size());
+            std::string state_zip;
+            join(state_zip, { state, zip }, " ");
+            join(pool, { street, city, state_zip }, ", ");
+            r.address_length = static_cast<std::uint16_t>(std::min<std::size_t>(pool.size() - r.address_offset, 0xffff));
+            records.emplace_back(r, e.usi);
+        }
+
+        // Reissued callsigns: keep the newest license
+        auto key = [](const auto& p) { return std::string_view(p.first.callsign, sizeof(p.first.callsign)); };
+        std::ranges::sort(records, [&key](const auto& a, const auto& b) {
+            return std::pair(key(a), a.second) < std::pair(key(b), b.second);
+        });
+        auto dupes = std::ranges::unique(records | std::views::reverse, {}, key);
+        records.erase(records.begin(), dupes.begin().base());
+
+        UlsIndex::Header header{};
+        std::ranges::copy(UlsIndex::magic, header.magic);
+        header.count = static_cast<std::uint32_t>(records.size());
+        header.record_size = sizeof(UlsIndex::Record);
+        header.pool_offset = sizeof(header) + records.size() * sizeof(UlsIndex::Record);
+        header.pool_size = pool.size();
+
+        auto tmp = out;
+        tmp += ".tmp";
+        {
+            std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const auto& [r, usi] : records) {
+                file.write(reinterpret_cast<const char*>(&r), sizeof(r));
+            }
+            file.write(pool.data(), static_cast<std::streamsize>(pool.size()));
+            if (!file) {
+                return std::unexpected(std::make_error_code(std::errc::io_error));
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, out, ec);
+        if (ec) return std::unexpected(ec);
+        return records.size();
+    }
+
+    std::expected<UlsIndex, std::error_code>
+    UlsIndex::open(const std::filesystem::path& path)
+    {
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return std::unexpected(last_error());
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            auto ec = last_error();
+            ::close(fd);
+            return std::unexpected(ec);
+        }
+        auto size = static_cast<std::size_t>(st.st_size);
+        if (size < sizeof(Header)) {
+            ::close(fd);
+            return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+        }
+        auto data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (MAP_FAILED == data) return std::unexpected(last_error());
+        // Lookups touch a handful of pages each; don't read ahead
+        ::madvise(data, size, MADV_RANDOM);
+
+        UlsIndex index;
+        index.mapping = data;
+        index.mapping_size = size;
+        const auto& h = *static_cast<const Header*>(data);
+        auto records_end = sizeof(Header) + std::uint64_t{h.count} * sizeof(Record);
+        if (0 != std::memcmp(h.magic, magic, sizeof(magic)) || sizeof(Record) != h.record_size ||
+            records_end > size || h.pool_offset != records_end || h.pool_offset + h.pool_size > size) {
+            return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+        }
+        auto bytes = static_cast<const char*>(data);
+        index.records = { reinterpret_cast<const Record*>(bytes + sizeof(Header)), h.count };
+        index.pool = { bytes + h.pool_offset, h.pool_size };
+        return index;
+    }
+
+    UlsIndex::UlsIndex(UlsIndex&& o) noexcept :
+        mapping(std::exchange(o.mapping, nullptr)),
+        mapping_size(std::exchange(o.mapping_size, 0)),
+        records(std::exchange(o.records, {})),
+        pool(std::exchange(o.pool, {}))
+    {
+    }
+
+    UlsIndex&
+    UlsIndex::operator=(UlsIndex&& o) noexcept
+    {
+        if (this != &o) {
+            if (mapping) ::munmap(mapping, mapping_size);
+            mapping = std::exchange(o.mapping, nullptr);
+            mapping_size = std::exchange(o.mapping_size, 0);
+            records = std::exchange(o.records, {});
+            pool = std::exchange(o.pool, {});
+        }
+        return *this;
+    }
+
+    UlsIndex::~UlsIndex()
+    {
+        if (mapping) ::munmap(mapping, mapping_size);
+    }
+
+    std::optional<UlsEntry>
+    UlsIndex::lookup(std::string_view callsign) const
+    {
+        char key[sizeof(Record::callsign)] = {};
+        if (callsign.empty() || callsign.size() > sizeof(key)) return std::nullopt;
+        std::ranges::transform(callsign, key, [](char c) { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+
+        auto it = std::ranges::lower_bound(records, std::string_view(key, sizeof(key)), {},
+                                           [](const Record& r) { return std::string_view(r.callsign, sizeof(r.callsign)); });
+        if (records.end() == it || 0 != std::memcmp(it->callsign, key, sizeof(key))) {
+            return std::nullopt;
+        }
+        auto view = [this](std::uint32_t offset, std::size_t length) {
+            return offset + length <= pool.size() ? pool.substr(offset, length) : std::string_view{};
+        };
+        auto name = view(it->name_offset, it->name_length);
+        return UlsEntry{ .callsign = std::string_view(it->callsign, strnlen(it->callsign, sizeof(it->callsign))),
+                         .name = name,
+                         .first_name = name.substr(0, it->first_name_length),
+                         .address = view(it->address_offset, it->address_length),
+                         .operator_class = it->operator_class };
+    }
+
+} // namespace mnn
@@ -0,0 +1,103 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+namespace mnn
+{
+    /* A licensee from the FCC ULS amateur database. Views point into the
+     * mapped index and live as long as the UlsIndex. */
+    struct UlsEntry
+    {
+        std::string_view callsign;
+        // "First M Last Suffix", or the club / entity name
+        std::string_view name;
+        // Empty for clubs and other entities
+        std::string_view first_name;
+        // "Street, City, ST 12345"
+        std::string_view address;
+        // E, A, G, T, N, P; ' ' for clubs (no operator class)
+        char operator_class;
+    };
+
+    // $XDG_DATA_HOME/monday-night-net/uls.idx
+    [[nodiscard]] std::filesystem::path default_uls_index_path();
+
+    /* Builds the index from an extracted l_amat.zip: EN.dat, HD.dat and
+     * AM.dat in dir. Each file is parsed in parallel chunks; only active
+     * licenses are kept. Returns the number of licensees written. */
+    [[nodiscard]] std::expected<std::size_t, std::error_code>
+    build_uls_index(const std::filesystem::path& dir, const std::filesystem::path& out, unsigned threads = 0);
+
+    /* The on-disk index, mapped read only. Lookups binary search a sorted
+     * array of fixed size records and return views into its string pool,
+     * so nothing of the dataset is copied to the heap. */
+    class UlsIndex
+    {
+    public:
+        [[nodiscard]] static std::expected<UlsIndex, std::error_code> open(const std::filesystem::path&);
+
+        UlsIndex(UlsIndex&&) noexcept;
+        UlsIndex& operator=(UlsIndex&&) noexcept;
+        ~UlsIndex();
+
+        [[nodiscard]] std::optional<UlsEntry> lookup(std::string_view callsign) const;
+        [[nodiscard]] std::size_t size() const { return records.size(); }
+
+        // On disk layout, little endian
+        struct Header
+        {
+            char magic[8];
+            std::uint32_t count;
+            std::uint32_t record_size;
+            std::uint64_t pool_offset;
+            std::uint64_t pool_size;
+        };
+        struct Record
+        {
+            char callsign[10];
+            char operator_class;
+            std::uint8_t first_name_length;
+            std::uint32_t name_offset;
+            std::uint32_t address_offset;
+            std::uint16_t name_length;
+            std::uint16_t address_length;
+        };
+        static_assert(sizeof(Record) == 24);
+        static constexpr char magic[8] = { 'M', 'N', 'N', 'U', 'L', 'S', '1', '\0' };
+
+    private:
+        UlsIndex() = default;
+
+        void* mapping = nullptr;
+        std::size_t mapping_size = 0;
+        std::span<const Record> records;
+        std::string_view pool;
+    };
+
+} // namespace mnn
@@ -0,0 +1,108 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include "undo_log.hpp"
+
+namespace mnn
+{
+    UndoLog::UndoLog(std::size_t capacity) :
+        ring(std::max<std::size_t>(capacity, 1))
+    {
+    }
+
+    void
+    UndoLog::begin_group() noexcept
+    {
+        if (0 == depth++) {
+            group_pending = true;
+            discarding = false;
+        }
+    }
+
+    void
+    UndoLog::end_group() noexcept
+    {
+        if (depth > 0 && 0 == --depth) {
+            group_pending = false;
+            discarding = false;
+        }
+    }
+
+    void
+    UndoLog::record(std::uint32_t row, StationDelta::Field field, std::uint8_t before, std::uint8_t after) noexcept
+    {
+        if (before == after || discarding) return;
+        count = cursor;
+        bool starts = 0 == depth || group_pending;
+        if (count == ring.size()) {
+            evict();
+            if (0 == count && !starts) {
+                // Only the open group was left, and it no longer fits
+                discarding = true;
+                cursor = 0;
+                return;
+            }
+        }
+        at(count) = StationDelta{ .row = row, .field = field, .before = before, .after = after, .group_start = starts };
+        cursor = ++count;
+        group_pending = false;
+    }
+
+    void
+    UndoLog::evict() noexcept
+    {
+        do {
+            head = (head + 1) % ring.size();
+            --count;
+        } while (count > 0 && !at(0).group_start);
+        cursor = count;
+    }
+
+    std::vector<StationDelta>
+    UndoLog::undo()
+    {
+        std::vector<StationDelta> step;
+        while (cursor > 0) {
+            const auto& d = at(--cursor);
+            step.push_back(d);
+            if (d.group_start) break;
+        }
+        return step;
+    }
+
+    std::vector<StationDelta>
+    UndoLog::redo()
+    {
+        std::vector<StationDelta> step;
+        while (cursor < count) {
+            step.push_back(at(cursor++));
+            if (cursor < count && at(cursor).group_start) break;
+        }
+        return step;
+    }
+
+    void
+    UndoLog::clear() noexcept
+    {
+        head = count = cursor = 0;
+        discarding = depth > 0;
+    }
+
+} // namespace mnn
@@ -0,0 +1,99 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mnn
+{
+    // One field of one station changing, small enough to keep hours of them
+    struct StationDelta
+    {
+        enum Field : std::uint8_t
+        {
+            STATUS,
+            ACKNOWLEDGED,
+        };
+
+        // Position in the net's station store
+        std::uint32_t row;
+        Field field;
+        // A StationStatus or a bool
+        std::uint8_t before;
+        std::uint8_t after;
+        // Set on the first delta of each undo step
+        bool group_start;
+    };
+    static_assert(8 == sizeof(StationDelta));
+
+    /* Undo and redo history of station changes in a fixed ring, so memory
+     * stays the same however long the net runs. Each record() outside a
+     * group is its own step; between begin_group() and end_group() (which
+     * nest) everything recorded is one step, such as a bulk reset.
+     *
+     * When the ring is full the oldest whole step is dropped. A single
+     * step larger than the ring can't be undone, so recording one empties
+     * the history instead. Recording drops anything that could be
+     * redone. */
+    class UndoLog
+    {
+    public:
+        // 512 KiB; several resets of a statewide roster
+        static constexpr std::size_t default_capacity = 65536;
+
+        explicit UndoLog(std::size_t capacity = default_capacity);
+
+        void begin_group() noexcept;
+        void end_group() noexcept;
+        // Nothing is recorded when before and after are equal
+        void record(std::uint32_t row, StationDelta::Field, std::uint8_t before, std::uint8_t after) noexcept;
+
+        /* The most recent step, newest delta first, to be put back to each
+         * before; empty when there is nothing to undo. */
+        [[nodiscard]] std::vector<StationDelta> undo();
+        // The next undone step, oldest first, to be put back to each after
+        [[nodiscard]] std::vector<StationDelta> redo();
+
+        [[nodiscard]] bool can_undo() const noexcept { return cursor > 0; }
+        [[nodiscard]] bool can_redo() const noexcept { return cursor < count; }
+        [[nodiscard]] std::size_t size() const noexcept { return count; }
+        [[nodiscard]] std::size_t capacity() const noexcept { return ring.size(); }
+        void clear() noexcept;
+
+    private:
+        [[nodiscard]] StationDelta& at(std::size_t i) noexcept { return ring[(head + i) % ring.size()]; }
+        void evict() noexcept;
+
+        std::vector<StationDelta> ring;
+        // Oldest delta
+        std::size_t head = 0;
+        std::size_t count = 0;
+        // Deltas before this are done, the rest undone
+        std::size_t cursor = 0;
+        unsigned depth = 0;
+        // The open group has nothing recorded yet
+        bool group_pending = false;
+        // The open group outgrew the ring; ignore the rest of it
+        bool discarding = false;
+    };
+
+} // namespace mnn
@@ -0,0 +1,206 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include "net_library.hpp"
+#include "update_dispatcher.hpp"
+
+namespace
+{
+    constexpr guint fallback_interval_ms = 16;
+
+} // anonymous namespace
+
+namespace mnn
+{
+    bool
+    StationUpdate::set_callsign(std::string_view s) noexcept
+    {
+        if (s.size() > callsign.size()) return false;
+        std::ranges::copy(s, callsign.begin());
+        length = static_cast<std::uint8_t>(s.size());
+        return true;
+    }
+
+    UpdateDispatcher::UpdateDispatcher(Net& net, std::size_t capacity) :
+        net(net),
+        queue(capacity),
+        depth(metrics().gauge("mnn_ingest_queue_depth", "Station updates waiting for the next frame")),
+        applied(metrics().counter("mnn_ingest_updates", "Station updates applied from worker threads")),
+        dropped(metrics().counter("mnn_ingest_dropped", "Station updates refused because the queue was full")),
+        frames(metrics().counter("mnn_ingest_frames", "Frames that applied queued station updates"))
+    {
+        frozen.reserve(256);
+    }
+
+    UpdateDispatcher::~UpdateDispatcher()
+    {
+        // Producers are stopped before the net lets go of us; only our own sources remain.
+        // The wake may already have run, and ids are not reused, so look it up
+        if (auto id = wake_id.load(); 0 != id) {
+            if (auto source = g_main_context_find_source_by_id(nullptr, id)) {
+                g_source_destroy(source);
+            }
+        }
+        release_widget();
+        if (0 != timer_id) {
+            g_source_remove(timer_id);
+        }
+    }
+
+    bool
+    UpdateDispatcher::post(const StationUpdate& update) noexcept
+    {
+        if (!queue.try_push(update)) {
+            dropped.add();
+            return false;
+        }
+        if (!scheduled.exchange(true, std::memory_order_acq_rel)) {
+            wake_id.store(g_idle_add_full(G_PRIORITY_DEFAULT, &UpdateDispatcher::on_wake, this, nullptr));
+        }
+        return true;
+    }
+
+    void
+    UpdateDispatcher::attach(GtkWidget* w)
+    {
+        if (w == widget) return;
+        detach(widget);
+        widget = w;
+        g_object_add_weak_pointer(G_OBJECT(widget), reinterpret_cast<gpointer*>(&widget));
+    }
+
+    void
+    UpdateDispatcher::detach(GtkWidget* w)
+    {
+        if (!w || w != widget) return;
+        if (release_widget()) {
+            // Whatever was pending still needs a drain
+            schedule();
+        }
+    }
+
+    void
+    UpdateDispatcher::set_min_interval(std::chrono::milliseconds interval)
+    {
+        // A running tick or timer finishes its batch at the old rate
+        min_interval = interval;
+    }
+
+    bool
+    UpdateDispatcher::release_widget()
+    {
+        if (!widget) return false;
+        bool ticking = 0 != tick_id;
+        if (ticking) {
+            gtk_widget_remove_tick_callback(widget, tick_id);
+            tick_id = 0;
+        }
+        g_object_remove_weak_pointer(G_OBJECT(widget), reinterpret_cast<gpointer*>(&widget));
+        widget = nullptr;
+        return ticking;
+    }
+
+    gboolean
+    UpdateDispatcher::on_wake(gpointer data)
+    {
+        static_cast<UpdateDispatcher*>(data)->schedule();
+        return G_SOURCE_REMOVE;
+    }
+
+    void
+    UpdateDispatcher::schedule()
+    {
+        if (0 != tick_id || 0 != timer_id) return;
+        if (min_interval.count() > 0) {
+            timer_id = g_timeout_add(static_cast<guint>(min_interval.count()), &UpdateDispatcher::on_timer, this);
+        } else if (widget && gtk_widget_get_mapped(widget)) {
+            tick_id = gtk_widget_add_tick_callback(widget, &UpdateDispatcher::on_tick, this, nullptr);
+        } else {
+            // Minimized or headless: the frame clock is paused, so don't wait on it
+            timer_id = g_timeout_add(fallback_interval_ms, &UpdateDispatcher::on_timer, this);
+        }
+    }
+
+    gboolean
+    UpdateDispatcher::on_tick(GtkWidget*, GdkFrameClock*, gpointer data)
+    {
+        auto self = static_cast<UpdateDispatcher*>(data);
+        if (self->drain()) return G_SOURCE_CONTINUE;
+        self->tick_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    gboolean
+    UpdateDispatcher::on_timer(gpointer data)
+    {
+        auto self = static_cast<UpdateDispatcher*>(data);
+        if (self->drain()) return G_SOURCE_CONTINUE;
+        self->timer_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    bool
+    UpdateDispatcher::drain()
+    {
+        // Cleared first: anything posted from here on wakes us again
+        scheduled.store(false, std::memory_order_release);
+
+        StationUpdate update;
+        std::size_t n = 0;
+        while (n < max_per_frame && queue.try_pop(update)) {
+            apply(update);
+            ++n;
+        }
+        for (auto station : frozen) {
+            station->thaw_notify();
+        }
+        frozen.clear();
+
+        applied.add(n);
+        if (n > 0) frames.add();
+        depth.set(static_cast<std::int64_t>(queue.size_approx()));
+        if (0 == queue.size_approx()) return false;
+        // More than a frame's worth; keep the producers from queueing redundant wakes
+        scheduled.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void
+    UpdateDispatcher::apply(const StationUpdate& u)
+    {
+        auto station = net.find(u.get_callsign());
+        if (!station) return;
+        if (frozen.insert(station).second) {
+            station->freeze_notify();
+        }
+        if ((u.fields & StationUpdate::STATUS) && station->get_status() != u.status) {
+            station->set_status(u.status);
+        }
+        if ((u.fields & StationUpdate::ACKNOWLEDGED) && station->is_acknowledged() != u.acknowledged) {
+            station->set_is_acknowledged(u.acknowledged);
+        }
+        if (u.fields & StationUpdate::LOCATION) {
+            station->set_location(u.latitude, u.longitude);
+        } else if (u.fields & StationUpdate::CLEAR_LOCATION) {
+            station->set_location(SHUMATE_MIN_LATITUDE, SHUMATE_MIN_LONGITUDE);
+        }
+    }
+
+} // namespace mnn
@@ -0,0 +1,127 @@
+/*
+    monday-night-net: An amateur radio net monitoring utility in gtk4
+    Copyright (C) 2025  Andrew Potter
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <unordered_set>
+#include <gtk/gtk.h>
+#include "metrics.hpp"
+#include "mpsc_queue.hpp"
+#include "station.hpp"
+
+namespace mnn
+{
+    struct Net;
+
+    // A change to one station, sized to cross threads without allocating
+    struct StationUpdate
+    {
+        enum Field : std::uint8_t
+        {
+            STATUS = 1 << 0,
+            ACKNOWLEDGED = 1 << 1,
+            LOCATION = 1 << 2,
+            CLEAR_LOCATION = 1 << 3,
+        };
+
+        std::array<char, 10> callsign{};
+        std::uint8_t length = 0;
+        std::uint8_t fields = 0;
+        StationStatus status = StationStatus::PENDING;
+        bool acknowledged = false;
+        double latitude = 0.0;
+        double longitude = 0.0;
+
+        // False when callsign is too long to be one
+        bool set_callsign(std::string_view) noexcept;
+        [[nodiscard]] std::string_view get_callsign() const noexcept { return { callsign.data(), length }; }
+    };
+
+    /* The one way off-thread sources (decoders, sockets, importers) change
+     * Stations. post() is lock free from any thread. Updates are applied on
+     * the main loop once per frame of the attached widget's frame clock, or
+     * every 16 ms when no window is mapped, with each touched station's
+     * notifications frozen for the whole batch so a station updated many
+     * times in a frame notifies once per property. With a minimum interval
+     * set (low power mode) batches run on a timer at that interval instead,
+     * so a steady trickle of updates costs a few wakeups a second rather
+     * than one per frame.
+     *
+     * A burst wakes the main loop once, not once per update. When the queue
+     * is full post() returns false and the producer decides whether to drop
+     * or retry. */
+    class UpdateDispatcher
+    {
+    public:
+        static constexpr std::size_t default_capacity = 16384;
+        // Per frame, so a flood can't stall drawing; the rest waits a frame
+        static constexpr std::size_t max_per_frame = 20000;
+
+        explicit UpdateDispatcher(Net& net, std::size_t capacity = default_capacity);
+        ~UpdateDispatcher();
+        UpdateDispatcher(const UpdateDispatcher&) = delete;
+        UpdateDispatcher& operator=(const UpdateDispatcher&) = delete;
+
+        // Any thread
+        bool post(const StationUpdate&) noexcept;
+
+        /* Main thread. Batches follow this widget's frame clock while it is
+         * mapped. One widget at a time; the last window attached wins. */
+        void attach(GtkWidget*);
+        void detach(GtkWidget*);
+        // Zero goes back to following the frame clock
+        void set_min_interval(std::chrono::milliseconds);
+
+    private:
+        static gboolean on_wake(gpointer self);
+        static gboolean on_tick(GtkWidget*, GdkFrameClock*, gpointer self);
+        static gboolean on_timer(gpointer self);
+
+        void schedule();
+        // Returns whether a tick callback was removed
+        bool release_widget();
+        // Returns whether updates remain
+        bool drain();
+        void apply(const StationUpdate&);
+
+        Net& net;
+        MpscQueue<StationUpdate> queue;
+        // Set from the first post() after a drain until the next drain starts
+        std::atomic<bool> scheduled = false;
+        // The most recent wake, for the destructor
+        std::atomic<guint> wake_id = 0;
+        GtkWidget* widget = nullptr;
+        guint tick_id = 0;
+        guint timer_id = 0;
+        std::chrono::milliseconds min_interval{ 0 };
+        // Stations frozen by the drain in progress
+        std::unordered_set<Station*> frozen;
+
+        Gauge& depth;
+        Counter& applied;
+        Counter& dropped;
+        Counter& frames;
+    };
+
+} // namespace mnn
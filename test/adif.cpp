@@ -0,0 +1,109 @@
+#include <boost/ut.hpp>
+#include <array>
+#include <string>
+#include <vector>
+#include "adif.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    constexpr auto log =
+        "Club net log <ADIF_VER:5>3.1.4 <PROGRAMID:6>Logger\n<EOH>\n"
+        "<CALL:6>KI6KVZ <NAME:6>Andrew <QSO_DATE:8>20240108 <GRIDSQUARE:6>CM87wj <EOR>\n"
+        "<call:4>w1aw<qso_date:8:d>20240108<name:4>ARRL<eor>\n"
+        "<CALL:6>KI6KVZ <NAME:4>Andy <QSO_DATE:8>20240115 <COMMENT:12>has a <  in it<EOR>\n"
+        "<CALL:6>KI6KVZ <NAME:7>Andrew2 <QSO_DATE:8>20230101 <EOR>\n"
+        "<CALL:10>not a call <QSO_DATE:8>20240115 <EOR>\n"
+        "<CALL:5>N6IHT <QSO_DATE:8>20240115 <EOR>\n"
+        "<CALL:5>KZ6DM <QSO_DA";
+
+    auto read = [](std::string_view text, std::size_t chunk) {
+        std::vector<std::vector<std::pair<std::string, std::string>>> records;
+        mnn::AdifReader reader([&records](std::span<const mnn::AdifField> fields) {
+            auto& r = records.emplace_back();
+            for (const auto& f : fields) r.emplace_back(f.name, f.value);
+        });
+        for (auto pos = 0UZ; pos < text.size(); pos += chunk) {
+            reader.feed(text.substr(pos, chunk));
+        }
+        reader.finish();
+        expect(eq(records.size(), reader.records()));
+        return records;
+    };
+
+    "reader"_test = [&] {
+        auto records = read(log, 1 << 20);
+        expect(fatal(eq(6UZ, records.size())));
+        expect(eq(4UZ, records[0].size())) << "header fields are not a record";
+        expect(eq("CALL"sv, records[0][0].first));
+        expect(eq("KI6KVZ"sv, records[0][0].second));
+        expect(eq("w1aw"sv, records[1][0].second));
+        expect(eq("20240108"sv, records[1][1].second)) << "the type indicator is not part of the length";
+        expect(eq("has a <  in "sv, records[2][3].second)) << "values are length prefixed, not delimited";
+    };
+
+    "dropped"_test = [] {
+        mnn::AdifReader whole([](std::span<const mnn::AdifField>) {});
+        whole.feed("<CALL:6>KI6KVZ <EOR>\r\n\n");
+        whole.finish();
+        expect(eq(1UZ, whole.records()));
+        expect(eq(0UZ, whole.dropped_bytes())) << "the line ending after <EOR> is not a partial record";
+
+        mnn::AdifReader cut([](std::span<const mnn::AdifField>) {});
+        cut.feed("<CALL:6>KI6KVZ <EOR>\n<CALL:5>N6IHT");
+        cut.finish();
+        expect(eq(1UZ, cut.records()));
+        expect(eq(14UZ, cut.dropped_bytes()));
+    };
+
+    "chunked"_test = [&] {
+        auto whole = read(log, 1 << 20);
+        for (auto chunk : { 1UZ, 3UZ, 7UZ, 16UZ, 17UZ, 64UZ }) {
+            expect(whole == read(log, chunk)) << "chunk size" << chunk;
+        }
+    };
+
+    "maidenhead"_test = [] {
+        auto cm87wj = mnn::maidenhead_center("CM87wj");
+        expect(fatal(cm87wj.has_value()));
+        expect(approx(37.39583, cm87wj->first, 1e-4));
+        expect(approx(-122.125, cm87wj->second, 1e-4));
+        auto fn31 = mnn::maidenhead_center("FN31");
+        expect(fatal(fn31.has_value()));
+        expect(approx(41.5, fn31->first, 1e-9));
+        expect(approx(-73.0, fn31->second, 1e-9));
+        expect(!mnn::maidenhead_center("ZZ99").has_value());
+        expect(!mnn::maidenhead_center("CM8").has_value());
+    };
+
+    "aggregate"_test = [&] {
+        mnn::AdifAggregator aggregator;
+        mnn::AdifReader reader([&aggregator](std::span<const mnn::AdifField> fields) { aggregator.add(fields); });
+        reader.feed(log);
+        reader.finish();
+        auto summary = std::move(aggregator).finish();
+        expect(eq(6UZ, summary.records));
+        expect(eq(1UZ, summary.skipped));
+        expect(fatal(eq(3UZ, summary.stations.size())));
+        const auto& kvz = summary.stations[0];
+        expect(eq("KI6KVZ"sv, kvz.callsign));
+        expect(eq("Andy"sv, kvz.name)) << "the newest QSO names the station";
+        expect(eq(3UZ, kvz.qsos));
+        expect(kvz.location.has_value()) << "an older grid is kept when newer QSOs have none";
+        expect(eq("W1AW"sv, summary.stations[2].callsign));
+
+        mnn::AdifAggregator repeats;
+        std::array<mnn::AdifField, 2> qso = { mnn::AdifField{ "CALL", "KI6KVZ" }, mnn::AdifField{ "QSO_DATE", "20240108" } };
+        for (auto i = 0; i < 100; ++i) repeats.add(qso);
+        auto repeated = std::move(repeats).finish();
+        expect(fatal(eq(1UZ, repeated.stations.size()))) << "a station worked all evening is held once";
+        expect(eq(100UZ, repeated.stations[0].qsos));
+
+        auto net = nlohmann::json::parse(R"({ "stations": [ { "callsign": "W1AW", "name": "Hiram" } ] })");
+        mnn::merge_adif(net, summary);
+        expect(eq(3UZ, net["stations"].size()));
+        expect(eq("Hiram"s, net["stations"][0]["name"].get<std::string>())) << "existing members are left alone";
+        expect(net["stations"][1].contains("lat"));
+    };
+}
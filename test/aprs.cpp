@@ -0,0 +1,85 @@
+#include <boost/ut.hpp>
+#include <string>
+#include <vector>
+#include "aprs.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    auto position = [](std::string_view line) {
+        auto packet = mnn::parse_tnc2(line);
+        return packet ? mnn::parse_position(*packet) : std::nullopt;
+    };
+
+    "tnc2"_test = [] {
+        auto p = mnn::parse_tnc2("KI6KVZ-9>APRS,WIDE1-1,qAR,N6IHT:!4903.50N/07201.75W-Test\r\n");
+        expect(fatal(p.has_value()));
+        expect(eq("KI6KVZ-9"sv, p->source));
+        expect(eq("KI6KVZ"sv, mnn::strip_ssid(p->source)));
+        expect(eq("APRS"sv, p->destination));
+        expect(eq("WIDE1-1,qAR,N6IHT"sv, p->path));
+        expect(eq("!4903.50N/07201.75W-Test"sv, p->info));
+        expect(!mnn::parse_tnc2("# aprsc 2.1.14"));
+        expect(!mnn::parse_tnc2("no header here"));
+    };
+
+    "uncompressed"_test = [&position] {
+        auto p = position("N0CALL>APRS:!4903.50N/07201.75W-Test");
+        expect(fatal(p.has_value()));
+        expect(approx(49.058333, p->latitude, 1e-6));
+        expect(approx(-72.029167, p->longitude, 1e-6));
+
+        auto timestamped = position("W1AW>APRS:@092345z3345.12S/15112.34E>");
+        expect(fatal(timestamped.has_value()));
+        expect(lt(timestamped->latitude, 0.0));
+        expect(gt(timestamped->longitude, 151.0));
+        expect(!position("N0CALL>APRS:;LEADER   *092345z4903.50N/07201.75W>")) << "objects aren't the sender";
+    };
+
+    "compressed"_test = [&position] {
+        auto p = position("N0CALL>APRS:=/5L!!<*e7>7P[");
+        expect(fatal(p.has_value()));
+        expect(approx(49.5, p->latitude, 1e-4));
+        expect(approx(-72.75, p->longitude, 1e-4));
+    };
+
+    "mic-e"_test = [&position] {
+        // 37 24.22N 122 03.98W
+        auto p = position("KI6KVZ-9>372TRR,WIDE1-1:`2[~l!!>/");
+        expect(fatal(p.has_value()));
+        expect(approx(37.403667, p->latitude, 1e-6));
+        expect(approx(-122.066333, p->longitude, 1e-6));
+    };
+
+    "kiss"_test = [&position] {
+        std::vector<std::uint8_t> ax25;
+        auto address = [&ax25](std::string_view call, int ssid, bool last) {
+            for (auto i = 0UZ; i < 6; ++i) {
+                ax25.push_back(static_cast<std::uint8_t>((i < call.size() ? call[i] : ' ') << 1));
+            }
+            ax25.push_back(static_cast<std::uint8_t>(0x60 | ssid << 1 | (last ? 1 : 0)));
+        };
+        address("APRS", 0, false);
+        address("KI6KVZ", 9, false);
+        address("WIDE1", 1, true);
+        ax25.push_back(0x03);
+        ax25.push_back(0xf0);
+        for (auto c : "!4903.50N/07201.75W-"sv) ax25.push_back(static_cast<std::uint8_t>(c));
+
+        std::vector<std::uint8_t> stream = { mnn::KissDecoder::FEND, 0x00 };
+        stream.insert(stream.end(), ax25.begin(), ax25.end());
+        stream.push_back(mnn::KissDecoder::FEND);
+        stream.push_back(0x00);  // start of a partial frame
+
+        mnn::KissDecoder decoder;
+        std::string line;
+        std::array<char, 512> out;
+        auto consumed = decoder.decode(stream, [&](std::span<const std::uint8_t> frame) {
+            if (auto l = mnn::kiss_to_tnc2(frame, out)) line = *l;
+        });
+        expect(eq(stream.size() - 1, consumed));
+        expect(eq("KI6KVZ-9>APRS,WIDE1-1:!4903.50N/07201.75W-"s, line));
+        expect(position(line).has_value());
+    };
+}
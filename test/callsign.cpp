@@ -0,0 +1,69 @@
+#include <boost/ut.hpp>
+#include <random>
+#include <string>
+#include <vector>
+#include "callsign.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "split"_test = [] {
+        auto check = [](std::string_view callsign, std::string_view prefix, std::string_view suffix) {
+            auto split = mnn::split_callsign(callsign);
+            expect(split.valid) << callsign;
+            expect(eq(prefix, callsign.substr(0, split.suffix_begin))) << callsign;
+            expect(eq(suffix, callsign.substr(split.suffix_begin))) << callsign;
+        };
+        check("KI6KVZ", "KI6", "KVZ");
+        check("3DA0RU", "3DA0", "RU");
+        check("9A1A", "9A1", "A");
+        check("KH6/W1AW", "KH6/W1", "AW");
+        check("W1AW/P", "W1", "AW/P");
+        check("W1AW/6", "W1", "AW/6");
+        check("VE3/W1AW/QRP", "VE3/W1", "AW/QRP");
+        expect(!mnn::is_valid_callsign("W1AW/KH6/P/QRP"));
+        expect(!mnn::is_valid_callsign("K1ABCDEFGHIJKLMNOP"));
+    };
+
+    "entity"_test = [] {
+        expect(eq("Fiji"sv, mnn::callsign_entity("3DN2AB")));
+        expect(eq("Eswatini"sv, mnn::callsign_entity("3DA0RU")));
+        expect(eq("Canada"sv, mnn::callsign_entity("VE3ABC")));
+        expect(eq("Canada"sv, mnn::callsign_entity("W1AW/VE3")));
+        expect(mnn::callsign_entity("not a callsign").empty());
+        expect(nullptr == mnn::lookup_itu("1A"));
+    };
+
+    "bulk matches scalar"_test = [] {
+        std::mt19937_64 rng(7);
+        constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789/abz#";
+        std::uniform_int_distribution<std::size_t> len_dist(0, 16);
+        std::uniform_int_distribution<std::size_t> char_dist(0, alphabet.size() - 1);
+
+        std::vector<std::string> callsigns = { "KI6KVZ", "3DA0RU", "KH6/W1AW", "9A1A", "GB100RSGB" };
+        for (auto i = 0; i < 100000; ++i) {
+            std::string s(len_dist(rng), ' ');
+            for (auto& c : s) c = alphabet[char_dist(rng)];
+            callsigns.push_back(std::move(s));
+        }
+
+        std::vector<mnn::PackedCallsign> packed;
+        packed.reserve(callsigns.size());
+        for (const auto& c : callsigns) packed.emplace_back(c);
+        std::vector<mnn::CallsignSplit> splits(packed.size());
+        mnn::split_callsigns(packed, splits);
+
+        auto valid = 0UZ;
+        for (auto i = 0UZ; i < callsigns.size(); ++i) {
+            auto expected = mnn::split_callsign(callsigns[i]);
+            expect(eq(expected.valid, splits[i].valid)) << callsigns[i];
+            if (expected.valid) {
+                ++valid;
+                expect(eq(expected.suffix_begin, splits[i].suffix_begin)) << callsigns[i];
+                expect(eq(mnn::callsign_entity(callsigns[i]), mnn::callsign_entity(callsigns[i], splits[i]))) << callsigns[i];
+            }
+        }
+        expect(ge(valid, 5UZ));
+    };
+}
@@ -0,0 +1,127 @@
+#include <boost/ut.hpp>
+#include <cmath>
+#include <map>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+#include "cw_decoder.hpp"
+
+namespace
+{
+    const std::map<char, std::string> codes = {
+        { 'A', ".-" }, { 'C', "-.-." }, { 'D', "-.." }, { 'E', "." }, { 'I', ".." }, { 'K', "-.-" },
+        { 'Q', "--.-" }, { 'R', ".-." }, { 'V', "...-" }, { 'W', ".--" }, { 'Z', "--.." }, { 'B', "-..." },
+        { '6', "-...." }, { '/', "-..-." },
+    };
+
+    // Keyed sine at wpm (PARIS timing) with white noise, silence either side
+    std::vector<float>
+    keyed(std::string_view text, float wpm, float tone_hz, float noise, std::size_t& end_of_signal)
+    {
+        constexpr float rate = 48000.0f;
+        auto dot = static_cast<std::size_t>(rate * 1.2f / wpm);
+        // 5 ms edges, as any sane keyer shapes them
+        auto ramp = static_cast<std::size_t>(rate * 0.005f);
+        std::vector<float> on_off(static_cast<std::size_t>(rate * 0.5f), 0.0f);
+        auto add = [&](bool on, std::size_t dots) { on_off.insert(on_off.end(), dots * dot, on ? 1.0f : 0.0f); };
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            if (' ' == text[i]) { add(false, 4); continue; }
+            const auto& code = codes.at(text[i]);
+            for (std::size_t e = 0; e < code.size(); ++e) {
+                add(true, '-' == code[e] ? 3 : 1);
+                add(false, e + 1 < code.size() ? 1 : 3);
+            }
+        }
+        end_of_signal = on_off.size();
+        on_off.insert(on_off.end(), static_cast<std::size_t>(rate * 1.5f), 0.0f);
+
+        std::mt19937 rng(7);
+        std::normal_distribution<float> gauss(0.0f, noise);
+        std::vector<float> samples(on_off.size());
+        float envelope = 0.0f;
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            envelope += (on_off[i] > envelope ? 1.0f : -1.0f) * std::min(1.0f / static_cast<float>(ramp), std::abs(on_off[i] - envelope));
+            samples[i] = 0.3f * envelope * std::sin(2.0f * std::numbers::pi_v<float> * tone_hz * static_cast<float>(i) / rate) + gauss(rng);
+        }
+        return samples;
+    }
+
+    struct Decoded
+    {
+        std::vector<std::string> words;
+        // Sample count fed when each word came out
+        std::vector<std::size_t> at;
+    };
+
+    Decoded
+    decode(const std::vector<float>& samples)
+    {
+        mnn::CwDecoder decoder;
+        Decoded out;
+        for (std::size_t pos = 0; pos < samples.size(); pos += 1024) {
+            auto n = std::min<std::size_t>(1024, samples.size() - pos);
+            decoder.feed(std::span(samples).subspan(pos, n), [&](std::string_view w) {
+                out.words.emplace_back(w);
+                out.at.push_back(pos + n);
+            });
+        }
+        decoder.flush([&](std::string_view w) { out.words.emplace_back(w); out.at.push_back(samples.size()); });
+        return out;
+    }
+
+} // anonymous namespace
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "clean id"_test = [] {
+        std::size_t end = 0;
+        auto d = decode(keyed("CQ DE KI6KVZ", 20.0f, 700.0f, 0.01f, end));
+        expect(fatal(eq(3UZ, d.words.size())));
+        expect(eq("CQ"s, d.words[0]));
+        expect(eq("DE"s, d.words[1]));
+        expect(eq("KI6KVZ"s, d.words[2]));
+        expect(lt(d.at[2], end + 48000)) << "within a second of the id ending";
+    };
+
+    "speeds and pitches"_test = [] {
+        for (auto [wpm, hz] : { std::pair{ 13.0f, 550.0f }, std::pair{ 25.0f, 820.0f }, std::pair{ 30.0f, 600.0f } }) {
+            std::size_t end = 0;
+            auto d = decode(keyed("DE W6ABC/R", wpm, hz, 0.02f, end));
+            expect(fatal(eq(2UZ, d.words.size()))) << wpm << "WPM at" << hz << "Hz";
+            expect(eq("W6ABC/R"s, d.words[1])) << wpm << "WPM";
+        }
+    };
+
+    "noisy"_test = [] {
+        std::size_t end = 0;
+        // Tone 0.3, noise sigma 0.15: roughly 20 dB SNR in the filter bandwidth
+        auto d = decode(keyed("DE KI6KVZ", 18.0f, 700.0f, 0.15f, end));
+        expect(fatal(ge(d.words.size(), 1UZ)));
+        expect(eq("KI6KVZ"s, d.words.back()));
+    };
+
+    "noise alone"_test = [] {
+        std::size_t end = 0;
+        auto d = decode(keyed("", 20.0f, 700.0f, 0.1f, end));
+        expect(d.words.empty());
+    };
+
+    "callsigns"_test = [] {
+        expect(eq("KI6KVZ"sv, mnn::cw_callsign("KI6KVZ").value_or("")));
+        expect(eq("W6ABC"sv, mnn::cw_callsign("W6ABC/R").value_or("")));
+        expect(!mnn::cw_callsign("DE").has_value());
+        expect(!mnn::cw_callsign("CQ").has_value());
+
+        std::vector<std::string> roster = { "K6ABC", "KI6KVZ", "W6ABC", "W6ABD" };
+        auto exact = mnn::match_roster_callsign("KI6KVZ", roster);
+        expect(exact.has_value() and exact->exact and eq("KI6KVZ"sv, exact->callsign));
+        // V (...-) misread as U (..-)
+        auto near = mnn::match_roster_callsign("KI6KUZ", roster);
+        expect(near.has_value() and !near->exact and eq("KI6KVZ"sv, near->callsign));
+        expect(!mnn::match_roster_callsign("W6ABE", roster).has_value()) << "ambiguous";
+        expect(!mnn::match_roster_callsign("N0CALL", roster).has_value());
+    };
+}
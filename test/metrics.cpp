@@ -0,0 +1,120 @@
+#include <boost/ut.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "metrics.hpp"
+#include "metrics_server.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "buckets"_test = [] {
+        using H = mnn::Histogram;
+        expect(eq(0UZ, H::bucket_index(0)));
+        expect(eq(63UZ, H::bucket_index(63)));
+        expect(eq(H::bucket_count - 1, H::bucket_index(~0ULL)));
+        auto previous = 0UZ;
+        for (std::uint64_t v = 1; v < (1ULL << 40); v = v * 3 / 2 + 1) {
+            auto i = H::bucket_index(v);
+            expect(ge(i, previous));
+            expect(ge(H::bucket_upper_bound(i), v));
+            // Within about 3% of the value
+            expect(le(H::bucket_upper_bound(i) - v, v / 32 + 1)) << v;
+            if (i > 0) expect(lt(H::bucket_upper_bound(i - 1), v));
+            previous = i;
+        }
+    };
+
+    "histogram"_test = [] {
+        mnn::Histogram h;
+        for (std::uint64_t i = 1; i <= 1000; ++i) {
+            h.record(i * 1000);
+        }
+        auto s = h.snapshot();
+        expect(eq(1000ULL, s.count));
+        expect(eq(1'000'000ULL, s.max));
+        expect(eq(500'500'000ULL, s.sum));
+        expect(approx(500'000.0, static_cast<double>(s.percentile(0.5)), 500'000.0 / 32));
+        expect(approx(990'000.0, static_cast<double>(s.percentile(0.99)), 990'000.0 / 32));
+        expect(eq(1'000'000ULL, s.percentile(1.0)));
+        expect(eq(0ULL, mnn::Histogram{}.snapshot().percentile(0.5)));
+    };
+
+    "concurrent"_test = [] {
+        mnn::MetricsRegistry registry;
+        auto& c = registry.counter("mnn_test_events", "Test events");
+        auto& h = registry.histogram("mnn_test_seconds", "Test durations");
+        {
+            std::vector<std::jthread> threads;
+            for (auto t = 0; t < 4; ++t) {
+                threads.emplace_back([&c, &h] {
+                    for (auto i = 0; i < 100'000; ++i) {
+                        c.add();
+                        h.record(static_cast<std::uint64_t>(i));
+                    }
+                });
+            }
+        }
+        expect(eq(400'000ULL, c.get()));
+        expect(eq(400'000ULL, h.snapshot().count));
+        expect(&c == &registry.counter("mnn_test_events", "Test events")) << "same name, same counter";
+    };
+
+    "exposition"_test = [] {
+        mnn::MetricsRegistry registry;
+        registry.counter("mnn_notify", "Property notifications", { { "property", "status" } }).add(3);
+        registry.counter("mnn_notify", "Property notifications", { { "property", "name" } }).add();
+        registry.gauge("mnn_stations_loaded", "Stations in the current roster").set(3000);
+        auto& load = registry.histogram("mnn_roster_load_seconds", "Roster load time");
+        load.record(20ms);
+        load.record(2s);
+
+        auto text = registry.render_openmetrics();
+        expect(text.contains("# TYPE mnn_notify counter\n"));
+        expect(text.contains("mnn_notify_total{property=\"status\"} 3\n"));
+        expect(text.contains("mnn_notify_total{property=\"name\"} 1\n"));
+        expect(text.contains("mnn_stations_loaded 3000\n"));
+        expect(text.contains("mnn_roster_load_seconds_bucket{le=\"0.025\"} 1\n"));
+        expect(text.contains("mnn_roster_load_seconds_bucket{le=\"2.5\"} 2\n"));
+        expect(text.contains("mnn_roster_load_seconds_bucket{le=\"+Inf\"} 2\n"));
+        expect(text.contains("mnn_roster_load_seconds_count 2\n"));
+        expect(text.ends_with("# EOF\n"));
+        auto families = 0UZ;
+        for (auto pos = text.find("# TYPE mnn_notify "); std::string::npos != pos; pos = text.find("# TYPE mnn_notify ", pos + 1)) ++families;
+        expect(eq(1UZ, families)) << "a family is described once";
+
+        auto summary = registry.render_summary();
+        expect(summary.contains("mnn_roster_load_seconds  n=2"));
+    };
+
+    "server"_test = [] {
+        mnn::MetricsRegistry registry;
+        registry.counter("mnn_scrapes", "Scrapes").add(7);
+        mnn::MetricsServer server(registry);
+        expect(fatal(!server.start(0)));
+
+        auto fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(server.port());
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        expect(fatal(0 == ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))));
+        std::string request = "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        ::send(fd, request.data(), request.size(), 0);
+        std::string response;
+        char buf[4096];
+        for (ssize_t n; (n = ::recv(fd, buf, sizeof(buf), 0)) > 0; ) {
+            response.append(buf, static_cast<std::size_t>(n));
+        }
+        ::close(fd);
+        expect(response.starts_with("HTTP/1.1 200 OK\r\n"));
+        expect(response.contains("application/openmetrics-text"));
+        expect(response.contains("mnn_scrapes_total 7\n"));
+        server.stop();
+    };
+}
@@ -0,0 +1,63 @@
+#include <boost/ut.hpp>
+#include <thread>
+#include <vector>
+#include "mpsc_queue.hpp"
+
+int main() {
+    using namespace boost::ut;
+
+    "bounded"_test = [] {
+        mnn::MpscQueue<int> q(5);
+        expect(eq(8UZ, q.capacity())) << "rounded up to a power of two";
+        for (auto i = 0; i < 8; ++i) {
+            expect(q.try_push(i));
+        }
+        expect(!q.try_push(8)) << "full rings push back";
+        expect(eq(8UZ, q.size_approx()));
+        int v = -1;
+        for (auto i = 0; i < 8; ++i) {
+            expect(q.try_pop(v));
+            expect(eq(i, v));
+        }
+        expect(!q.try_pop(v));
+        expect(q.try_push(9)) << "slots are reused after wrapping";
+        expect(q.try_pop(v) && 9 == v);
+    };
+
+    "producers"_test = [] {
+        constexpr auto producers = 4;
+        constexpr auto per_producer = 50'000;
+        mnn::MpscQueue<std::uint64_t> q(1024);
+        std::vector<std::uint64_t> next(producers, 0);
+        std::size_t received = 0;
+        bool ordered = true;
+        {
+            std::vector<std::jthread> threads;
+            for (auto p = 0; p < producers; ++p) {
+                threads.emplace_back([&q, p] {
+                    for (std::uint64_t i = 0; i < per_producer; ) {
+                        if (q.try_push(static_cast<std::uint64_t>(p) << 32 | i)) {
+                            ++i;
+                        } else {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+            std::uint64_t v;
+            while (received < producers * per_producer) {
+                if (!q.try_pop(v)) continue;
+                auto p = v >> 32;
+                // Each producer's items arrive in the order it pushed them
+                ordered = ordered && (v & 0xFFFFFFFF) == next[p];
+                next[p] = (v & 0xFFFFFFFF) + 1;
+                ++received;
+            }
+        }
+        expect(ordered);
+        expect(eq(static_cast<std::size_t>(producers * per_producer), received));
+        for (auto n : next) {
+            expect(eq(static_cast<std::uint64_t>(per_producer), n));
+        }
+    };
+}
@@ -0,0 +1,111 @@
+#include <boost/ut.hpp>
+#include <chrono>
+#include <format>
+#include <string>
+#include <vector>
+#include "adif.hpp"
+#include "net_export.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    mnn::SessionInfo session{ .net_id = "Monday Night Net",
+                              .date = "2025-06-02",
+                              .frequency = "146.535",
+                              .control_callsign = "KI6KVZ",
+                              .control_name = "Andrew" };
+    // 2025-06-02 19:30:05 UTC
+    constexpr std::int64_t t0 = 1748892605000;
+
+    auto sample = [] {
+        return std::vector<mnn::ExportRecord>{
+            { .callsign = "W1AW", .name = "Hiram, \"The Old Man\"", .status = mnn::StationStatus::HEARD_RELAY,
+              .acknowledged = true, .heard_unix_ms = t0 + 60000 },
+            { .callsign = "K6AB", .name = "Al" },
+            { .callsign = "N6IHT", .name = "Mike", .status = mnn::StationStatus::HEARD_DIRECT, .heard_unix_ms = t0,
+              .has_location = true, .latitude_udeg = 37403684, .longitude_udeg = -122064380 },
+        };
+    };
+
+    auto export_to_string = [&session](mnn::ExportFormat format, const std::vector<mnn::ExportRecord>& records) {
+        std::string out;
+        auto ok = mnn::write_export(format, session, records, [&out](std::span<const char> chunk) {
+            out.append(chunk.data(), chunk.size());
+            return true;
+        });
+        expect(ok);
+        return out;
+    };
+
+    "csv"_test = [&] {
+        auto out = export_to_string(mnn::ExportFormat::CSV, sample());
+        expect(eq("callsign,name,status,acknowledged,heard_utc,latitude,longitude\r\n"
+                  "W1AW,\"Hiram, \"\"The Old Man\"\"\",heard-relay,true,2025-06-02T19:31:05Z,,\r\n"
+                  "K6AB,Al,pending,false,,,\r\n"
+                  "N6IHT,Mike,heard-direct,false,2025-06-02T19:30:05Z,37.403684,-122.064380\r\n"s, out));
+    };
+
+    "adif"_test = [&] {
+        auto out = export_to_string(mnn::ExportFormat::ADIF, sample());
+        std::vector<std::string> calls;
+        std::vector<std::string> lats;
+        mnn::AdifReader reader([&calls, &lats](std::span<const mnn::AdifField> fields) {
+            for (const auto& f : fields) {
+                if (mnn::adif_name_equals(f.name, "call")) calls.emplace_back(f.value);
+                if (mnn::adif_name_equals(f.name, "lat")) lats.emplace_back(f.value);
+            }
+        });
+        reader.feed(out);
+        reader.finish();
+        expect(eq(2UZ, reader.records())) << "only heard stations are logged";
+        expect(fatal(eq(2UZ, calls.size())));
+        expect(eq("N6IHT"s, calls[0])) << "in check-in order";
+        expect(eq("W1AW"s, calls[1]));
+        expect(fatal(eq(1UZ, lats.size())));
+        expect(eq("N037 24.221"s, lats[0]));
+        expect(out.contains("<QSO_DATE:8>20250602 <TIME_ON:6>193005 "));
+        expect(out.contains("<LON:11>W122 03.863 "));
+    };
+
+    "ics309"_test = [&] {
+        auto out = export_to_string(mnn::ExportFormat::ICS309, sample());
+        expect(out.starts_with("COMMUNICATIONS LOG (ICS 309)\n"));
+        expect(out.contains("Radio Operator (Name, Call Sign): Andrew, KI6KVZ\n"));
+        auto first = out.find("19:30       N6IHT       KI6KVZ      Checked in direct (Mike)\n");
+        auto second = out.find("19:31       W1AW        KI6KVZ      Checked in via relay, acknowledged");
+        expect(std::string::npos != first);
+        expect(std::string::npos != second);
+        expect(first < second);
+        expect(!out.contains("K6AB"));
+    };
+
+    "streaming"_test = [&session] {
+        std::vector<mnn::ExportRecord> records(50000);
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            records[i] = { .callsign = std::format("KI6{:05}", i), .name = "Operator",
+                           .status = mnn::StationStatus::HEARD_DIRECT, .heard_unix_ms = t0 + static_cast<std::int64_t>(i) };
+        }
+        std::size_t chunks = 0, bytes = 0, progress_calls = 0, last_done = 0;
+        auto ok = mnn::write_export(mnn::ExportFormat::CSV, session, records,
+                                    [&chunks, &bytes](std::span<const char> chunk) {
+                                        ++chunks;
+                                        bytes += chunk.size();
+                                        return chunk.size() <= mnn::ExportWriter::default_buffer_size;
+                                    },
+                                    [&progress_calls, &last_done](std::size_t done, std::size_t total) {
+                                        ++progress_calls;
+                                        expect(ge(done, last_done));
+                                        last_done = done;
+                                        expect(le(done, total));
+                                    });
+        expect(ok) << "sink never sees more than one buffer";
+        expect(gt(chunks, 10UZ));
+        expect(gt(bytes, 50000UZ * 40));
+        expect(eq(50000UZ, last_done));
+        expect(gt(progress_calls, 10UZ));
+
+        auto failing = mnn::write_export(mnn::ExportFormat::CSV, session, records, [](std::span<const char>) { return false; });
+        expect(!failing) << "a sink failure is reported";
+    };
+}
@@ -0,0 +1,62 @@
+#include <boost/ut.hpp>
+#include <nlohmann/json.hpp>
+#include <unordered_set>
+#include "net_generator.hpp"
+#include "station.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+    using namespace peel;
+
+    Type::of<mnn::Station>().ensure();
+
+    "net"_test = [] {
+        mnn::GeneratorOptions opts;
+        opts.station_count = 3000;
+        opts.column_count = 5;
+        opts.itu_prefixes = true;
+        opts.seed = 42;
+        auto net = mnn::generate_net(opts);
+
+        expect(eq(1, net["meta"]["version"].get<int>()));
+        expect(eq(5UZ, net["columns"].size()));
+        expect(eq("A"sv, net["columns"].front()["begin"].get<std::string_view>()));
+        expect(eq("Z"sv, net["columns"].back()["end"].get<std::string_view>()));
+        expect(eq(opts.totals.size(), net["totals"].size()));
+        expect(eq(3000UZ, net["stations"].size()));
+
+        std::unordered_set<std::string> callsigns;
+        for (const auto& s : net["stations"]) {
+            auto station = mnn::Station::create(s);
+            expect(callsigns.insert(station->get_callsign()).second) << "duplicate callsign" << station->get_callsign();
+            const char* suffix = station->get_property(mnn::Station::prop_suffix());
+            expect(nullptr != suffix);
+        }
+
+        expect(eq(net, mnn::generate_net(opts))) << "generation is deterministic for a seed";
+    };
+
+    "checkins"_test = [] {
+        mnn::GeneratorOptions opts;
+        opts.station_count = 500;
+        auto net = mnn::generate_net(opts);
+
+        mnn::CheckinOptions checkin_opts;
+        checkin_opts.checkin_count = 3000;
+        checkin_opts.ack_ratio = 0.5;
+        auto events = mnn::generate_checkins(net, checkin_opts);
+        expect(ge(events.size(), 3000UZ));
+        expect(std::ranges::is_sorted(events, {}, &mnn::CheckinEvent::offset));
+        expect(le(events.back().offset, checkin_opts.duration + checkin_opts.max_ack_delay));
+
+        auto round_trip = mnn::checkins_from_json(mnn::checkins_to_json(events));
+        expect(eq(events.size(), round_trip.size()));
+        for (auto i = 0UZ; i < events.size(); ++i) {
+            expect(events[i].offset == round_trip[i].offset);
+            expect(eq(events[i].callsign, round_trip[i].callsign));
+            expect(events[i].status == round_trip[i].status);
+            expect(eq(events[i].acknowledged, round_trip[i].acknowledged));
+        }
+    };
+}
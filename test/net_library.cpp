@@ -0,0 +1,82 @@
+#include <boost/ut.hpp>
+#include <nlohmann/json.hpp>
+#include "net_library.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+    using namespace nlohmann::literals;
+    using namespace peel;
+
+    Type::of<mnn::Station>().ensure();
+
+    auto callsign_at = [](const mnn::Net& net, unsigned i) {
+        RefPtr<Object> item = net.stations->cast<Gio::ListModel>()->get_item(i);
+        return item->cast<mnn::Station>()->get_callsign();
+    };
+
+    "parse"_test = [] {
+        expect(!mnn::parse_net("x", R"({ "columns": [] })"_json));
+        expect(mnn::parse_net("x", R"({ "meta": { "version": 1 } })"_json).error() == std::make_error_code(mnn::error::missing_columns));
+        expect(mnn::parse_net("x", R"({ "meta": { "version": 1 }, "columns": [ { "begin": "A" } ] })"_json).error() == std::make_error_code(mnn::error::no_valid_columns));
+    };
+
+    "patch"_test = [&callsign_at] {
+        auto net = mnn::parse_net("test", R"({
+  "meta": { "version": 1 },
+  "columns": [ { "begin": "A", "end": "Z" } ],
+  "stations": [
+    { "callsign": "KI6KVZ", "name": "Andrew" },
+    { "callsign": "W1AW", "name": "ARRL" },
+    { "callsign": "N6IHT", "name": "Mike" },
+    { "callsign": "KZ6DM", "name": "Poul" }
+  ]
+})"_json);
+        expect(fatal(net.has_value()));
+        auto& n = **net;
+        n.find("KI6KVZ")->set_status(mnn::StationStatus::HEARD_DIRECT);
+        n.find("KZ6DM")->set_is_acknowledged(true);
+        RefPtr<mnn::Station> kept = n.find("KI6KVZ");
+
+        auto patch = mnn::patch_roster(n, R"([
+  { "callsign": "KI6KVZ", "name": "Andrew P" },
+  { "callsign": "W6ASH", "name": "New" },
+  { "callsign": "KZ6DM", "name": "Poul" },
+  { "callsign": "bad" }
+])"_json);
+        expect(eq(1UZ, patch.inserted));
+        expect(eq(2UZ, patch.removed));
+        expect(eq(1UZ, patch.updated));
+        expect(eq(1UZ, patch.diagnostics.size()));
+
+        expect(fatal(eq(3U, n.stations->cast<Gio::ListModel>()->get_n_items())));
+        expect(eq("KI6KVZ"s, callsign_at(n, 0)));
+        expect(eq("W6ASH"s, callsign_at(n, 1)));
+        expect(eq("KZ6DM"s, callsign_at(n, 2)));
+        expect(nullptr == n.find("W1AW"));
+        expect(nullptr != n.find("W6ASH"));
+
+        expect(static_cast<mnn::Station*>(kept) == n.find("KI6KVZ")) << "existing stations are patched, not replaced";
+        expect(eq("Andrew P"sv, kept->get_name()));
+        expect(mnn::StationStatus::HEARD_DIRECT == kept->get_status());
+        expect(eq(true, n.find("KZ6DM")->is_acknowledged()));
+
+        auto allocations = n.arena->stats().allocations;
+        auto again = mnn::patch_roster(n, R"([
+  { "callsign": "KI6KVZ", "name": "Andrew P" },
+  { "callsign": "W6ASH", "name": "New" },
+  { "callsign": "KZ6DM", "name": "Poul" }
+])"_json);
+        expect(eq(0UZ, again.inserted + again.removed + again.updated));
+        expect(eq(allocations, n.arena->stats().allocations)) << "an unchanged reload allocates nothing from the roster arena";
+    };
+
+    "library"_test = [] {
+        mnn::NetLibrary library(1);
+        auto a = library.open("default-net.json");
+        expect(fatal(a.has_value()));
+        auto b = library.open("default-net.json");
+        expect(*a == *b) << "a second window shares the parsed net";
+        expect(!library.open("/nonexistent/net.json"));
+    };
+}
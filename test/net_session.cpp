@@ -0,0 +1,125 @@
+#include <boost/ut.hpp>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+#include "daemon_client.hpp"
+#include "net_daemon.hpp"
+#include "net_session.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+    using namespace nlohmann::literals;
+
+    "session"_test = [] {
+        mnn::NetSession session(R"({ "stations": [
+  { "callsign": "KI6KVZ", "name": "Andrew", "lat": 37.4, "long": -122.06 },
+  { "callsign": "W1AW", "name": "ARRL" },
+  { "callsign": "bad", "name": "Bad" },
+  { "callsign": "W1AW", "name": "Duplicate" },
+  { "callsign": "N6IHT", "name": "Mike", "lat": 137.4, "long": -122.06 }
+] })"_json);
+        expect(eq(2UZ, session.stations().size()));
+        expect(eq(3UZ, session.skipped())) << "the same rules as import_stations()";
+        expect(eq("ARRL"sv, session.find("W1AW")->name)) << "the first of a repeated callsign wins";
+        expect(fatal(nullptr != session.find("KI6KVZ")));
+        expect(eq(true, session.find("KI6KVZ")->has_location));
+
+        expect(eq(false, session.check_in("N0PE", mnn::StationStatus::HEARD_DIRECT)));
+        expect(eq(true, session.acknowledge("W1AW", true)));
+        expect(mnn::StationStatus::HEARD_RELAY == session.find("W1AW")->status) << "same rule as Station";
+        expect(eq(true, session.check_in("KI6KVZ", mnn::StationStatus::HEARD_DIRECT)));
+        expect(eq(true, session.check_in("KI6KVZ", mnn::StationStatus::HEARD_DIRECT)));
+        auto changes = session.take_changes();
+        expect(eq(2UZ, changes.size())) << "each station reported once";
+        expect(session.take_changes().empty());
+    };
+
+    "daemon"_test = [] {
+        auto stations = nlohmann::json::array();
+        for (auto i = 0; i < 1000; ++i) {
+            stations.push_back({ { "callsign", std::format("K{}{:c}{:c}{:c}", i % 10, 'A' + i / 100, 'A' + (i / 10) % 10, 'A' + i % 10) },
+                                 { "name", "Test" } });
+        }
+        mnn::NetSession session(nlohmann::json{ { "stations", stations } });
+        expect(fatal(eq(1000UZ, session.stations().size())));
+
+        auto path = std::format("/tmp/mnn-test-{}.sock", ::getpid());
+        mnn::NetDaemon daemon(session, path);
+        expect(fatal(!daemon.listen()));
+        std::thread server([&daemon] { daemon.run(); });
+
+        mnn::DaemonClient subscriber, bot;
+        expect(fatal(!subscriber.connect(path)));
+        expect(fatal(!bot.connect(path)));
+        expect(!subscriber.subscribe());
+
+        std::vector<mnn::IpcUpdate> updates;
+        for (auto i = 0UZ; i < 100'000; ++i) {
+            updates.push_back({ .op = mnn::IpcOp::CHECK_IN,
+                                .callsign = session.stations()[i % 1000].callsign,
+                                .value = static_cast<std::uint8_t>(1 + i % 2) });
+        }
+        updates.push_back({ .op = mnn::IpcOp::CHECK_IN, .callsign = "N0PE", .value = 1 });
+        expect(!bot.send(updates));
+
+        mnn::IpcResult total;
+        auto deadline = std::chrono::steady_clock::now() + 10s;
+        while (total.applied + total.unknown < updates.size() && std::chrono::steady_clock::now() < deadline) {
+            auto frames = bot.receive();
+            expect(fatal(frames.has_value()));
+            for (const auto& f : *frames) {
+                total.applied += f.result.applied;
+                total.unknown += f.result.unknown;
+            }
+        }
+        expect(eq(100'000U, total.applied));
+        expect(eq(1U, total.unknown));
+
+        // Every station ends up heard; changes are coalesced per wakeup, so far fewer than 3 per update
+        auto events = 0UZ;
+        while (events < 3000 && std::chrono::steady_clock::now() < deadline) {
+            auto frames = subscriber.receive();
+            expect(fatal(frames.has_value()));
+            for (const auto& f : *frames) {
+                events += f.updates.size();
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        expect(ge(events, 3000UZ));
+
+        daemon.request_stop();
+        server.join();
+    };
+
+    "queue never blocks"_test = [] {
+        // A daemon that accepts nothing and reads nothing
+        auto path = std::format("/tmp/mnn-test-stalled-{}.sock", ::getpid());
+        ::unlink(path.c_str());
+        int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        expect(fatal(eq(0, ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)))));
+        expect(fatal(eq(0, ::listen(listener, 1))));
+
+        mnn::DaemonClient client;
+        expect(fatal(!client.connect(path)));
+        std::vector<mnn::IpcUpdate> updates(10'000, { .op = mnn::IpcOp::CHECK_IN, .callsign = "KI6KVZ", .value = 1 });
+        std::error_code ec;
+        for (auto i = 0; i < 1000 && !ec; ++i) {
+            ec = client.queue(updates);
+        }
+        expect(ec == std::make_error_code(std::errc::no_buffer_space)) << "gives up instead of waiting for the reader";
+        expect(client.wants_write());
+
+        client.close();
+        ::close(listener);
+        ::unlink(path.c_str());
+    };
+}
@@ -0,0 +1,125 @@
+#include <boost/ut.hpp>
+#include <format>
+#include <vector>
+#include "mnn_error.hpp"
+#include "net_snapshot.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    auto make_roster = [](std::size_t n) {
+        std::vector<mnn::StationState> roster;
+        for (std::size_t i = 0; i < n; ++i) {
+            roster.push_back({ .callsign = std::format("KI6{:03}", i) });
+        }
+        return roster;
+    };
+
+    "copy on write"_test = [&make_roster] {
+        auto roster = make_roster(1000);
+        mnn::SnapshotTable table;
+        table.reset(roster.size());
+        std::size_t reads = 0;
+        auto read = [&roster, &reads](std::size_t i) { ++reads; return roster[i]; };
+
+        auto first = table.capture(read);
+        expect(eq(roster.size(), reads));
+        expect(eq(4UZ, first.size()));
+
+        reads = 0;
+        roster[300].status = mnn::StationStatus::HEARD_DIRECT;
+        table.mark(300);
+        table.mark(301);
+        expect(eq(1UZ, table.dirty_chunks()));
+        auto second = table.capture(read);
+        expect(eq(mnn::SnapshotTable::chunk_size, reads)) << "only the changed chunk is rebuilt";
+        expect(first[0] == second[0] && first[2] == second[2] && first[3] == second[3]);
+        expect(first[1] != second[1]);
+        expect(mnn::StationStatus::PENDING == (*first[1])[300 - 256].status) << "older snapshots don't change";
+        expect(mnn::StationStatus::HEARD_DIRECT == (*second[1])[300 - 256].status);
+
+        reads = 0;
+        auto third = table.capture(read);
+        expect(eq(0UZ, reads));
+        expect(first[3] == third[3]);
+        // The last, short chunk
+        expect(eq(1000UZ - 3 * mnn::SnapshotTable::chunk_size, third[3]->size()));
+        table.mark(5000);
+        expect(eq(0UZ, table.dirty_chunks())) << "out of range marks are ignored";
+    };
+
+    "append"_test = [&make_roster] {
+        auto roster = make_roster(300);
+        mnn::SnapshotTable table;
+        table.reset(roster.size());
+        std::size_t reads = 0;
+        auto read = [&roster, &reads](std::size_t i) { ++reads; return roster[i]; };
+        auto first = table.capture(read);
+
+        reads = 0;
+        roster.push_back({ .callsign = "W1AW" });
+        table.append(1);
+        expect(eq(1UZ, table.dirty_chunks())) << "only the short last chunk grows";
+        auto second = table.capture(read);
+        expect(eq(300UZ - mnn::SnapshotTable::chunk_size + 1, reads));
+        expect(first[0] == second[0]);
+        expect(eq("W1AW"sv, second[1]->back().callsign));
+
+        reads = 0;
+        for (auto i = 0; i < 300; ++i) {
+            roster.push_back({ .callsign = std::format("N6{:03}", i) });
+        }
+        table.append(300);
+        auto third = table.capture(read);
+        expect(eq(3UZ, third.size()));
+        expect(eq(601UZ - mnn::SnapshotTable::chunk_size, reads));
+        expect(second[0] == third[0]);
+    };
+
+    "round trip"_test = [&make_roster] {
+        auto roster = make_roster(600);
+        roster[1].status = mnn::StationStatus::HEARD_RELAY;
+        roster[1].acknowledged = true;
+        roster[599].status = mnn::StationStatus::HEARD_DIRECT;
+        roster[599].has_location = true;
+        roster[599].latitude_udeg = 37403684;
+        roster[599].longitude_udeg = -122064380;
+        mnn::SnapshotTable table;
+        table.reset(roster.size());
+        mnn::NetSnapshot snapshot{ .session = { .net_id = "resource:///default-net.json",
+                                                .date = "2025-06-02",
+                                                .frequency = "146.535",
+                                                .control_callsign = "KI6KVZ",
+                                                .control_name = "Andrew" },
+                                   .taken_unix_ms = 1748916000000,
+                                   .chunks = table.capture([&roster](std::size_t i) { return roster[i]; }) };
+        auto bytes = mnn::serialize_snapshot(snapshot);
+        expect(lt(bytes.size(), 600UZ * 12)) << "a few bytes per station";
+
+        auto parsed = mnn::parse_snapshot(bytes);
+        expect(fatal(parsed.has_value()));
+        expect(parsed->session == snapshot.session);
+        expect(eq(snapshot.taken_unix_ms, parsed->taken_unix_ms));
+        expect(fatal(eq(600UZ, parsed->size())));
+        const auto& stations = *parsed->chunks.front();
+        expect(eq("KI6001"s, stations[1].callsign));
+        expect(mnn::StationStatus::HEARD_RELAY == stations[1].status);
+        expect(stations[1].acknowledged);
+        expect(!stations[2].acknowledged);
+        expect(eq("KI6599"s, stations[599].callsign));
+        expect(fatal(stations[599].has_location));
+        expect(eq(37403684, stations[599].latitude_udeg));
+        expect(eq(-122064380, stations[599].longitude_udeg));
+        expect(!stations[598].has_location);
+    };
+
+    "malformed"_test = [] {
+        std::vector<std::uint8_t> junk = { 0xff, 0x00, 0x13 };
+        expect(mnn::parse_snapshot(junk).error() == std::make_error_code(mnn::error::malformed_snapshot));
+        mnn::NetSnapshot empty;
+        auto bytes = mnn::serialize_snapshot(empty);
+        bytes.resize(bytes.size() / 2);
+        expect(!mnn::parse_snapshot(bytes).has_value()) << "truncated";
+    };
+}
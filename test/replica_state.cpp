@@ -0,0 +1,105 @@
+#include <boost/ut.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "replica_state.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "clock"_test = [] {
+        mnn::HybridClock a(1), b(2);
+        auto a1 = a.tick(1000);
+        auto a2 = a.tick(1000);
+        expect(a1 < a2) << "same millisecond still orders";
+        // b's wall clock is behind, but its next event must follow what it saw
+        b.observe(a2, 900);
+        expect(a2 < b.tick(900));
+    };
+
+    "lww"_test = [] {
+        mnn::ReplicaState a(1), b(2);
+        auto older = a.record("KI6KVZ", mnn::ReplicatedField::STATUS, 1, 1000);
+        auto newer = b.record("KI6KVZ", mnn::ReplicatedField::STATUS, 2, 2000);
+        expect(eq(true, a.merge(newer, 2000)));
+        expect(eq(false, b.merge(older, 2000)));
+        expect(eq(false, a.merge(newer, 2000))) << "merge is idempotent";
+        expect(eq(2, a.find("KI6KVZ", mnn::ReplicatedField::STATUS)->value));
+        expect(eq(2, b.find("KI6KVZ", mnn::ReplicatedField::STATUS)->value));
+        expect(nullptr == a.find("KI6KVZ", mnn::ReplicatedField::LOCATION));
+    };
+
+    "codec"_test = [] {
+        mnn::ReplicaState a(7);
+        for (auto i = 0; i < 400; ++i) {
+            auto callsign = "W" + std::to_string(i % 60) + "AW";
+            a.record(callsign, static_cast<mnn::ReplicatedField>(i % 3), i % 2, 1'700'000'000'000 + i, 37.4 + i * 1e-4, -122.1);
+        }
+        auto snapshot = a.snapshot();
+        std::vector<std::byte> out;
+        auto sent = 0UZ;
+        while (sent < snapshot.size()) {
+            auto span = std::span(snapshot).subspan(sent);
+            auto n = mnn::encode_batch(span, 42, a.node(), out);
+            expect(le(out.size(), 1200UZ));
+            auto batch = mnn::decode_batch(out);
+            expect(fatal(batch.has_value()));
+            expect(eq(42U, batch->net_tag));
+            expect(fatal(eq(n, batch->deltas.size())));
+            for (auto i = 0UZ; i < n; ++i) {
+                expect(eq(span[i].callsign, batch->deltas[i].callsign));
+                expect(span[i].field == batch->deltas[i].field);
+                expect(span[i].reg.stamp == batch->deltas[i].reg.stamp);
+                expect(eq(span[i].reg.value, batch->deltas[i].reg.value));
+                expect(eq(span[i].reg.latitude_udeg, batch->deltas[i].reg.latitude_udeg));
+            }
+            sent += n;
+        }
+        expect(!mnn::decode_batch(std::span(out).first(out.size() / 2)));
+        expect(!mnn::decode_batch(std::as_bytes(std::span("garbage"sv))));
+
+        expect(eq(0UZ, mnn::encode_batch({}, 42, a.node(), out)));
+        auto empty = mnn::decode_batch(out);
+        expect(fatal(empty.has_value()));
+        expect(empty->deltas.empty());
+    };
+
+    "convergence"_test = [] {
+        // 5 operators logging concurrently, datagrams delivered in any order
+        std::vector<mnn::ReplicaState> replicas;
+        for (auto i = 0U; i < 5; ++i) {
+            replicas.emplace_back(100 + i);
+        }
+        std::mt19937 rng(5);
+        std::vector<std::vector<std::byte>> datagrams;
+        std::uint64_t now = 1'700'000'000'000;
+        for (auto i = 0; i < 3000; ++i) {
+            now += rng() % 40;
+            auto& r = replicas[rng() % replicas.size()];
+            auto d = r.record("K" + std::to_string(rng() % 100), static_cast<mnn::ReplicatedField>(rng() % 3), rng() % 3, now, 37.0, -122.0);
+            auto& out = datagrams.emplace_back();
+            mnn::encode_batch(std::span(&d, 1), 1, r.node(), out);
+        }
+        std::ranges::shuffle(datagrams, rng);
+        for (const auto& datagram : datagrams) {
+            auto batch = mnn::decode_batch(datagram);
+            expect(fatal(batch.has_value()));
+            for (auto& r : replicas) {
+                for (const auto& d : batch->deltas) {
+                    r.merge(d, now);
+                }
+            }
+        }
+        auto reference = replicas.front().snapshot();
+        for (const auto& r : replicas) {
+            expect(eq(reference.size(), r.snapshot().size()));
+            for (const auto& d : reference) {
+                auto reg = r.find(d.callsign, d.field);
+                expect(fatal(nullptr != reg));
+                expect(reg->stamp == d.reg.stamp && reg->value == d.reg.value);
+            }
+        }
+    };
+}
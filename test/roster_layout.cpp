@@ -0,0 +1,110 @@
+#include <boost/ut.hpp>
+#include <array>
+#include <vector>
+#include "roster_layout.hpp"
+
+namespace
+{
+    using Kind = mnn::RosterSlot::Kind;
+
+    // Brute force model of the same grid, for comparison
+    std::vector<mnn::RosterSlot>
+    expand(const std::vector<std::size_t>& rows, std::size_t lanes)
+    {
+        std::vector<mnn::RosterSlot> slots;
+        for (std::size_t band = 0; band * lanes < rows.size(); ++band) {
+            std::size_t height = 0;
+            for (auto c = band * lanes; c < std::min(rows.size(), (band + 1) * lanes); ++c) {
+                height = std::max(height, rows[c]);
+            }
+            for (std::size_t r = 0; r <= height; ++r) {
+                for (std::size_t l = 0; l < lanes; ++l) {
+                    auto c = band * lanes + l;
+                    if (c >= rows.size()) slots.push_back({ Kind::BLANK, c, 0 });
+                    else if (0 == r) slots.push_back({ Kind::HEADER, c, 0 });
+                    else if (r - 1 < rows[c]) slots.push_back({ Kind::STATION, c, r - 1 });
+                    else slots.push_back({ Kind::BLANK, c, 0 });
+                }
+            }
+        }
+        return slots;
+    }
+
+    bool
+    matches(const mnn::RosterLayout& layout, const std::vector<std::size_t>& rows)
+    {
+        auto expected = expand(rows, layout.get_lanes());
+        if (expected.size() != layout.size()) return false;
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            auto s = layout.slot(i);
+            if (s.kind != expected[i].kind) return false;
+            if (Kind::BLANK != s.kind && (s.column != expected[i].column || s.row != expected[i].row)) return false;
+        }
+        return true;
+    }
+
+} // anonymous namespace
+
+int main() {
+    using namespace boost::ut;
+
+    "flow"_test = [] {
+        std::vector<std::size_t> rows = { 3, 1, 2 };
+        mnn::RosterLayout layout;
+        layout.reset(rows, 2);
+        expect(eq(14UZ, layout.size()));
+        expect(Kind::HEADER == layout.slot(1).kind && 1 == layout.slot(1).column);
+        expect(Kind::STATION == layout.slot(6).kind && 0 == layout.slot(6).column && 2 == layout.slot(6).row);
+        expect(Kind::HEADER == layout.slot(8).kind && 2 == layout.slot(8).column);
+        expect(Kind::BLANK == layout.slot(9).kind) << "the last band is short a column";
+        expect(matches(layout, rows));
+
+        for (std::size_t lanes = 1; lanes <= 4; ++lanes) {
+            layout.set_lanes(lanes);
+            expect(matches(layout, rows)) << lanes;
+        }
+        expect(eq(3UZ, layout.get_lanes())) << "never more lanes than columns";
+    };
+
+    "changes"_test = [] {
+        std::vector<std::size_t> rows = { 3, 1, 2, 0, 5 };
+        mnn::RosterLayout layout;
+        layout.reset(rows, 2);
+
+        // Same band height: only the rows the column covers are reported
+        auto c = layout.set_rows(1, 2, 1);
+        rows[1] = 2;
+        expect(eq(4UZ, c.position));
+        expect(eq(2UZ, c.removed));
+        expect(eq(2UZ, c.added));
+        expect(matches(layout, rows));
+
+        // Growing the band moves everything after it
+        auto before = layout.size();
+        c = layout.set_rows(0, 5, 3);
+        rows[0] = 5;
+        expect(eq(8UZ, c.position));
+        expect(eq(0UZ, c.removed));
+        expect(eq(4UZ, c.added));
+        expect(eq(before + 4, layout.size()));
+        expect(matches(layout, rows));
+
+        c = layout.set_rows(4, 0, 0);
+        rows[4] = 0;
+        expect(eq(c.position + c.removed, before + 4));
+        expect(eq(0UZ, c.added));
+        expect(matches(layout, rows));
+
+        layout.set_lanes(3);
+        expect(matches(layout, rows));
+        for (std::size_t i = 0; i < 200; ++i) {
+            auto col = (i * 7) % rows.size();
+            auto n = (i * 13) % 9;
+            auto old_size = layout.size();
+            c = layout.set_rows(col, n, std::min(n, rows[col]) / 2);
+            rows[col] = n;
+            expect(eq(old_size - c.removed + c.added, layout.size()));
+            expect(matches(layout, rows)) << i;
+        }
+    };
+}
@@ -0,0 +1,58 @@
+#include <boost/ut.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "roster_sort.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    auto key = [](mnn::RosterSort sort, const mnn::SortFields& f) {
+        std::string out;
+        mnn::roster_sort_key(sort, f, out);
+        return out;
+    };
+
+    "suffix"_test = [&key] {
+        mnn::SortFields w6ab{ .callsign = "W6AB", .suffix = "AB" };
+        mnn::SortFields k6abc{ .callsign = "K6ABC", .suffix = "ABC" };
+        mnn::SortFields k6ab{ .callsign = "K6AB", .suffix = "AB" };
+        auto s = mnn::RosterSort::SUFFIX;
+        expect(key(s, w6ab) < key(s, k6abc)) << "a shorter suffix sorts first";
+        expect(key(s, k6ab) < key(s, w6ab)) << "ties fall back to the callsign";
+        expect(key(mnn::RosterSort::CALLSIGN, k6abc) < key(mnn::RosterSort::CALLSIGN, w6ab));
+    };
+
+    "status"_test = [&key] {
+        auto s = mnn::RosterSort::STATUS;
+        mnn::SortFields pending{ .callsign = "AA1A", .status = mnn::StationStatus::PENDING };
+        mnn::SortFields relay{ .callsign = "ZZ9Z", .status = mnn::StationStatus::HEARD_RELAY };
+        mnn::SortFields direct{ .callsign = "ZZ9Z", .status = mnn::StationStatus::HEARD_DIRECT };
+        expect(key(s, direct) < key(s, relay));
+        expect(key(s, relay) < key(s, pending)) << "heard stations come first";
+    };
+
+    "distance"_test = [&key] {
+        auto s = mnn::RosterSort::DISTANCE;
+        std::vector<double> kms = { 0.0, 0.25, 1.0, 3.5, 12.0, 1000.0, 20000.0 };
+        std::vector<std::string> keys;
+        for (auto km : kms) {
+            keys.push_back(key(s, { .callsign = "K6AB", .distance_km = km }));
+        }
+        expect(std::ranges::is_sorted(keys));
+        expect(keys.back() < key(s, { .callsign = "AA1A" })) << "no location sorts last";
+
+        expect(approx(0.0, mnn::great_circle_km(37.4, -122.1, 37.4, -122.1), 1e-9));
+        // San Francisco to Los Angeles, about 559 km
+        expect(approx(559.0, mnn::great_circle_km(37.7749, -122.4194, 34.0522, -118.2437), 5.0));
+    };
+
+    "name"_test = [&key] {
+        auto s = mnn::RosterSort::NAME;
+        auto al = key(s, { .callsign = "W1AW", .name_key = "al" });
+        auto alan = key(s, { .callsign = "K1AA", .name_key = "alan" });
+        expect(al < alan) << "a name that prefixes another sorts first whatever the callsign";
+        expect(eq(std::string("al\0W1AW"sv), al));
+    };
+}
@@ -0,0 +1,44 @@
+#include <boost/ut.hpp>
+#include <string>
+#include <vector>
+#include "search_query.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "matches"_test = [] {
+        expect(mnn::search_matches("ki6kvz\nandrew", ""));
+        expect(mnn::search_matches("ki6kvz\nandrew", "kvz"));
+        expect(mnn::search_matches("ki6kvz\nandrew", "andr"));
+        expect(!mnn::search_matches("ki6kvz\nandrew", "kvza")) << "fields don't run together";
+    };
+
+    "change"_test = [] {
+        expect(mnn::SearchChange::SAME == mnn::compare_searches("kv", "kv"));
+        expect(mnn::SearchChange::MORE_STRICT == mnn::compare_searches("", "k"));
+        expect(mnn::SearchChange::MORE_STRICT == mnn::compare_searches("kv", "kvz"));
+        expect(mnn::SearchChange::MORE_STRICT == mnn::compare_searches("kv", "6kv")) << "typed at the front";
+        expect(mnn::SearchChange::LESS_STRICT == mnn::compare_searches("kvz", "kv"));
+        expect(mnn::SearchChange::LESS_STRICT == mnn::compare_searches("kvz", ""));
+        expect(mnn::SearchChange::DIFFERENT == mnn::compare_searches("kvz", "kvx"));
+    };
+
+    "strictness holds"_test = [] {
+        // Whatever compare_searches promises must hold for every haystack
+        std::vector<std::string> haystacks = { "ki6kvz\nandrew", "w1aw\narrl", "k6ab\nal", "n6iht\nmike", "" };
+        std::vector<std::string> needles = { "", "k", "6", "k6", "6k", "kv", "w1", "a", "al", "an", "\n" };
+        for (const auto& from : needles) {
+            for (const auto& to : needles) {
+                auto change = mnn::compare_searches(from, to);
+                for (const auto& h : haystacks) {
+                    auto before = mnn::search_matches(h, from);
+                    auto after = mnn::search_matches(h, to);
+                    if (mnn::SearchChange::MORE_STRICT == change) expect(!after || before);
+                    if (mnn::SearchChange::LESS_STRICT == change) expect(!before || after);
+                    if (mnn::SearchChange::SAME == change) expect(before == after);
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,38 @@
+#include <boost/ut.hpp>
+#include <vector>
+#include "sheet_layout.hpp"
+
+int main() {
+    using namespace boost::ut;
+
+    "example"_test = [] {
+        std::vector<std::size_t> rows = { 3, 1, 2 };
+        auto pages = mnn::paginate_sheet(rows, 2, 2);
+        expect(fatal(eq(3UZ, pages.size())));
+        expect(eq(0UZ, pages[0].first_column) and eq(2UZ, pages[0].column_count) and eq(0UZ, pages[0].first_row));
+        expect(eq(0UZ, pages[1].first_column) and eq(2UZ, pages[1].first_row));
+        expect(eq(2UZ, pages[2].first_column) and eq(1UZ, pages[2].column_count) and eq(0UZ, pages[2].first_row));
+    };
+
+    "empty columns"_test = [] {
+        std::vector<std::size_t> rows = { 0, 0, 0, 0, 0 };
+        auto pages = mnn::paginate_sheet(rows, 4, 40);
+        expect(eq(2UZ, pages.size())) << "one blank page per band";
+        expect(mnn::paginate_sheet({}, 4, 40).empty());
+        expect(eq(5UZ, mnn::paginate_sheet(rows, 0, 0).size())) << "zero geometry is clamped to one lane of one row";
+    };
+
+    "statewide"_test = [] {
+        // 7 columns of 20k stations, 4 lanes of 48 rows
+        std::vector<std::size_t> rows(7, 20000);
+        auto pages = mnn::paginate_sheet(rows, 4, 48);
+        expect(eq(2UZ * ((20000 + 47) / 48), pages.size()));
+        std::size_t covered = 0;
+        for (const auto& p : pages) {
+            for (auto c = p.first_column; c < p.first_column + p.column_count; ++c) {
+                if (p.first_row < rows[c]) covered += std::min<std::size_t>(48, rows[c] - p.first_row);
+            }
+        }
+        expect(eq(7UZ * 20000, covered)) << "every row printed exactly once";
+    };
+}
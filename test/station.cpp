@@ -1,5 +1,9 @@
 #include <boost/ut.hpp>
 #include <nlohmann/json.hpp>
+#include <format>
+#include <optional>
+#include <vector>
+#include "roster_import.hpp"
 #include "station.hpp"
 
 int main() {
@@ -132,6 +136,76 @@ int main() {
         expect(eq(37.403684, p->get_latitude()));
         expect(eq(-122.06438, p->get_longitude()));
 
+        expect(eq(std::int64_t{ 0 }, p->get_heard_time()));
+        p->set_status(mnn::StationStatus::HEARD_DIRECT);
+        auto heard = p->get_heard_time();
+        expect(gt(heard, std::int64_t{ 0 }));
+        p->set_status(mnn::StationStatus::PENDING);
+        expect(eq(heard, p->get_heard_time())) << "clearing a check-in keeps when it was heard";
+        p->restore_check_in(mnn::StationStatus::HEARD_RELAY, true);
+        expect(mnn::StationStatus::HEARD_RELAY == p->get_status());
+        expect(eq(true, p->is_acknowledged()));
+        expect(eq(heard, p->get_heard_time())) << "undo puts a check-in back without restamping it";
+    };
+
+    "search key"_test = [] {
+        expect(eq("jose"s, mnn::Station::fold_for_search("Jos\u00e9")));
+        expect(eq("strasse"s, mnn::Station::fold_for_search("STRA\u00dfE")));
+        auto p = mnn::Station::create(R"({ "callsign": "KI6KVZ", "name": "Andr\u00e9" })"_json);
+        expect(eq("ki6kvz\nandre"sv, p->get_search_key()));
+        p->set_name("Andrew");
+        expect(eq("ki6kvz\nandrew"sv, p->get_search_key())) << "a rename drops the cached key";
+    };
+
+    "import"_test = [] {
+        auto records = R"([
+  { "callsign": "KI6KVZ", "name": "Andrew" },
+  { "callsign": "W1AW" },
+  { "name": "No callsign" },
+  { "callsign": "not a call", "name": "Bad" },
+  { "callsign": "N6IHT", "name": "Mike", "lat": "north", "long": -122.0 },
+  { "callsign": "N6IHU", "name": 7 },
+  { "callsign": "KZ6DM", "name": "Poul", "assistant_emergency_coordinator": true },
+  { "callsign": "KI6KVZ", "name": "Again" }
+])"_json;
+        auto result = mnn::import_stations(records, std::make_shared<mnn::RosterArena>());
+        expect(eq(2UZ, result.stations.size()));
+        expect(eq("KZ6DM"sv, result.stations.back()->get_callsign()));
+        expect(eq(true, result.stations.back()->is_assistant_emergency_coordinator()));
+        expect(fatal(eq(6UZ, result.diagnostics.size())));
+        expect(eq(1UZ, result.diagnostics[0].index));
+        expect(result.diagnostics[0].code == std::make_error_code(mnn::error::missing_name));
+        expect(result.diagnostics[1].code == std::make_error_code(mnn::error::missing_callsign));
+        expect(result.diagnostics[2].code == std::make_error_code(mnn::error::invalid_callsign));
+        expect(eq("callsign"sv, std::string_view(result.diagnostics[2].field)));
+        expect(result.diagnostics[3].code == std::make_error_code(mnn::error::invalid_location));
+        expect(result.diagnostics[4].code == std::make_error_code(mnn::error::invalid_field_type));
+        expect(eq(5UZ, result.diagnostics[4].index));
+        expect(result.diagnostics[5].code == std::make_error_code(mnn::error::duplicate_callsign));
 
+        auto not_array = mnn::import_stations(R"({ "callsign": "KI6KVZ" })"_json, nullptr);
+        expect(not_array.stations.empty());
+        expect(eq(1UZ, not_array.diagnostics.size()));
+    };
+
+    "arena"_test = [] {
+        std::optional<mnn::ArenaStats> released;
+        mnn::RosterArena::set_release_hook([&released](const mnn::ArenaStats& stats) { released = stats; });
+        {
+            auto arena = std::make_shared<mnn::RosterArena>();
+            std::vector<RefPtr<mnn::Station>> roster;
+            for (auto i = 0; i < 1000; ++i) {
+                auto j = nlohmann::json{ { "callsign", std::format("KI6K{:03}", i) },
+                                         { "name", std::format("A name long enough to need the heap {}", i) } };
+                roster.push_back(mnn::Station::create(j, arena));
+            }
+            expect(eq("A name long enough to need the heap 999"sv, roster.back()->get_name()));
+            expect(ge(arena->stats().allocations, 1000UZ));
+            expect(lt(arena->stats().upstream_allocations, 16UZ)) << "roster strings should come from a few large blocks";
+            arena.reset();
+            expect(!released.has_value()) << "stations keep the arena alive";
+        }
+        expect(released.has_value());
+        mnn::RosterArena::set_release_hook(nullptr);
     };
 }
@@ -0,0 +1,135 @@
+#include <boost/ut.hpp>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+#include "status_board.hpp"
+
+namespace
+{
+    int
+    connect_to(std::uint16_t port)
+    {
+        auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    // Reads until want bytes have arrived or a second passes
+    std::string
+    read_some(int fd, std::size_t want)
+    {
+        std::string out;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (out.size() < want && std::chrono::steady_clock::now() < deadline) {
+            pollfd p{ fd, POLLIN, 0 };
+            if (::poll(&p, 1, 50) <= 0) continue;
+            char buf[4096];
+            auto n = ::recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) break;
+            out.append(buf, static_cast<std::size_t>(n));
+        }
+        return out;
+    }
+
+    // Unmasked server text frame payload starting at pos, advancing pos
+    std::string
+    take_frame(const std::string& in, std::size_t& pos)
+    {
+        if (in.size() < pos + 2) return {};
+        std::size_t length = static_cast<std::uint8_t>(in[pos + 1]) & 0x7F;
+        std::size_t header = 2;
+        if (126 == length) {
+            length = static_cast<std::size_t>(static_cast<std::uint8_t>(in[pos + 2])) << 8 | static_cast<std::uint8_t>(in[pos + 3]);
+            header = 4;
+        }
+        auto payload = in.substr(pos + header, length);
+        pos += header + length;
+        return payload;
+    }
+
+} // anonymous namespace
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    "accept key"_test = [] {
+        // The example handshake from RFC 6455
+        expect(eq("s3pPLMBiTxaQ9kYGzzhZRbK+xOo="s, mnn::websocket_accept_key("dGhlIHNhbXBsZSBub25jZQ==")));
+    };
+
+    "server"_test = [] {
+        mnn::StatusBoardServer server({ .port = 0, .min_interval = 300ms });
+        expect(fatal(!server.start()));
+        server.set_roster({ { "KI6KVZ", "Andrew" }, { "W1AW", "Hiram" } }, { "North", "South" });
+
+        auto http = connect_to(server.port());
+        expect(fatal(http >= 0));
+        std::string get = "GET /snapshot HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        ::send(http, get.data(), get.size(), 0);
+        auto response = read_some(http, 1 << 20);
+        ::close(http);
+        expect(response.starts_with("HTTP/1.1 200 OK\r\n"));
+        auto snapshot = nlohmann::json::parse(response.substr(response.find("\r\n\r\n") + 4), nullptr, false);
+        expect(fatal(!snapshot.is_discarded()));
+        expect(eq(2UZ, snapshot["stations"].size()));
+        expect(eq("Andrew"s, snapshot["stations"][0]["n"].get<std::string>()));
+        expect(eq(2UZ, snapshot["totals"].size()));
+
+        auto ws = connect_to(server.port());
+        expect(fatal(ws >= 0));
+        std::string upgrade = "GET /ws HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                              "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n";
+        ::send(ws, upgrade.data(), upgrade.size(), 0);
+        auto handshake = read_some(ws, 1);
+        expect(handshake.starts_with("HTTP/1.1 101"));
+        expect(handshake.contains("Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n"));
+        auto frames = handshake.substr(handshake.find("\r\n\r\n") + 4);
+        std::size_t pos = 0;
+        if (frames.empty()) frames = read_some(ws, 1);
+        auto first = nlohmann::json::parse(take_frame(frames, pos), nullptr, false);
+        expect(eq("snapshot"s, first.value("type", ""s)));
+
+        // The first edit starts a 300 ms batch, long enough that the rest always join it
+        server.update("KI6KVZ", mnn::StationStatus::HEARD_DIRECT, false);
+        server.update("KI6KVZ", mnn::StationStatus::HEARD_RELAY, false);
+        server.update("KI6KVZ", mnn::StationStatus::HEARD_RELAY, true);
+        server.update("N0CALL", mnn::StationStatus::HEARD_DIRECT, false);
+        frames = read_some(ws, 1);
+        pos = 0;
+        auto delta = nlohmann::json::parse(take_frame(frames, pos), nullptr, false);
+        expect(eq("delta"s, delta.value("type", ""s)));
+        expect(fatal(eq(1UZ, delta["stations"].size()))) << "unknown callsigns are not pushed";
+        expect(eq("KI6KVZ"s, delta["stations"][0]["c"].get<std::string>()));
+        expect(eq("HEARD_RELAY"s, delta["stations"][0]["s"].get<std::string>()));
+        expect(eq(true, delta["stations"][0]["a"].get<bool>()));
+        expect(eq(1UZ, server.viewer_count()));
+
+        // A new station goes out as a delta carrying its name, not a fresh snapshot
+        server.add({ "N0CALL", "Nobody", mnn::StationStatus::HEARD_DIRECT, false });
+        frames = read_some(ws, 1);
+        pos = 0;
+        auto added = nlohmann::json::parse(take_frame(frames, pos), nullptr, false);
+        expect(eq("delta"s, added.value("type", ""s)));
+        expect(fatal(eq(1UZ, added["stations"].size())));
+        expect(eq("N0CALL"s, added["stations"][0]["c"].get<std::string>()));
+        expect(eq("Nobody"s, added["stations"][0]["n"].get<std::string>()));
+
+        ::close(ws);
+        server.stop();
+    };
+}
@@ -0,0 +1,125 @@
+#include <boost/ut.hpp>
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "task.hpp"
+#include "thread_pool.hpp"
+
+namespace
+{
+    mnn::Task<int>
+    answer()
+    {
+        co_return 42;
+    }
+
+    mnn::Task<std::string>
+    nested()
+    {
+        auto a = co_await answer();
+        auto b = co_await answer();
+        co_return std::to_string(a + b);
+    }
+
+    mnn::Task<int>
+    throwing()
+    {
+        throw std::runtime_error("no");
+        co_return 0;
+    }
+
+    mnn::Task<std::thread::id>
+    on_pool(mnn::ThreadPool& pool)
+    {
+        co_await pool.schedule();
+        co_return std::this_thread::get_id();
+    }
+
+    mnn::Task<void>
+    count_on(mnn::ThreadPool& pool, std::atomic<int>& n, std::latch& done)
+    {
+        co_await pool.schedule();
+        ++n;
+        done.count_down();
+    }
+
+    mnn::Task<void>
+    slow_on(mnn::ThreadPool& pool, std::latch& done)
+    {
+        co_await pool.schedule();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        done.count_down();
+    }
+
+    // Everything it schedules lands on one worker's deque, so the rest have to steal
+    mnn::Task<void>
+    fan_out(mnn::ThreadPool& pool, int count, std::latch& done)
+    {
+        co_await pool.schedule();
+        for (auto i = 0; i < count; ++i) {
+            spawn(slow_on(pool, done));
+        }
+    }
+
+} // anonymous namespace
+
+int main() {
+    using namespace boost::ut;
+
+    "chain"_test = [] {
+        expect(eq(42, mnn::sync_wait(answer())));
+        expect(eq(std::string("84"), mnn::sync_wait(nested())));
+        bool ran = false;
+        auto lazy = [](bool& r) -> mnn::Task<void> { r = true; co_return; };
+        {
+            auto t = lazy(ran);
+            expect(!ran) << "tasks don't start until awaited";
+        }
+        expect(!ran) << "dropping an unstarted task never runs it";
+        mnn::sync_wait(lazy(ran));
+        expect(ran);
+    };
+
+    "exception"_test = [] {
+        expect(throws<std::runtime_error>([] { mnn::sync_wait(throwing()); }));
+        auto catches = []() -> mnn::Task<bool> {
+            try {
+                co_await throwing();
+            } catch (const std::runtime_error&) {
+                co_return true;
+            }
+            co_return false;
+        };
+        expect(mnn::sync_wait(catches()));
+    };
+
+    "pool"_test = [] {
+        mnn::ThreadPool pool(4);
+        expect(eq(4UZ, pool.size()));
+        expect(std::this_thread::get_id() != mnn::sync_wait(on_pool(pool)));
+
+        constexpr auto count = 20'000;
+        std::atomic<int> n = 0;
+        std::latch done(count);
+        for (auto i = 0; i < count; ++i) {
+            spawn(count_on(pool, n, done));
+        }
+        done.wait();
+        expect(eq(count, n.load()));
+    };
+
+    "steal"_test = [] {
+        mnn::ThreadPool pool(4);
+        constexpr auto count = 64;
+        std::latch done(count);
+        auto start = std::chrono::steady_clock::now();
+        spawn(fan_out(pool, count, done));
+        done.wait();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        expect(gt(pool.steals(), 0UZ));
+        expect(elapsed < std::chrono::milliseconds(count)) << "idle workers share the load";
+    };
+}
@@ -0,0 +1,77 @@
+#include <boost/ut.hpp>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+#include "uls.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using namespace std::literals;
+
+    auto dir = std::filesystem::temp_directory_path() / ("mnn-uls-test-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    auto write = [&dir](const char* name, std::string_view text) {
+        std::ofstream(dir / name, std::ios::binary) << text;
+    };
+    // Trimmed to the fields the importer reads; real rows carry more
+    write("EN.dat",
+          "EN|100|||KI6KVZ|L|L00100|POTTER, ANDREW J|Andrew|J|Potter|||||1 Main St|Mountain View|CA|94040|||000|\r\n"
+          "EN|200|||W1AW|L|L00200|ARRL HQ OPERATORS CLUB||||||||225 Main St|Newington|CT|061111400|||000|\r\n"
+          "EN|300|||N6XYZ|L|L00300|EXPIRED, PAT|Pat||Expired|||||9 Old Rd|Nowhere|NV|89001|||000|\r\n"
+          "EN|400|||KZ6DM|L|L00400|OLD, HOLDER|Old||Holder|||||1 First St|Sunnyvale|CA|94086|||000|\r\n"
+          "EN|500|||KZ6DM|L|L00500|NEW, HOLDER|New||Holder|Jr||||2 Second St|Sunnyvale|CA|94086|||000|");
+    write("HD.dat",
+          "HD|100|||KI6KVZ|A|HA|\n"
+          "HD|200|||W1AW|A|HB|\n"
+          "HD|300|||N6XYZ|E|HA|\n"
+          "HD|400|||KZ6DM|A|HA|\n"
+          "HD|500|||KZ6DM|A|HA|\n");
+    write("AM.dat",
+          "AM|100|||KI6KVZ|E|D|6||||||||||\n"
+          "AM|500|||KZ6DM|G|D|6||||||||||\n");
+
+    "build"_test = [&dir] {
+        auto count = mnn::build_uls_index(dir, dir / "uls.idx", 2);
+        expect(fatal(count.has_value()));
+        expect(eq(3UZ, *count)) << "expired licenses and reissued callsigns are dropped";
+        expect(!mnn::build_uls_index(dir / "missing", dir / "missing.idx").has_value());
+    };
+
+    "lookup"_test = [&dir] {
+        auto index = mnn::UlsIndex::open(dir / "uls.idx");
+        expect(fatal(index.has_value()));
+        expect(eq(3UZ, index->size()));
+
+        auto kvz = index->lookup("ki6kvz");
+        expect(fatal(kvz.has_value()));
+        expect(eq("KI6KVZ"sv, kvz->callsign));
+        expect(eq("Andrew J Potter"sv, kvz->name));
+        expect(eq("Andrew"sv, kvz->first_name));
+        expect(eq("1 Main St, Mountain View, CA 94040"sv, kvz->address));
+        expect(eq('E', kvz->operator_class));
+
+        auto club = index->lookup("W1AW");
+        expect(fatal(club.has_value()));
+        expect(eq("ARRL HQ OPERATORS CLUB"sv, club->name));
+        expect(club->first_name.empty());
+        expect(eq("225 Main St, Newington, CT 06111"sv, club->address));
+        expect(eq(' ', club->operator_class));
+
+        auto reissued = index->lookup("KZ6DM");
+        expect(fatal(reissued.has_value()));
+        expect(eq("New Holder Jr"sv, reissued->name));
+        expect(eq('G', reissued->operator_class));
+
+        expect(!index->lookup("N6XYZ").has_value());
+        expect(!index->lookup("").has_value());
+        expect(!index->lookup("WAYTOOLONGCALL").has_value());
+    };
+
+    "corrupt"_test = [&dir] {
+        std::ofstream(dir / "bad.idx", std::ios::binary) << "not an index at all, just some text";
+        expect(!mnn::UlsIndex::open(dir / "bad.idx").has_value());
+        expect(!mnn::UlsIndex::open(dir / "nonexistent.idx").has_value());
+    };
+
+    std::filesystem::remove_all(dir);
+}
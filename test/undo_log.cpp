@@ -0,0 +1,109 @@
+#include <boost/ut.hpp>
+#include "undo_log.hpp"
+
+int main() {
+    using namespace boost::ut;
+    using Field = mnn::StationDelta::Field;
+
+    "single steps"_test = [] {
+        mnn::UndoLog log(16);
+        expect(!log.can_undo() and !log.can_redo());
+        log.record(3, Field::STATUS, 0, 1);
+        log.record(3, Field::STATUS, 1, 1);
+        log.record(7, Field::ACKNOWLEDGED, 0, 1);
+        expect(eq(2UZ, log.size())) << "no-op changes aren't recorded";
+
+        auto step = log.undo();
+        expect(fatal(eq(1UZ, step.size())));
+        expect(eq(7U, step[0].row) and step[0].field == Field::ACKNOWLEDGED and eq(0, step[0].before));
+        expect(log.can_undo() and log.can_redo());
+        step = log.redo();
+        expect(fatal(eq(1UZ, step.size())));
+        expect(eq(1, step[0].after));
+        expect(!log.can_redo());
+
+        (void)log.undo();
+        log.record(9, Field::STATUS, 0, 2);
+        expect(!log.can_redo()) << "recording drops the redo branch";
+        expect(eq(2UZ, log.size()));
+    };
+
+    "groups"_test = [] {
+        mnn::UndoLog log(64);
+        log.record(0, Field::STATUS, 0, 1);
+        log.begin_group();
+        for (std::uint32_t row = 0; row < 10; ++row) {
+            log.begin_group();
+            log.record(row, Field::STATUS, 1, 0);
+            log.record(row, Field::ACKNOWLEDGED, 1, 0);
+            log.end_group();
+        }
+        log.end_group();
+
+        auto step = log.undo();
+        expect(fatal(eq(20UZ, step.size())));
+        expect(eq(9U, step.front().row)) << "newest first";
+        expect(eq(0U, step.back().row) and step.back().group_start);
+        step = log.undo();
+        expect(eq(1UZ, step.size()));
+        expect(!log.can_undo());
+
+        step = log.redo();
+        expect(eq(1UZ, step.size()));
+        step = log.redo();
+        expect(fatal(eq(20UZ, step.size())));
+        expect(eq(0U, step.front().row)) << "oldest first";
+        expect(!log.can_redo());
+    };
+
+    "bounded"_test = [] {
+        mnn::UndoLog log(8);
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            log.record(i, Field::STATUS, 0, 1);
+        }
+        expect(eq(8UZ, log.size()));
+        std::size_t steps = 0;
+        while (log.can_undo()) {
+            auto step = log.undo();
+            expect(eq(1UZ, step.size()));
+            expect(eq(999U - steps, step[0].row));
+            ++steps;
+        }
+        expect(eq(8UZ, steps));
+
+        // Eviction takes whole groups
+        mnn::UndoLog groups(8);
+        for (std::uint32_t g = 0; g < 5; ++g) {
+            groups.begin_group();
+            for (std::uint32_t i = 0; i < 3; ++i) groups.record(g * 3 + i, Field::STATUS, 0, 1);
+            groups.end_group();
+        }
+        expect(eq(6UZ, groups.size()));
+        expect(eq(3UZ, groups.undo().size()));
+        expect(eq(3UZ, groups.undo().size()));
+        expect(!groups.can_undo());
+    };
+
+    "oversized group"_test = [] {
+        mnn::UndoLog log(8);
+        log.record(100, Field::STATUS, 0, 1);
+        log.begin_group();
+        for (std::uint32_t i = 0; i < 20; ++i) log.record(i, Field::STATUS, 0, 1);
+        log.end_group();
+        expect(!log.can_undo()) << "a step the ring can't hold empties the history";
+        log.record(200, Field::STATUS, 0, 1);
+        expect(eq(1UZ, log.undo().size()));
+    };
+
+    "reset of a statewide roster"_test = [] {
+        mnn::UndoLog log;
+        log.begin_group();
+        for (std::uint32_t row = 0; row < 5000; ++row) {
+            log.record(row, Field::ACKNOWLEDGED, 1, 0);
+            log.record(row, Field::STATUS, 1, 0);
+        }
+        log.end_group();
+        expect(eq(10000UZ, log.undo().size()));
+        expect(eq(10000UZ, log.redo().size()));
+    };
+}